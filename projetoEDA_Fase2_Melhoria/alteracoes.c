@@ -0,0 +1,410 @@
+/*****************************************************************//**
+ * \file   alteracoes.c
+ * \brief  Aplicao de muitas alteraes (antenas e ligaes) ao grafo de uma s vez.
+ *
+ * Aplicar as alteraes uma a uma custa uma passagem pela lista de antenas por
+ * cada antena inserida por ordem e uma passagem pela lista de ligaes por cada
+ * ligao removida ou verificada. Aqui as alteraes so primeiro ordenadas:
+ *  - as de antenas por (linha, coluna), e so todas feitas numa s passagem
+ *    pela lista, que avana sempre no mesmo sentido;
+ *  - as de ligaes por (origem, destino), e cada lista de ligaes (e de
+ *    entradas) tocada  percorrida uma s vez, qualquer que seja o nmero de
+ *    alteraes que lhe dizem respeito.
+ * As alteraes de antenas so aplicadas antes das de ligaes, por isso uma
+ * ligao pode usar uma antena inserida no mesmo lote. Alteraes sobre a mesma
+ * antena ou a mesma ligao so aplicadas pela ordem em que aparecem no vetor.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "antenas.h"
+
+#pragma region Ordenacao
+/**
+ * Chave de ordenao de uma alterao de antena.
+ * @param linha --> Linha da antena.
+ * @param coluna --> Coluna da antena.
+ * @param indice --> Posio da alterao no vetor recebido.
+ */
+typedef struct ChaveAntena {
+    int linha;
+    int coluna;
+    int indice;
+} ChaveAntena;
+
+/**
+ * Chave de ordenao de uma alterao de ligao (com as antenas j encontradas).
+ * @param origem --> Id da antena de origem.
+ * @param destino --> Id da antena de destino.
+ * @param indice --> Posio da alterao no vetor recebido.
+ */
+typedef struct ChaveLigacao {
+    int origem;
+    int destino;
+    int indice;
+} ChaveLigacao;
+
+static int CompararChavesAntena(const void* a, const void* b) {
+    const ChaveAntena* ca = a;
+    const ChaveAntena* cb = b;
+    if (ca->linha != cb->linha) return (ca->linha > cb->linha) - (ca->linha < cb->linha);
+    if (ca->coluna != cb->coluna) return (ca->coluna > cb->coluna) - (ca->coluna < cb->coluna);
+    return ca->indice - cb->indice;
+}
+
+static int CompararChavesLigacao(const void* a, const void* b) {
+    const ChaveLigacao* ca = a;
+    const ChaveLigacao* cb = b;
+    if (ca->origem != cb->origem) return ca->origem - cb->origem;
+    if (ca->destino != cb->destino) return ca->destino - cb->destino;
+    return ca->indice - cb->indice;
+}
+
+/**
+ * Verdadeiro se a antena fica antes da posio (linha, coluna) na ordem de adicionarAntenaOrdenado.
+ */
+static bool AntesDe(const Antena* antena, int linha, int coluna) {
+    return antena->linha < linha || (antena->linha == linha && antena->coluna < coluna);
+}
+#pragma endregion
+
+#pragma region AplicarAntenas
+/**
+ * Insere uma antena na lista logo a seguir a anterior (no incio se anterior for NULL),
+ * depois de a registar no ndice e no balde, como adicionarAntenaOrdenado.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param anterior --> Antena depois da qual a nova fica.
+ * @param alteracao --> Alterao INSERIR_ANTENA a aplicar.
+ * @param nova --> Apontador para a antena criada.
+ * @param posterior --> Antena que passa a vir depois da nova.
+ * @param return --> 0 se foi inserida, -3 se falhar a alocao.
+ */
+static int InserirDepois(Grafo* grafo, Antena* anterior, const Alteracao* alteracao) {
+    Antena* nova = popularAntena(grafo, alteracao->frequencia, alteracao->coluna, alteracao->linha);
+    if (!nova) return -3;
+    if (RegistarAntena(grafo, nova) != 0) return -3;
+
+    Antena* posterior = anterior ? anterior->proxima : grafo->antenas;
+    nova->proxima = posterior;
+    nova->anterior = anterior;
+    if (posterior) posterior->anterior = nova;
+    if (anterior) anterior->proxima = nova;
+    else grafo->antenas = nova;
+    grafo->totalAntenas++;
+    return 0;
+}
+
+/**
+ * Aplica as alteraes de antenas, j ordenadas por posio, numa s passagem pela lista.
+ * O cursor  a ltima antena da lista que fica antes da posio atual; como as posies
+ * vm por ordem crescente s avana, e nunca  removido (as remoes so sempre na
+ * posio atual, que fica depois dele). Tal como em adicionarAntenaOrdenado, cada antena
+ * nova fica antes da primeira antena da lista que no seja anterior a ela.
+ * A lista no precisa de estar ordenada: todas as antenas at ao cursor foram passadas
+ * por ficarem antes de uma posio anterior  atual, logo tambm ficam antes da atual, e
+ * adicionarAntenaOrdenado, a partir do incio, pararia na mesma antena que o cursor.
+ * As antenas removidas saem logo da lista, do ndice e das ligaes, mas s so retiradas
+ * dos baldes no fim, com cada balde tocado compactado uma vez, e s ento voltam  arena.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param alteracoes --> Vetor de alteraes recebido.
+ * @param chaves --> Alteraes de antenas ordenadas por (linha, coluna, ndice).
+ * @param total --> Nmero de chaves.
+ * @param estados --> Cdigo de cada alterao (mesmos cdigos que as funes de uma antena).
+ * @param removidas --> Vetor com total posies para as antenas removidas.
+ * @param totalRemovidas --> Nmero de antenas em removidas.
+ * @param alvo --> Antena a remover, obtida do ndice.
+ * @param cursor --> ltima antena antes da posio atual (NULL se for o incio da lista).
+ * @param seguinte --> Antena a seguir ao cursor.
+ * @param return --> Nmero de alteraes que falharam.
+ */
+static int AplicarAntenas(Grafo* grafo, const Alteracao* alteracoes, const ChaveAntena* chaves, int total, int* estados, Antena** removidas) {
+    Antena* cursor = NULL;
+    int totalRemovidas = 0;
+    int falhas = 0;
+
+    for (int k = 0; k < total; k++) {
+        const Alteracao* alteracao = &alteracoes[chaves[k].indice];
+
+        if (alteracao->tipo == INSERIR_ANTENA) {
+            Antena* seguinte = cursor ? cursor->proxima : grafo->antenas;
+            while (seguinte && AntesDe(seguinte, alteracao->linha, alteracao->coluna)) {
+                cursor = seguinte;
+                seguinte = seguinte->proxima;
+            }
+            if (procurarAntena(grafo, alteracao->coluna, alteracao->linha)) {
+                estados[chaves[k].indice] = -2; // Antena j existe na posio
+            }
+            else {
+                estados[chaves[k].indice] = InserirDepois(grafo, cursor, alteracao);
+            }
+        }
+        else {
+            Antena* alvo = procurarAntena(grafo, alteracao->coluna, alteracao->linha);
+            if (!alvo) {
+                estados[chaves[k].indice] = -2; // Antena no encontrada
+            }
+            else {
+                estados[chaves[k].indice] = desligarAntena(grafo, alvo);
+                removidas[totalRemovidas++] = alvo;
+            }
+        }
+        if (estados[chaves[k].indice] != 0) falhas++;
+    }
+
+    RemoverDosBaldes(grafo, removidas, totalRemovidas);
+    for (int r = 0; r < totalRemovidas; r++) LibertarNo(grafo->arena, NO_ANTENA, removidas[r]);
+    return falhas;
+}
+#pragma endregion
+
+#pragma region AplicarLigacoes
+/**
+ * Contagens por id de antena usadas ao percorrer uma lista de ligaes.
+ * S contam as posies com marca igual  poca atual, por isso no  preciso limp-las.
+ * @param marca --> poca em que a contagem de cada id foi iniciada.
+ * @param contagem --> Contagem de cada id.
+ * @param epoca --> poca atual.
+ */
+typedef struct ContagensId {
+    unsigned int* marca;
+    int* contagem;
+    unsigned int epoca;
+} ContagensId;
+
+static int* Contagem(ContagensId* contagens, int id) {
+    if (contagens->marca[id] != contagens->epoca) {
+        contagens->marca[id] = contagens->epoca;
+        contagens->contagem[id] = 0;
+    }
+    return &contagens->contagem[id];
+}
+
+/**
+ * Retira de uma lista de ligaes, numa s passagem, os ns cujo destino tem contagem
+ * positiva na poca atual (um n por unidade de contagem) e devolve-os  arena.
+ *
+ * @param grafo --> Apontador para o grafo dono da arena.
+ * @param lista --> Apontador para o incio da lista.
+ * @param contagens --> Nmero de ns a retirar por id de destino.
+ * @param origem --> Antena dona da lista se for uma lista de ligaes (para atualizar as componentes),
+ *                   NULL se for uma lista de entradas.
+ * @param atual --> Apontador para o campo que aponta para o n atual.
+ */
+static void RetirarMarcadas(Grafo* grafo, Adjacencia** lista, ContagensId* contagens, Antena* origem) {
+    Adjacencia** atual = lista;
+    while (*atual) {
+        Adjacencia* no = *atual;
+        int* pedidos = Contagem(contagens, no->destino->id);
+        if (*pedidos > 0) {
+            (*pedidos)--;
+            *atual = no->proxima;
+            if (origem) AtualizarComponentesLigacao(grafo, origem, no->destino, -1);
+            LibertarNo(grafo->arena, NO_ADJACENCIA, no);
+        }
+        else {
+            atual = &no->proxima;
+        }
+    }
+}
+
+/**
+ * Aplica as alteraes de ligaes de uma antena de origem (chaves[inicio..fim-1]).
+ * A lista de ligaes da origem  percorrida uma vez para contar as ligaes j existentes
+ * para cada destino pedido e, se houver remoes, outra vez para as retirar todas.
+ * As ligaes novas so inseridas logo, no incio da lista, como em adicionarAresta.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param alteracoes --> Vetor de alteraes recebido.
+ * @param chaves --> Alteraes de ligaes ordenadas por (origem, destino, ndice).
+ * @param inicio --> Primeira chave da origem.
+ * @param fim --> Posio a seguir  ltima chave da origem.
+ * @param contagens --> Contagens por id de destino.
+ * @param retiradas --> Ligaes retiradas (destino, origem), para depois limpar as entradas.
+ * @param totalRetiradas --> Nmero de ligaes em retiradas (atualizado).
+ * @param estados --> Cdigo de cada alterao.
+ * @param existentes --> Nmero de ligaes da origem para o destino atual.
+ * @param return --> Nmero de alteraes que falharam.
+ */
+static int AplicarLigacoesOrigem(Grafo* grafo, const Alteracao* alteracoes, const ChaveLigacao* chaves, int inicio, int fim,
+    ContagensId* contagens, ChaveLigacao* retiradas, int* totalRetiradas, int* estados) {
+    Antena* origem = grafo->porId[chaves[inicio].origem];
+    int falhas = 0;
+
+    //Conta as ligaes que j existem para os destinos pedidos
+    contagens->epoca++;
+    for (int k = inicio; k < fim; k++) Contagem(contagens, chaves[k].destino);
+    for (Adjacencia* adj = origem->ligacoes; adj != NULL; adj = adj->proxima) {
+        if (contagens->marca[adj->destino->id] == contagens->epoca) contagens->contagem[adj->destino->id]++;
+    }
+
+    //Cada destino pela ordem do vetor; a contagem passa a ser o nmero de ligaes a retirar
+    bool haRemocoes = false;
+    for (int k = inicio; k < fim; ) {
+        int destinoId = chaves[k].destino;
+        Antena* destino = grafo->porId[destinoId];
+        int existentes = contagens->contagem[destinoId];
+        int retirar = 0;
+        for (; k < fim && chaves[k].destino == destinoId; k++) {
+            const Alteracao* alteracao = &alteracoes[chaves[k].indice];
+            int* estado = &estados[chaves[k].indice];
+            if (alteracao->tipo == INSERIR_LIGACAO) {
+                if (alteracao->verificarRepetidos && existentes > 0) *estado = -5; // Aresta j existe
+                else if (AdicionarAdj(grafo, origem, destino) != 0) *estado = -4; // Falha ao alocar memria
+                else {
+                    existentes++;
+                    *estado = 0;
+                }
+            }
+            else if (existentes == 0) {
+                *estado = -6; // Aresta no encontrada
+            }
+            else {
+                existentes--;
+                retirar++;
+                *estado = 0;
+            }
+            if (*estado != 0) falhas++;
+        }
+        contagens->contagem[destinoId] = retirar;
+        for (int r = 0; r < retirar; r++) {
+            retiradas[*totalRetiradas].origem = destinoId; // Agrupadas pela antena cujas entradas mudam
+            retiradas[*totalRetiradas].destino = origem->id;
+            retiradas[*totalRetiradas].indice = *totalRetiradas;
+            (*totalRetiradas)++;
+        }
+        if (retirar > 0) haRemocoes = true;
+    }
+
+    if (haRemocoes) RetirarMarcadas(grafo, &origem->ligacoes, contagens, origem);
+    return falhas;
+}
+
+/**
+ * Retira das listas de entradas os ns das ligaes removidas, uma passagem por cada
+ * antena de destino.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param retiradas --> Ligaes retiradas como (destino, origem).
+ * @param total --> Nmero de ligaes retiradas.
+ * @param contagens --> Contagens por id de origem.
+ * @param fim --> Posio a seguir  ltima ligao do destino atual.
+ */
+static void RetirarEntradas(Grafo* grafo, ChaveLigacao* retiradas, int total, ContagensId* contagens) {
+    qsort(retiradas, total, sizeof(ChaveLigacao), CompararChavesLigacao);
+    for (int inicio = 0; inicio < total; ) {
+        int fim = inicio;
+        contagens->epoca++;
+        while (fim < total && retiradas[fim].origem == retiradas[inicio].origem) {
+            (*Contagem(contagens, retiradas[fim].destino))++;
+            fim++;
+        }
+        RetirarMarcadas(grafo, &grafo->porId[retiradas[inicio].origem]->entradas, contagens, NULL);
+        inicio = fim;
+    }
+}
+#pragma endregion
+
+#pragma region AplicarAlteracoes
+/**
+ * Funo para aplicar um lote de alteraes ao grafo (inserir e remover antenas e ligaes).
+ * O resultado  o mesmo que chamar adicionarAntenaOrdenado, removerAntena, adicionarAresta
+ * e removerAresta para cada alterao, primeiro as de antenas por ordem de posio e depois
+ * as de ligaes (a ordem das ligaes novas de uma antena pode ser outra), mas a lista de
+ * antenas, cada balde e cada lista de ligaes tocados so percorridos uma s vez:
+ * O(a log a + antenas) para a alteraes de antenas e O(l log l + ligaes das antenas
+ * tocadas) para l alteraes de ligaes. A lista de antenas no tem de estar ordenada por
+ * (linha, coluna) (por exemplo depois de adicionarAntenaFim); ver AplicarAntenas.
+ * Os cdigos em estados so os das funes de uma alterao:
+ *  - INSERIR_ANTENA: 0, -2 se j existir uma antena na posio, -3 se falhar a alocao;
+ *  - REMOVER_ANTENA: 0, -2 se no existir a antena;
+ *  - INSERIR_LIGACAO: 0, -1/-2/-3 se a origem/o destino/ambos no existirem, -4 se falhar a
+ *    alocao, -5 se j existir e verificarRepetidos estiver ligado;
+ *  - REMOVER_LIGACAO: 0, -1/-2/-3 como acima, -6 se a ligao no existir.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param alteracoes --> Vetor de alteraes.
+ * @param total --> Nmero de alteraes.
+ * @param estados --> Vetor com total posies onde fica o cdigo de cada alterao.
+ * @param chavesAntenas --> Alteraes de antenas a ordenar.
+ * @param removidas --> Antenas removidas no lote, at serem retiradas dos baldes.
+ * @param chavesLigacoes --> Alteraes de ligaes a ordenar (s as que tm as duas antenas).
+ * @param retiradas --> Ligaes removidas, para limpar as entradas dos destinos.
+ * @param maxIds --> Limite dos ids das antenas depois das inseres do lote.
+ * @param contagens --> Contagens por id usadas ao percorrer as listas de ligaes.
+ * @param return --> Nmero de alteraes que falharam, -1 se os argumentos forem invlidos,
+ *                   -2 se falhar a alocao (nesse caso nada  alterado).
+ */
+int AplicarAlteracoes(Grafo* grafo, const Alteracao* alteracoes, int total, int* estados) {
+    if (!grafo || total < 0 || (total > 0 && (!alteracoes || !estados))) return -1;
+
+    //Cada antena inserida no lote reutiliza um id livre ou recebe o seguinte, por isso fica abaixo de maxIds
+    int maxIds = grafo->totalIds;
+    for (int i = 0; i < total; i++) {
+        if (alteracoes[i].tipo == INSERIR_ANTENA) maxIds++;
+    }
+
+    int tamanho = total > 0 ? total : 1;
+    ChaveAntena* chavesAntenas = malloc(tamanho * sizeof(ChaveAntena));
+    Antena** removidas = malloc(tamanho * sizeof(Antena*));
+    ChaveLigacao* chavesLigacoes = malloc(tamanho * sizeof(ChaveLigacao));
+    ChaveLigacao* retiradas = malloc(tamanho * sizeof(ChaveLigacao));
+    ContagensId contagens = { calloc(maxIds > 0 ? maxIds : 1, sizeof(unsigned int)), malloc((maxIds > 0 ? maxIds : 1) * sizeof(int)), 0 };
+    if (!chavesAntenas || !removidas || !chavesLigacoes || !retiradas || !contagens.marca || !contagens.contagem) {
+        free(chavesAntenas); free(removidas); free(chavesLigacoes); free(retiradas);
+        free(contagens.marca); free(contagens.contagem);
+        return -2;
+    }
+
+    //Antenas primeiro, numa passagem pela lista
+    int totalAntenas = 0;
+    for (int i = 0; i < total; i++) {
+        if (alteracoes[i].tipo != INSERIR_ANTENA && alteracoes[i].tipo != REMOVER_ANTENA) continue;
+        chavesAntenas[totalAntenas].linha = alteracoes[i].linha;
+        chavesAntenas[totalAntenas].coluna = alteracoes[i].coluna;
+        chavesAntenas[totalAntenas].indice = i;
+        totalAntenas++;
+    }
+    qsort(chavesAntenas, totalAntenas, sizeof(ChaveAntena), CompararChavesAntena);
+    int falhas = AplicarAntenas(grafo, alteracoes, chavesAntenas, totalAntenas, estados, removidas);
+    free(chavesAntenas);
+    free(removidas);
+
+    //Ligaes, com as antenas j encontradas no ndice
+    int totalLigacoes = 0;
+    for (int i = 0; i < total; i++) {
+        if (alteracoes[i].tipo != INSERIR_LIGACAO && alteracoes[i].tipo != REMOVER_LIGACAO) continue;
+        Antena* origem = procurarAntena(grafo, alteracoes[i].coluna, alteracoes[i].linha);
+        Antena* destino = procurarAntena(grafo, alteracoes[i].colunaDestino, alteracoes[i].linhaDestino);
+        if (!origem || !destino) {
+            estados[i] = !origem && !destino ? -3 : (!origem ? -1 : -2);
+            falhas++;
+            continue;
+        }
+        chavesLigacoes[totalLigacoes].origem = origem->id;
+        chavesLigacoes[totalLigacoes].destino = destino->id;
+        chavesLigacoes[totalLigacoes].indice = i;
+        totalLigacoes++;
+    }
+
+    if (totalLigacoes > 0) {
+        qsort(chavesLigacoes, totalLigacoes, sizeof(ChaveLigacao), CompararChavesLigacao);
+        int totalRetiradas = 0;
+        for (int inicio = 0; inicio < totalLigacoes; ) {
+            int fim = inicio;
+            while (fim < totalLigacoes && chavesLigacoes[fim].origem == chavesLigacoes[inicio].origem) fim++;
+            falhas += AplicarLigacoesOrigem(grafo, alteracoes, chavesLigacoes, inicio, fim, &contagens, retiradas, &totalRetiradas, estados);
+            inicio = fim;
+        }
+        RetirarEntradas(grafo, retiradas, totalRetiradas, &contagens);
+    }
+
+    free(chavesLigacoes);
+    free(retiradas);
+    free(contagens.marca);
+    free(contagens.contagem);
+    return falhas;
+}
+#pragma endregion
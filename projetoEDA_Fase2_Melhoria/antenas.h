@@ -13,8 +13,9 @@
 #include <stdbool.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
 #define _CRT_SECURE_NO_WARNINGS
-#define MAX_X 1024
+#define NUM_FREQUENCIAS 256
 
 #pragma region Adjacencias
 /**
@@ -37,6 +38,9 @@ typedef struct Adjacencia {
  * @param ligacoes --> Lista de ligaes a outras antenas.
  * @param visitada --> Indicador se a antena foi visitada em algoritmos de travessia.
  * @param proxima --> Apontador para a prxima antena na lista do grafo.
+ * @param id --> Identificador da antena no grafo (posio em grafo->porId), reutilizado depois de a antena ser removida.
+ * @param entradas --> Ligaes que chegam a esta antena (o destino de cada n  a antena de origem).
+ * @param anterior --> Apontador para a antena anterior na lista do grafo.
  */
 typedef struct Antena {
     char frequencia;            
@@ -45,31 +49,200 @@ typedef struct Antena {
     Adjacencia* ligacoes;       
     bool visitada;              
     struct Antena* proxima;     
+    int id;
+    Adjacencia* entradas;
+    struct Antena* anterior;
 } Antena;
 #pragma endregion
 
-#pragma region CaminhoNo
+#pragma region BaldeFrequencia
 /**
- * Estrutura que representa um n em um caminho de antenas.
- * @param antena --> Apontador para a antena no caminho.
- * @param proxima --> Apontador para o prximo n do caminho.
+ * Estrutura que agrupa todas as antenas com a mesma frequncia.
+ * As ligaes entre antenas da mesma frequncia no so guardadas como Adjacencia,
+ * so enumeradas a partir do balde quando so precisas.
+ * @param antenas --> Vetor com as antenas do balde, pela ordem em que foram inseridas.
+ * @param total --> Nmero de antenas no balde.
+ * @param capacidade --> Nmero de posies alocadas no vetor.
  */
-typedef struct CaminhoNo {
-    Antena* antena;             
-    struct CaminhoNo* proxima; 
-} CaminhoNo;
+typedef struct BaldeFrequencia {
+    Antena** antenas;
+    int total;
+    int capacidade;
+} BaldeFrequencia;
 #pragma endregion
 
-#pragma region FilaNo
+#pragma region Arena
 /**
- * Estrutura que representa um n em uma fila de antenas.
- * @param antena --> Apontador para a antena na fila.
- * @param proxima --> Apontador para o prximo n da fila.
+ * Tipos de n servidos pela arena do grafo.
  */
-typedef struct FilaNo {
-    Antena* antena;            
-    struct FilaNo* proxima;    
-} FilaNo;
+typedef enum TipoNo {
+    NO_ANTENA,
+    NO_ADJACENCIA,
+    NUM_TIPOS_NO
+} TipoNo;
+
+/**
+ * N devolvido  arena, guardado numa lista de livres do seu tipo.
+ * @param proximo --> Apontador para o prximo n livre do mesmo tipo.
+ */
+typedef struct NoLivre {
+    struct NoLivre* proximo;
+} NoLivre;
+
+/**
+ * Bloco de memria de onde a arena corta os ns.
+ * @param proximo --> Apontador para o bloco reservado anteriormente.
+ * @param tamanho --> Nmero de bytes disponveis em dados.
+ * @param usado --> Nmero de bytes de dados j entregues.
+ * @param dados --> Memria do bloco.
+ */
+typedef struct BlocoArena {
+    struct BlocoArena* proximo;
+    size_t tamanho;
+    size_t usado;
+    unsigned char dados[];
+} BlocoArena;
+
+/**
+ * Estrutura que representa o alocador (arena) de um grafo.
+ * @param blocos --> Lista de blocos reservados (o primeiro  o bloco atual).
+ * @param livres --> Listas de ns libertados, uma por tipo de n.
+ * @param bytesReservados --> Total de bytes reservados em blocos.
+ * @param bytesUsados --> Total de bytes j cortados dos blocos.
+ * @param nosEmUso --> Nmero de ns de cada tipo atualmente em uso.
+ * @param nosAlocados --> Nmero de ns de cada tipo cortados dos blocos.
+ */
+typedef struct Arena {
+    BlocoArena* blocos;
+    NoLivre* livres[NUM_TIPOS_NO];
+    size_t bytesReservados;
+    size_t bytesUsados;
+    long long nosEmUso[NUM_TIPOS_NO];
+    long long nosAlocados[NUM_TIPOS_NO];
+} Arena;
+
+/**
+ * Estatsticas de memria da arena de um grafo.
+ * @param bytesReservados --> Total de bytes reservados em blocos.
+ * @param bytesUsados --> Total de bytes j cortados dos blocos.
+ * @param totalBlocos --> Nmero de blocos reservados.
+ * @param nosEmUso --> Nmero de ns de cada tipo atualmente em uso.
+ * @param nosAlocados --> Nmero de ns de cada tipo cortados dos blocos.
+ */
+typedef struct EstatisticasArena {
+    size_t bytesReservados;
+    size_t bytesUsados;
+    int totalBlocos;
+    long long nosEmUso[NUM_TIPOS_NO];
+    long long nosAlocados[NUM_TIPOS_NO];
+} EstatisticasArena;
+#pragma endregion
+
+#pragma region IndiceEspacial
+/**
+ * Entrada do ndice espacial.
+ * @param coluna --> Coluna da antena (guardada aqui para no ter de seguir o apontador).
+ * @param linha --> Linha da antena.
+ * @param antena --> Apontador para a antena (NULL se a posio estiver vazia).
+ */
+typedef struct EntradaIndice {
+    int coluna;
+    int linha;
+    Antena* antena;
+} EntradaIndice;
+
+/**
+ * Estrutura que representa o ndice espacial (coluna, linha) -> antena.
+ * @param entradas --> Tabela de disperso com sondagem linear.
+ * @param capacidade --> Nmero de posies da tabela (potncia de 2).
+ * @param total --> Nmero de antenas registadas.
+ */
+typedef struct IndiceEspacial {
+    EntradaIndice* entradas;
+    int capacidade;
+    int total;
+} IndiceEspacial;
+#pragma endregion
+
+#pragma region Componentes
+//Nmero de palavras de 32 bits para ter um bit por frequncia
+#define PALAVRAS_FREQUENCIAS (NUM_FREQUENCIAS / 32)
+
+/**
+ * Componentes fracamente ligadas do grafo (ver componentes.c): o sentido das ligaes  ignorado,
+ * por isso duas antenas da mesma componente podem no se alcanar uma  outra.
+ * Todas as antenas de uma frequncia esto na mesma componente, por isso as componentes
+ * so guardadas por frequncia e h no mximo NUM_FREQUENCIAS.
+ * @param rotulo --> Componente de cada frequncia (-1 se no houver antenas dessa frequncia).
+ * @param antenasFrequencia --> Nmero de antenas de cada frequncia.
+ * @param ligacoesEntre --> NUM_FREQUENCIAS x NUM_FREQUENCIAS contagens de ligaes explcitas
+ *                          entre antenas de duas frequncias diferentes (nos dois sentidos).
+ * @param tamanho --> Nmero de antenas de cada componente.
+ * @param numFrequencias --> Nmero de frequncias diferentes de cada componente.
+ * @param frequencias --> PALAVRAS_FREQUENCIAS palavras por componente, com o bit f ligado se tiver antenas de f.
+ * @param totalComponentes --> Nmero de componentes.
+ */
+typedef struct Componentes {
+    int rotulo[NUM_FREQUENCIAS];
+    int antenasFrequencia[NUM_FREQUENCIAS];
+    int* ligacoesEntre;
+    int tamanho[NUM_FREQUENCIAS];
+    int numFrequencias[NUM_FREQUENCIAS];
+    unsigned int frequencias[NUM_FREQUENCIAS][PALAVRAS_FREQUENCIAS];
+    int totalComponentes;
+} Componentes;
+#pragma endregion
+
+#pragma region ArvoreEspacial
+/**
+ * N da rvore espacial (quadtree de pontos, ver arvoreespacial.c).
+ * Cobre o quadrado [coluna, coluna + lado) x [linha, linha + lado); um n interior divide-o
+ * em quatro quadrantes iguais e uma folha guarda as antenas do quadrado.
+ * @param coluna, linha --> Canto do quadrado (menor coluna e menor linha).
+ * @param lado --> Lado do quadrado (potncia de 2).
+ * @param folha --> Verdadeiro se o n guarda antenas, falso se tem filhos.
+ * @param filhos --> Quadrantes (coluna, linha) baixa/alta: 0 = (baixa, baixa), 1 = (alta, baixa),
+ *                   2 = (baixa, alta), 3 = (alta, alta); NULL se o quadrante estiver vazio.
+ * @param antenas --> Antenas da folha.
+ * @param total --> Nmero de antenas da folha.
+ * @param capacidade --> Nmero de posies alocadas em antenas.
+ * @param contagem --> Nmero de antenas na subrvore.
+ * @param frequencias --> Um bit por frequncia presente na subrvore.
+ */
+typedef struct NoArvore {
+    long long coluna;
+    long long linha;
+    long long lado;
+    bool folha;
+    struct NoArvore* filhos[4];
+    Antena** antenas;
+    int total;
+    int capacidade;
+    int contagem;
+    unsigned int frequencias[PALAVRAS_FREQUENCIAS];
+} NoArvore;
+
+/**
+ * rvore espacial das antenas de um grafo, para consultas por retngulo, raio e vizinhas mais prximas.
+ * @param raiz --> N que cobre todas as antenas (NULL se a rvore estiver vazia).
+ * @param totalNos --> Nmero de ns da rvore.
+ */
+typedef struct ArvoreEspacial {
+    NoArvore* raiz;
+    int totalNos;
+} ArvoreEspacial;
+
+/**
+ * Antenas devolvidas por uma consulta  rvore espacial.
+ * @param antenas --> Antenas encontradas.
+ * @param total --> Nmero de antenas encontradas.
+ * @param capacidade --> Nmero de posies alocadas (reutilizadas pela consulta seguinte).
+ */
+typedef struct AntenasEncontradas {
+    Antena** antenas;
+    int total;
+    int capacidade;
+} AntenasEncontradas;
 #pragma endregion
 
 #pragma region Grafo
@@ -77,26 +250,663 @@ typedef struct FilaNo {
  * Estrutura que representa o grafo de antenas.
  * @param antenas --> Apontador para a primeira antena do grafo.
  * @param totalAntenas --> Nmero total de antenas no grafo.
+ * @param baldes --> Tabela com NUM_FREQUENCIAS baldes, indexada pela frequncia.
+ * @param arena --> Alocador de onde saem todos os ns do grafo.
+ * @param indice --> ndice espacial para encontrar antenas pela coordenada.
+ * @param antenasForaDoIndice --> Antenas numa coordenada que j tinha outra, por isso fora do ndice.
+ * @param porId --> Tabela id -> antena (NULL nas posies de antenas removidas).
+ * @param totalIds --> Nmero de ids atribudos (tamanho til de porId).
+ * @param capacidadeIds --> Nmero de posies alocadas em porId (e em idsLivres).
+ * @param idsLivres --> Pilha com os ids das antenas removidas, reutilizados por RegistarId.
+ * @param totalIdsLivres --> Nmero de ids em idsLivres.
+ * @param componentes --> Componentes calculadas por RotularComponentes e mantidas a cada alterao (NULL se no houver).
+ * @param largura --> Nmero de colunas da maior grelha lida para o grafo (0 se no for conhecido).
+ * @param altura --> Nmero de linhas da maior grelha lida para o grafo (0 se no for conhecido).
+ * @param arvore --> rvore espacial construda na primeira consulta por zona e mantida a cada alterao (NULL se no houver).
  */
 typedef struct Grafo {
     Antena* antenas;           
     int totalAntenas;       
+    BaldeFrequencia* baldes;
+    Arena* arena;
+    IndiceEspacial* indice;
+    int antenasForaDoIndice;
+    Antena** porId;
+    int totalIds;
+    int capacidadeIds;
+    int* idsLivres;
+    int totalIdsLivres;
+    Componentes* componentes;
+    int largura;
+    int altura;
+    ArvoreEspacial* arvore;
 } Grafo;
 #pragma endregion
 
+#pragma region IteradorVizinhos
+/**
+ * Estrutura para percorrer os vizinhos de uma antena.
+ * Primeiro devolve as ligaes explcitas (Adjacencia) e depois as antenas do mesmo balde.
+ * @param origem --> Antena cujos vizinhos esto a ser percorridos.
+ * @param adj --> Prxima ligao explcita a devolver.
+ * @param balde --> Balde da frequncia da antena de origem (NULL se no existir).
+ * @param indice --> Prxima posio a devolver no balde.
+ */
+typedef struct IteradorVizinhos {
+    Antena* origem;
+    Adjacencia* adj;
+    BaldeFrequencia* balde;
+    int indice;
+} IteradorVizinhos;
+#pragma endregion
+
+#pragma region GrafoCSR
+/**
+ * Estrutura que representa uma cpia compacta e s de leitura de um Grafo (formato CSR).
+ * Cada antena  identificada pela sua posio (0..totalAntenas-1) na lista do grafo original.
+ * @param totalAntenas --> Nmero de antenas na cpia.
+ * @param totalArestas --> Nmero de ligaes explcitas (Adjacencia) na cpia.
+ * @param frequencias --> Frequncia de cada antena.
+ * @param colunas --> Coluna de cada antena.
+ * @param linhas --> Linha de cada antena.
+ * @param inicioArestas --> Para a antena i, as ligaes explcitas esto em destinos[inicioArestas[i]..inicioArestas[i+1]-1].
+ * @param destinos --> ndices das antenas de destino das ligaes explcitas.
+ * @param inicioBaldes --> Para a frequncia f, o balde est em membrosBaldes[inicioBaldes[f]..inicioBaldes[f+1]-1].
+ * @param membrosBaldes --> ndices das antenas de cada balde de frequncia, pela ordem de insero.
+ * @param largura --> Nmero de colunas da grelha do grafo original (0 se no for conhecido).
+ * @param altura --> Nmero de linhas da grelha do grafo original (0 se no for conhecido).
+ */
+typedef struct GrafoCSR {
+    int totalAntenas;
+    int totalArestas;
+    char* frequencias;
+    int* colunas;
+    int* linhas;
+    int* inicioArestas;
+    int* destinos;
+    int* inicioBaldes;
+    int* membrosBaldes;
+    int largura;
+    int altura;
+} GrafoCSR;
+#pragma endregion
+
+#pragma region Carregamento
+/**
+ * Ficheiro mapeado em memria (ou lido por inteiro quando no  possvel mapear).
+ * @param dados --> Contedo do ficheiro (no termina em '\0').
+ * @param tamanho --> Nmero de bytes do ficheiro.
+ * @param mapeado --> Verdadeiro se dados vem de um mapeamento, falso se foi alocado.
+ */
+typedef struct FicheiroMapeado {
+    const char* dados;
+    size_t tamanho;
+    bool mapeado;
+} FicheiroMapeado;
+
+/**
+ * Antena lida do ficheiro, ainda fora do grafo.
+ * @param frequencia --> Frequncia da antena.
+ * @param coluna --> Coluna da antena.
+ * @param linha --> Linha da antena.
+ */
+typedef struct RegistoAntena {
+    char frequencia;
+    int coluna;
+    int linha;
+} RegistoAntena;
+
+/**
+ * Vetor de antenas lidas, pela ordem em que aparecem no ficheiro.
+ * @param registos --> Antenas lidas.
+ * @param total --> Nmero de antenas no lote.
+ * @param capacidade --> Nmero de posies alocadas.
+ */
+typedef struct LoteAntenas {
+    RegistoAntena* registos;
+    int total;
+    int capacidade;
+} LoteAntenas;
+
+/**
+ * Estatsticas de uma leitura de ficheiro de antenas.
+ * @param bytes --> Tamanho do ficheiro lido.
+ * @param linhas --> Nmero de linhas da grelha lidas.
+ * @param antenas --> Nmero de antenas encontradas.
+ * @param threads --> Nmero de threads que leram a grelha.
+ * @param largura --> Nmero de colunas indicado no cabealho.
+ * @param altura --> Nmero de linhas indicado no cabealho.
+ * @param segundosAnalise --> Tempo da leitura da grelha (sem a insero no grafo).
+ * @param segundos --> Tempo total da leitura (incluindo a insero no grafo).
+ * @param mbPorSegundo --> Dbito da leitura em MB/s.
+ */
+typedef struct EstatisticasCarregamento {
+    size_t bytes;
+    int linhas;
+    int antenas;
+    int threads;
+    int largura;
+    int altura;
+    double segundosAnalise;
+    double segundos;
+    double mbPorSegundo;
+} EstatisticasCarregamento;
+#pragma endregion
+
+#pragma region Intersecoes
+/**
+ * Antenas de um grafo ordenadas num eixo (por linha ou por coluna), depois por frequncia
+ * e depois pela posio na lista do grafo.
+ * @param ordem --> ndices das antenas por essa ordem.
+ * @param posicao --> Posio de cada antena (pelo ndice) em ordem.
+ * @param inicioGrupo --> Para cada posio, incio do grupo com a mesma linha/coluna.
+ * @param fimGrupo --> Para cada posio, fim (exclusivo) desse grupo.
+ * @param fimSerie --> Para cada posio, fim (exclusivo) da srie com a mesma linha/coluna e frequncia.
+ */
+typedef struct EixoIntersecoes {
+    int* ordem;
+    int* posicao;
+    int* inicioGrupo;
+    int* fimGrupo;
+    int* fimSerie;
+} EixoIntersecoes;
+
+/**
+ * ndice para enumerar as intersees de um grafo (ver intersecoes.c).
+ * @param totalAntenas --> Nmero de antenas.
+ * @param antenas --> Antenas pela ordem da lista do grafo.
+ * @param porFrequencia --> ndices das antenas agrupados por frequncia, pela ordem da lista.
+ * @param inicioFrequencia --> Incio de cada frequncia em porFrequencia.
+ * @param linhas --> Antenas ordenadas por linha.
+ * @param colunas --> Antenas ordenadas por coluna.
+ */
+typedef struct IndiceIntersecoes {
+    int totalAntenas;
+    Antena** antenas;
+    int* porFrequencia;
+    int inicioFrequencia[NUM_FREQUENCIAS + 1];
+    EixoIntersecoes linhas;
+    EixoIntersecoes colunas;
+} IndiceIntersecoes;
+
+/**
+ * Funo chamada para cada interseo (a de frequncia freqA ou menor, b a outra).
+ * Devolve 0 para continuar ou outro valor para parar.
+ */
+typedef int (*VisitanteIntersecao)(const Antena* a, const Antena* b, void* contexto);
+#pragma endregion
+
+#pragma region BufferTexto
+//Espao para "(x,y)": com dois int tem no mximo 25 carateres
+#define TAMANHO_COORDENADA 32
+
+/**
+ * Texto formatado em memria, que cresce conforme  preciso.
+ * @param dados --> Bytes do texto (no termina em '\0').
+ * @param tamanho --> Nmero de bytes escritos.
+ * @param capacidade --> Nmero de bytes alocados.
+ */
+typedef struct BufferTexto {
+    char* dados;
+    size_t tamanho;
+    size_t capacidade;
+} BufferTexto;
+#pragma endregion
+
+#pragma region EscritorTexto
+#define TAMANHO_ESCRITOR (64 * 1024)
+
+/**
+ * Escritor de resultados para um ficheiro ou para memria, com um buffer fixo (ver escritortexto.c).
+ * @param saida --> Ficheiro de destino (NULL se o destino for memoria).
+ * @param memoria --> Buffer de destino, quando o texto fica em memria.
+ * @param usado --> Nmero de bytes no buffer ainda por escrever.
+ * @param erro --> 0, -3 se alguma escrita no ficheiro falhou ou -2 se o buffer de destino no pde crescer.
+ * @param dados --> Buffer.
+ */
+typedef struct EscritorTexto {
+    FILE* saida;
+    BufferTexto* memoria;
+    size_t usado;
+    int erro;
+    char dados[TAMANHO_ESCRITOR];
+} EscritorTexto;
+#pragma endregion
+
+#pragma region VetoresAntenas
+/**
+ * Tipo das coordenadas em VetoresAntenas, escolhido na compilao: com COORDENADAS_16_BITS
+ * cabem o dobro das antenas em cada vetor SIMD, mas as coordenadas ficam limitadas a 0..32767.
+ */
+#ifdef COORDENADAS_16_BITS
+typedef int16_t Coordenada;
+#define MAX_COORDENADA INT16_MAX
+#else
+typedef int32_t Coordenada;
+#define MAX_COORDENADA INT32_MAX
+#endif
+
+/**
+ * Alinhamentos testados por AntenasAlinhadas, com dx e dy as diferenas de coordenadas:
+ * mesma linha ou coluna (dx == 0 || dy == 0), ou tambm na mesma diagonal (|dx| == |dy|).
+ */
+typedef enum Alinhamento {
+    ALINHAMENTO_LINHA_COLUNA,
+    ALINHAMENTO_DIAGONAL
+} Alinhamento;
+
+/**
+ * Antenas do grafo guardadas por campos (um vetor por campo), agrupadas por frequncia e,
+ * dentro de cada frequncia, pela ordem da lista. Os testes de coordenadas s leem os
+ * vetores de colunas e de linhas, sem passar pelos ns da lista.
+ * @param frequencias --> Frequncia de cada antena.
+ * @param colunas --> Coluna de cada antena.
+ * @param linhas --> Linha de cada antena.
+ * @param posicoes --> Posio de cada antena na lista do grafo.
+ * @param inicioFrequencia --> Incio de cada frequncia nos vetores (a frequncia f ocupa [inicioFrequencia[f], inicioFrequencia[f+1])).
+ * @param total --> Nmero de antenas.
+ */
+typedef struct VetoresAntenas {
+    char* frequencias;
+    Coordenada* colunas;
+    Coordenada* linhas;
+    int* posicoes;
+    int inicioFrequencia[NUM_FREQUENCIAS + 1];
+    int total;
+} VetoresAntenas;
+#pragma endregion
+
+#pragma region Interferencias
+/**
+ * Opes do clculo dos pontos de interferncia.
+ * @param numThreads --> Nmero de threads (0 ou negativo para usar todos os processadores).
+ * @param semDuplicados --> Se verdadeiro, cada ponto s  escrito uma vez (na primeira ocorrncia)
+ *                          e uma antena no  comparada consigo prpria.
+ */
+typedef struct OpcoesInterferencias {
+    int numThreads;
+    bool semDuplicados;
+} OpcoesInterferencias;
+
+/**
+ * Funo chamada para cada ponto de interferncia. Devolve 0 para continuar ou outro valor para parar.
+ */
+typedef int (*VisitantePonto)(int coluna, int linha, void* contexto);
+
+/**
+ * Clulas da grelha afetadas por interferncias (ver CalcularMapaInterferencias).
+ * @param largura, altura --> Limites do mapa; os pontos fora de 0..largura-1 x 0..altura-1 so ignorados.
+ * @param bits --> Um bit por clula, linha a linha (bit coluna + linha * largura).
+ * @param totalCelulas --> Nmero de clulas afetadas (bits acesos).
+ * @param pontosCalculados --> Pontos calculados, contando os repetidos e os que ficaram fora do mapa.
+ * @param pontosFora --> Pontos ignorados por estarem fora do mapa.
+ * @param celulas --> Clulas afetadas em pares (coluna, linha), por linha e depois por coluna
+ *                    (NULL se no foram pedidas).
+ */
+typedef struct MapaInterferencias {
+    int largura;
+    int altura;
+    uint64_t* bits;
+    long long totalCelulas;
+    long long pontosCalculados;
+    long long pontosFora;
+    int* celulas;
+} MapaInterferencias;
+#pragma endregion
+
+#pragma region Caminhos
+//Limites da procura de caminhos do relatrio (ver EncontrarCaminhos)
+#define MAX_CAMINHOS_RELATORIO 1000
+#define MAX_SEGUNDOS_CAMINHOS 5.0
+
+/**
+ * Funo chamada por ProcurarCaminhos para cada caminho encontrado.
+ * Devolve 0 para continuar a procura ou outro valor para a parar.
+ * O vetor caminho (da origem ao destino) s  vlido durante a chamada.
+ */
+typedef int (*CallbackCaminho)(Antena** caminho, int comprimento, void* contexto);
+
+/**
+ * Modos de procura de caminhos (ver caminhos.c).
+ * CAMINHOS_CONTAR conta caminhos simples (sem repetir antenas), enumerando-os sem os entregar,
+ * por isso pode ser exponencial e respeita os limites. CAMINHOS_CONTAR_PASSEIOS conta passeios,
+ * que podem repetir antenas, em tempo polinomial;  um majorante do nmero de caminhos simples.
+ */
+typedef enum ModoCaminhos {
+    CAMINHO_MAIS_CURTO,
+    CAMINHOS_K_MAIS_CURTOS,
+    CAMINHOS_CONTAR,
+    CAMINHOS_TODOS,
+    CAMINHOS_CONTAR_PASSEIOS
+} ModoCaminhos;
+
+/**
+ * Limites de uma procura de caminhos (0 quer dizer sem limite).
+ * @param maxCaminhos --> Nmero mximo de caminhos entregues.
+ * @param maxProfundidade --> Nmero mximo de ligaes de um caminho.
+ * @param maxSegundos --> Tempo mximo da procura, em segundos.
+ */
+typedef struct LimitesCaminhos {
+    long long maxCaminhos;
+    int maxProfundidade;
+    double maxSegundos;
+} LimitesCaminhos;
+
+/**
+ * Consulta de caminhos entre duas antenas.
+ * @param modo --> Tipo de procura.
+ * @param k --> Nmero de caminhos pedidos em CAMINHOS_K_MAIS_CURTOS.
+ * @param limites --> Limites da procura.
+ * @param callback --> Funo chamada para cada caminho (pode ser NULL).
+ * @param contexto --> Dados passados ao callback.
+ */
+typedef struct ConsultaCaminhos {
+    ModoCaminhos modo;
+    int k;
+    LimitesCaminhos limites;
+    CallbackCaminho callback;
+    void* contexto;
+} ConsultaCaminhos;
+
+/**
+ * Resultado de uma procura de caminhos.
+ * @param caminhos --> Nmero de caminhos entregues ao callback.
+ * @param contagem --> Em CAMINHOS_CONTAR, nmero de caminhos simples da origem ao destino;
+ *                     em CAMINHOS_CONTAR_PASSEIOS, nmero de passeios.
+ * @param truncado --> A procura parou num limite e pode haver mais caminhos.
+ * @param esgotouTempo --> O limite atingido foi o tempo.
+ */
+typedef struct ResultadoCaminhos {
+    long long caminhos;
+    unsigned long long contagem;
+    bool truncado;
+    bool esgotouTempo;
+} ResultadoCaminhos;
+#pragma endregion
+
+#pragma region Visitados
+/**
+ * Marcas de visita de uma travessia, guardadas fora do grafo e indexadas pelo id das antenas.
+ * Uma antena est visitada quando marcas[id] == epoca; comear uma travessia nova s
+ * incrementa epoca, sem percorrer o vetor. Cada travessia em curso precisa do seu.
+ * @param marcas --> poca em que cada antena foi visitada pela ltima vez.
+ * @param epoca --> poca da travessia atual (nunca 0).
+ * @param capacidade --> Nmero de posies de marcas.
+ */
+typedef struct Visitados {
+    unsigned int* marcas;
+    unsigned int epoca;
+    int capacidade;
+} Visitados;
+#pragma endregion
+
+#pragma region VisitanteAntena
+/**
+ * Funo chamada pelas travessias para cada antena visitada, com a profundidade
+ * (nmero de ligaes desde o incio). Devolve 0 para continuar ou outro valor para parar.
+ */
+typedef int (*VisitanteAntena)(Antena* antena, int profundidade, void* contexto);
+#pragma endregion
+
+#pragma region Largura
+/**
+ * Modos de NiveisEmLargura: s passos de cima para baixo, ou mudando de direo em cada nvel.
+ */
+typedef enum ModoLargura {
+    LARGURA_DESCENDENTE,
+    LARGURA_DIRECAO_OTIMIZADA
+} ModoLargura;
+
+/**
+ * Resumo de uma procura em largura por nveis.
+ * @param alcancadas --> Nmero de antenas alcanadas (incluindo a de incio).
+ * @param totalNiveis --> Nmero de nveis (1 se s a antena de incio for alcanada).
+ * @param passosDescendentes --> Nveis feitos de cima para baixo.
+ * @param passosAscendentes --> Nveis feitos de baixo para cima.
+ */
+typedef struct ResultadoLargura {
+    int alcancadas;
+    int totalNiveis;
+    int passosDescendentes;
+    int passosAscendentes;
+} ResultadoLargura;
+#pragma endregion
+
+#pragma region Alteracoes
+/**
+ * Tipos de alterao aceites por AplicarAlteracoes.
+ */
+typedef enum TipoAlteracao {
+    INSERIR_ANTENA,
+    REMOVER_ANTENA,
+    INSERIR_LIGACAO,
+    REMOVER_LIGACAO
+} TipoAlteracao;
+
+/**
+ * Uma alterao a aplicar ao grafo, com as antenas indicadas pela posio.
+ * @param tipo --> O que fazer.
+ * @param frequencia --> Frequncia da antena a inserir (s INSERIR_ANTENA).
+ * @param coluna --> Coluna da antena, ou da origem da ligao.
+ * @param linha --> Linha da antena, ou da origem da ligao.
+ * @param colunaDestino --> Coluna do destino da ligao (s ligaes).
+ * @param linhaDestino --> Linha do destino da ligao (s ligaes).
+ * @param verificarRepetidos --> Recusar a ligao se j existir (s INSERIR_LIGACAO).
+ */
+typedef struct Alteracao {
+    TipoAlteracao tipo;
+    char frequencia;
+    int coluna;
+    int linha;
+    int colunaDestino;
+    int linhaDestino;
+    bool verificarRepetidos;
+} Alteracao;
+#pragma endregion
+
+#pragma region Exportacao
+/**
+ * Formatos em que cada seco dos resultados pode ser exportada (ver exportacao.c).
+ */
+typedef enum FormatoExportacao {
+    EXPORTAR_NADA,
+    EXPORTAR_TEXTO,
+    EXPORTAR_CSV,
+    EXPORTAR_JSONL,
+    EXPORTAR_BINARIO
+} FormatoExportacao;
+
+/**
+ * Seces dos resultados, pela ordem do relatrio.
+ */
+typedef enum SeccaoExportacao {
+    SECCAO_ANTENAS,
+    SECCAO_PROFUNDIDADE,
+    SECCAO_LARGURA,
+    SECCAO_CAMINHOS,
+    SECCAO_INTERSECOES,
+    SECCAO_INTERFERENCIAS,
+    NUM_SECCOES
+} SeccaoExportacao;
+
+/**
+ * Destino de uma seco.
+ * @param formato --> Formato da seco (EXPORTAR_NADA para a omitir).
+ * @param saida --> Ficheiro onde a seco  escrita (pode ser partilhado por vrias seces).
+ */
+typedef struct DestinoExportacao {
+    FormatoExportacao formato;
+    FILE* saida;
+} DestinoExportacao;
+
+/**
+ * Opes de ExportarResultados.
+ * @param seccoes --> Destino de cada seco, indexado por SeccaoExportacao.
+ * @param interferencias --> Opes do clculo dos pontos de interferncia (a zeros, como no relatrio).
+ * @param inicio --> Antena onde comeam as travessias (NULL para a primeira da lista).
+ * @param origem --> Origem dos caminhos (NULL para a primeira antena da lista).
+ * @param destino --> Destino dos caminhos (NULL para a terceira antena da lista).
+ * @param paresFrequencias --> Pares de frequncias das intersees, seguidos, ou NULL para todos os pares.
+ */
+typedef struct OpcoesExportacao {
+    DestinoExportacao seccoes[NUM_SECCOES];
+    OpcoesInterferencias interferencias;
+    Antena* inicio;
+    Antena* origem;
+    Antena* destino;
+    const char* paresFrequencias;
+} OpcoesExportacao;
+#pragma endregion
+
+#pragma region Instrumentacao
+/**
+ * Contadores da instrumentao (ver instrumentacao.c).
+ */
+typedef enum ContadorInstrumentacao {
+    CONTADOR_ALOCACOES_ANTENA,
+    CONTADOR_ALOCACOES_ADJACENCIA,
+    CONTADOR_ARESTAS_PERCORRIDAS,
+    CONTADOR_ANTENAS_VISITADAS,
+    CONTADOR_PASSOS_PROCURAR,
+    CONTADOR_PASSOS_REMOVER,
+    CONTADOR_PASSOS_ADICIONAR,
+    CONTADOR_BYTES_ESCRITOS,
+    NUM_CONTADORES
+} ContadorInstrumentacao;
+
+/**
+ * Pontos de instrumentao dos caminhos quentes. S fazem alguma coisa se o programa for
+ * compilado com INSTRUMENTACAO definido; caso contrrio desaparecem na compilao.
+ * ABRIR_SPAN declara a varivel que FECHAR_SPAN recebe, por isso tm de estar no mesmo bloco.
+ */
+#ifdef INSTRUMENTACAO
+#define CONTAR(contador, quantidade) ContarInstrumentacao((contador), (long long)(quantidade))
+#define ABRIR_SPAN(span, nome) int span = AbrirSpan(nome)
+#define FECHAR_SPAN(span) FecharSpan(span)
+#else
+#define CONTAR(contador, quantidade) ((void)(quantidade))
+#define ABRIR_SPAN(span, nome) ((void)(nome))
+#define FECHAR_SPAN(span) ((void)0)
+#endif
+#pragma endregion
+
+#pragma region Medicao
+/**
+ * Estado do processo num instante, ou custo de uma fase (ver medicao.c).
+ * @param segundos --> Tempo de relgio (instante, ou durao da fase).
+ * @param segundosCPU --> Tempo de CPU do processo, somado em todas as threads (instante, ou gasto na fase).
+ * @param picoMemoria --> Maior conjunto residente do processo at ao fim da fase, em bytes.
+ */
+typedef struct Medicao {
+    double segundos;
+    double segundosCPU;
+    size_t picoMemoria;
+} Medicao;
+#pragma endregion
+
+#pragma region Relatorio
+/**
+ * Anlises do relatrio (ver ResultadosOpcoes), pela ordem em que aparecem; combinam-se com |.
+ * ANALISE_TODAS  o relatrio de Resultados; as componentes no fazem parte dele e tm de ser
+ * pedidas  parte (ANALISE_TODAS | ANALISE_COMPONENTES).
+ */
+typedef enum AnaliseRelatorio {
+    ANALISE_ANTENAS = 1 << 0,
+    ANALISE_PROFUNDIDADE = 1 << 1,
+    ANALISE_LARGURA = 1 << 2,
+    ANALISE_COMPONENTES = 1 << 3,
+    ANALISE_CAMINHOS = 1 << 4,
+    ANALISE_INTERSECOES = 1 << 5,
+    ANALISE_INTERFERENCIAS = 1 << 6,
+    ANALISE_TODAS = ((1 << 7) - 1) & ~ANALISE_COMPONENTES
+} AnaliseRelatorio;
+
+#define NUM_ANALISES 7
+
+/**
+ * Opes do relatrio. Com tudo a zeros (exceto analises) d o mesmo que Resultados.
+ * @param analises --> Anlises a fazer (combinao de AnaliseRelatorio).
+ * @param inicio --> Antena onde comeam as travessias (NULL para a primeira da lista).
+ * @param origem --> Origem dos caminhos (NULL para a primeira antena da lista).
+ * @param destino --> Destino dos caminhos (NULL para a terceira antena da lista).
+ * @param limitesCaminhos --> Limites da procura de caminhos (a zeros, os do relatrio).
+ * @param paresFrequencias --> Pares de frequncias das intersees, seguidos ("ABAC"  A-B e A-C),
+ *                             ou NULL para todos os pares.
+ * @param interferencias --> Opes do clculo dos pontos de interferncia.
+ * @param numThreads --> Threads para as anlises (0 para todos os processadores, 1 para as fazer
+ *                       uma a uma, escritas diretamente no ficheiro).
+ */
+typedef struct OpcoesRelatorio {
+    unsigned int analises;
+    Antena* inicio;
+    Antena* origem;
+    Antena* destino;
+    LimitesCaminhos limitesCaminhos;
+    const char* paresFrequencias;
+    OpcoesInterferencias interferencias;
+    int numThreads;
+} OpcoesRelatorio;
+
+/**
+ * Custo de cada fase de ResultadosOpcoes.
+ * @param seccoes --> Custo de cada anlise, pela posio do seu bit em AnaliseRelatorio (a zeros se
+ *                    no foi feita). Com as seces em paralelo o tempo de CPU de cada uma no 
+ *                    separvel e fica -1.
+ * @param escrita --> Custo de juntar as seces no ficheiro e de o fechar.
+ * @param threads --> Nmero de threads usadas para as seces.
+ * @param bytes --> Tamanho do relatrio escrito.
+ */
+typedef struct EstatisticasRelatorio {
+    Medicao seccoes[NUM_ANALISES];
+    Medicao escrita;
+    int threads;
+    long long bytes;
+} EstatisticasRelatorio;
+#pragma endregion
+
+#pragma region GrafoBinario
+/**
+ * Grafo aberto a partir de um ficheiro binrio (ver grafobinario.c).
+ * @param mapa --> Ficheiro mapeado em memria.
+ * @param csr --> Cpia compacta cujos vetores apontam para dentro do mapeamento (s de leitura).
+ */
+typedef struct GrafoBinario {
+    FicheiroMapeado mapa;
+    GrafoCSR csr;
+} GrafoBinario;
+#pragma endregion
+
+#pragma region Paralelo
+/**
+ * Tarefa executada por ExecutarEmParalelo para cada ndice (0..totalTarefas-1).
+ * Devolve 0 se correr bem ou um cdigo de erro.
+ */
+typedef int (*TarefaParalela)(int indice, void* contexto);
+#pragma endregion
+
 #pragma region FuncoesGrafo
 /**
  * Funes para manipulao de antenas em um grafo.
  */
-int AdicionarAdj(Antena* origem, Antena* destino);
+int AdicionarAdj(Grafo* grafo, Antena* origem, Antena* destino);
 int AdicionarAntena(Grafo* grafo, char freq, int col, int lin);
+int AdicionarAoBalde(Grafo* grafo, Antena* antena);
+int RemoverDoBalde(Grafo* grafo, Antena* antena);
+int RemoverDosBaldes(Grafo* grafo, Antena* const* removidas, int total);
+int RegistarAntena(Grafo* grafo, Antena* antena);
+int RegistarId(Grafo* grafo, Antena* antena);
+int LibertarId(Grafo* grafo, Antena* antena);
+int IniciarVizinhos(const Grafo* grafo, Antena* antena, IteradorVizinhos* it);
+Antena* ProximoVizinho(IteradorVizinhos* it);
 Grafo CarregarAntenasDoFicheiro(const char* nome_ficheiro);
 int TravessiaEmProfundidade(Grafo* grafo, Antena* inicio, FILE* saida);
 int TravessiaEmLargura(Grafo* grafo, Antena* inicio, FILE* saida);
+int ImprimirCaminho(Antena** caminho, int comprimento, FILE* saida);
 int EncontrarCaminhos(Grafo* grafo, Antena* origem, Antena* destino, FILE* saida);
 int MostrarIntersecoes(Grafo* grafo, char freqA, char freqB, FILE* saida);
 int MostrarInterferencias(Grafo* grafo, FILE* saida);
 int Resultados(Grafo grafo, const char* nome_ficheiro);
+int ResultadosOpcoes(Grafo* grafo, const char* nomeFicheiro, const OpcoesRelatorio* opcoes, EstatisticasRelatorio* estatisticas);
 int LibertarGrafo(Grafo* grafo);
 int LimparVisitados(Grafo* grafo);
 #pragma endregion
@@ -106,16 +916,249 @@ int LimparVisitados(Grafo* grafo);
  * Funes para manipulao de antenas em um grafo.
  */
 Antena* procurarAntena(Grafo* cidade, int coluna, int linha);
-Antena* popularAntena(char freq, int coluna, int linha);
+Antena* popularAntena(Grafo* cidade, char freq, int coluna, int linha);
 int adicionarAntenaOrdenado(Grafo* cidade, char freq, int coluna, int linha);
-int adicionarAntenaFim(Grafo* cidade, Antena* ultimaAntena, char freq, int coluna, int linha);
-Grafo* adicionarAntenaFimOtimizado(Grafo* cidade, Antena* ultimaAntena, char freq, int coluna, int linha);
+int adicionarAntenaFim(Grafo* cidade, char freq, int coluna, int linha);
+Antena* adicionarAntenaFimOtimizado(Grafo* cidade, Antena* ultimaAntena, char freq, int coluna, int linha);
 int removerAntena(Grafo* cidade, int coluna, int linha);
-Adjacencia* popularAdjacencia(Antena* destino);
+int desligarAntena(Grafo* cidade, Antena* alvo);
+Adjacencia* popularAdjacencia(Grafo* cidade, Antena* destino);
 Adjacencia* procurarAdjacencia(Antena* antenaAtual, Antena* destino);
-int adicionarAresta(Antena* antenaAtual, Antena* destino, bool verificarRepetidos);
-int removerAresta(Antena* antenaAtual, Antena* destino);
+int adicionarAresta(Grafo* cidade, Antena* antenaAtual, Antena* destino, bool verificarRepetidos);
+int removerAresta(Grafo* cidade, Antena* antenaAtual, Antena* destino);
 int carregarAntenasDoFicheiro(Grafo* cidade, const char* nomeFicheiro);
+int carregarAntenasDoFicheiroParalelo(Grafo* cidade, const char* nomeFicheiro, int numThreads);
+#pragma endregion
+
+#pragma region FuncoesArena
+/**
+ * Funes do alocador (arena) dos ns do grafo.
+ */
+Arena* CriarArena(void);
+void* AlocarNo(Arena* arena, TipoNo tipo);
+int LibertarNo(Arena* arena, TipoNo tipo, void* no);
+int DestruirArena(Arena* arena);
+Arena* ArenaDoGrafo(Grafo* grafo);
+int EstatisticasDoGrafo(const Grafo* grafo, EstatisticasArena* estatisticas);
+#pragma endregion
+
+#pragma region FuncoesIndiceEspacial
+/**
+ * Funes do ndice espacial das antenas.
+ */
+int IndexarAntena(Grafo* grafo, Antena* antena);
+Antena* ProcurarNoIndice(const Grafo* grafo, int coluna, int linha);
+int DesindexarAntena(Grafo* grafo, int coluna, int linha);
+int LibertarIndice(IndiceEspacial* indice);
+#pragma endregion
+
+#pragma region FuncoesCarregamento
+/**
+ * Funes de leitura de ficheiros de antenas mapeados em memria.
+ */
+double TempoAtual(void);
+int MapearFicheiro(const char* nomeFicheiro, FicheiroMapeado* mapa);
+int DesmapearFicheiro(FicheiroMapeado* mapa);
+int AcrescentarAoLote(LoteAntenas* lote, char freq, int coluna, int linha);
+int LibertarLote(LoteAntenas* lote);
+int AnalisarGrelha(const char* dados, size_t tamanho, int linhaInicial, int maxLinhas, int maxColunas, LoteAntenas* lote);
+long long LerCabecalhoGrelha(const char* dados, size_t tamanho, int* numLinhas, int* numColunas);
+int LerGrelhaAntenas(const char* nomeFicheiro, int numThreads, LoteAntenas* lote, EstatisticasCarregamento* estatisticas);
+void AlargarGrelha(Grafo* grafo, int largura, int altura);
+int CarregarAntenasParalelo(Grafo* grafo, const char* nomeFicheiro, int numThreads, EstatisticasCarregamento* estatisticas);
+int CarregarAntenasMapeado(Grafo* grafo, const char* nomeFicheiro, EstatisticasCarregamento* estatisticas);
+#pragma endregion
+
+#pragma region FuncoesIntersecoes
+/**
+ * Funes para enumerar as intersees entre antenas de frequncias diferentes.
+ */
+int ConstruirIndiceIntersecoes(Grafo* grafo, IndiceIntersecoes* indice);
+int LibertarIndiceIntersecoes(IndiceIntersecoes* indice);
+int PercorrerIntersecoesPar(const IndiceIntersecoes* indice, char freqA, char freqB, VisitanteIntersecao visitante, void* contexto);
+int PercorrerTodasIntersecoes(const IndiceIntersecoes* indice, VisitanteIntersecao visitante, void* contexto);
+int EscreverIntersecao(const Antena* antenaA, const Antena* antenaB, void* contexto);
+int EscreverIntersecoesPar(const IndiceIntersecoes* indice, char freqA, char freqB, FILE* saida);
+int EscreverTodasIntersecoes(const IndiceIntersecoes* indice, FILE* saida);
+int MostrarTodasIntersecoes(Grafo* grafo, FILE* saida);
+#pragma endregion
+
+#pragma region FuncoesBufferTexto
+/**
+ * Funes do buffer de texto.
+ */
+char* FormatarInteiro(char* fim, long long valor);
+char* FormatarCoordenada(char* fim, int coluna, int linha);
+int GarantirEspaco(BufferTexto* buffer, size_t extra);
+int AcrescentarTexto(BufferTexto* buffer, const char* texto, size_t tamanho);
+int AcrescentarCaracter(BufferTexto* buffer, char c);
+int AcrescentarInteiro(BufferTexto* buffer, long long valor);
+int EscreverBuffer(const BufferTexto* buffer, FILE* saida);
+int LibertarBuffer(BufferTexto* buffer);
+#pragma endregion
+
+#pragma region FuncoesEscritorTexto
+/**
+ * Funes do escritor de resultados.
+ */
+int IniciarEscritor(EscritorTexto* escritor, FILE* saida);
+int IniciarEscritorMemoria(EscritorTexto* escritor, BufferTexto* memoria);
+int DescarregarEscritor(EscritorTexto* escritor);
+int EscreverBytes(EscritorTexto* escritor, const char* texto, size_t tamanho);
+int EscreverTexto(EscritorTexto* escritor, const char* texto);
+int EscreverCaracter(EscritorTexto* escritor, char c);
+int EscreverInteiro(EscritorTexto* escritor, long long valor);
+int EscreverCoordenada(EscritorTexto* escritor, int coluna, int linha);
+#pragma endregion
+
+#pragma region FuncoesVetoresAntenas
+/**
+ * Funes para guardar as antenas por campos e comparar coordenadas em blocos (SIMD).
+ */
+int ConstruirVetoresAntenas(const Grafo* grafo, VetoresAntenas* vetores);
+int LibertarVetoresAntenas(VetoresAntenas* vetores);
+int AntenasAlinhadas(Coordenada coluna, Coordenada linha, const Coordenada* colunas, const Coordenada* linhas,
+    int total, Alinhamento alinhamento, int* indices);
+const char* InstrucoesVetoriais(void);
+#pragma endregion
+
+#pragma region FuncoesArvoreEspacial
+/**
+ * Funes da rvore espacial e das consultas por zona (frequencia 0 para todas as frequncias).
+ */
+int ConstruirArvoreEspacial(Grafo* grafo);
+int LibertarArvoreEspacial(Grafo* grafo);
+int InserirNaArvore(Grafo* grafo, Antena* antena);
+int RetirarDaArvore(Grafo* grafo, const Antena* antena);
+int ProcurarNoRetangulo(Grafo* grafo, int colunaMin, int linhaMin, int colunaMax, int linhaMax, char frequencia, AntenasEncontradas* encontradas);
+int ProcurarNoRaio(Grafo* grafo, int coluna, int linha, double raio, char frequencia, AntenasEncontradas* encontradas);
+int ProcurarMaisProximas(Grafo* grafo, int coluna, int linha, int k, char frequencia, AntenasEncontradas* encontradas);
+int LibertarEncontradas(AntenasEncontradas* encontradas);
+#pragma endregion
+
+#pragma region FuncoesInterferencias
+/**
+ * Funes para calcular os pontos de interferncia.
+ */
+long long EscreverPontosInterferencia(Grafo* grafo, const OpcoesInterferencias* opcoes, FILE* saida);
+long long EscreverPontosInterferenciaEscritor(Grafo* grafo, const OpcoesInterferencias* opcoes, EscritorTexto* escritor);
+long long PercorrerPontosInterferencia(Grafo* grafo, const OpcoesInterferencias* opcoes, VisitantePonto visitante, void* contexto);
+int MostrarInterferenciasOpcoes(Grafo* grafo, const OpcoesInterferencias* opcoes, FILE* saida);
+long long CalcularMapaInterferencias(Grafo* grafo, const OpcoesInterferencias* opcoes, bool guardarCelulas, MapaInterferencias* mapa);
+bool CelulaAfetada(const MapaInterferencias* mapa, int coluna, int linha);
+int EscreverMapaInterferencias(const MapaInterferencias* mapa, FILE* saida);
+int LibertarMapaInterferencias(MapaInterferencias* mapa);
+#pragma endregion
+
+#pragma region FuncoesCaminhos
+/**
+ * Funes para procurar caminhos entre antenas.
+ */
+int ProcurarCaminhos(Grafo* grafo, Antena* origem, Antena* destino, const ConsultaCaminhos* consulta, ResultadoCaminhos* resultado);
+#pragma endregion
+
+#pragma region FuncoesTravessias
+/**
+ * Funes de travessia com marcas de visita externas (vrias travessias em simultneo).
+ */
+int CriarVisitados(Visitados* visitados, int capacidade);
+int NovaTravessia(Visitados* visitados, const Grafo* grafo);
+bool MarcarVisitada(Visitados* visitados, const Antena* antena);
+int LibertarVisitados(Visitados* visitados);
+int PercorrerEmProfundidadeVisitante(const Grafo* grafo, Antena* inicio, Visitados* visitados, VisitanteAntena visitante, void* contexto);
+int EscreverAntenaVisitada(Antena* antena, int profundidade, void* contexto);
+int PercorrerEmProfundidade(const Grafo* grafo, Antena* inicio, Visitados* visitados, FILE* saida);
+int PercorrerEmLarguraVisitante(const Grafo* grafo, Antena* inicio, Visitados* visitados, VisitanteAntena visitante, void* contexto);
+int PercorrerEmLargura(const Grafo* grafo, Antena* inicio, Visitados* visitados, FILE* saida);
+int NiveisEmLargura(const Grafo* grafo, Antena* inicio, ModoLargura modo, int* nivel, int* pai, ResultadoLargura* resultado);
+#pragma endregion
+
+#pragma region FuncoesComponentes
+/**
+ * Funes das componentes fracamente ligadas do grafo.
+ */
+int RotularComponentes(Grafo* grafo);
+int LibertarComponentes(Grafo* grafo);
+int AtualizarComponentesAntena(Grafo* grafo, const Antena* antena, int variacao);
+int AtualizarComponentesLigacao(Grafo* grafo, const Antena* origem, const Antena* destino, int variacao);
+int TotalComponentes(const Grafo* grafo);
+int ComponenteDe(const Grafo* grafo, const Antena* antena);
+int TamanhoComponente(const Grafo* grafo, int componente);
+int FrequenciasComponente(const Grafo* grafo, int componente);
+bool ComponenteTemFrequencia(const Grafo* grafo, int componente, char freq);
+bool MesmaComponenteFraca(const Grafo* grafo, const Antena* a, const Antena* b);
+#pragma endregion
+
+#pragma region FuncoesAlteracoes
+/**
+ * Funes para aplicar muitas alteraes ao grafo de uma s vez.
+ */
+int AplicarAlteracoes(Grafo* grafo, const Alteracao* alteracoes, int total, int* estados);
+#pragma endregion
+
+#pragma region FuncoesExportacao
+/**
+ * Funes para exportar os resultados em formatos para outros programas.
+ */
+int ExportarResultados(Grafo* grafo, const OpcoesExportacao* opcoes);
+#pragma endregion
+
+#pragma region FuncoesMedicao
+/**
+ * Funes para medir o tempo e a memria gastos em cada fase.
+ */
+double TempoCPU(void);
+size_t PicoMemoria(void);
+int IniciarMedicao(Medicao* medicao);
+int TerminarMedicao(const Medicao* inicio, Medicao* fase);
+#pragma endregion
+
+#pragma region FuncoesInstrumentacao
+/**
+ * Funes da instrumentao: contadores e intervalos de tempo exportados para o formato
+ * de trace do Chrome. Sem INSTRUMENTACAO no registam nada e devolvem -1.
+ */
+bool InstrumentacaoAtiva(void);
+void ContarInstrumentacao(ContadorInstrumentacao contador, long long quantidade);
+int AbrirSpan(const char* nome);
+void FecharSpan(int span);
+const char* NomeContador(ContadorInstrumentacao contador);
+int LerContadores(long long* valores);
+int ReiniciarInstrumentacao(void);
+int ExportarTrace(const char* nomeFicheiro);
+#pragma endregion
+
+#pragma region FuncoesParalelo
+/**
+ * Funes para executar tarefas independentes em vrias threads.
+ */
+int NumeroProcessadores(void);
+int ExecutarEmParalelo(int totalTarefas, int numThreads, TarefaParalela tarefa, void* contexto);
+#pragma endregion
+
+#pragma region FuncoesGrafoCSR
+/**
+ * Funes para construir e analisar a cpia compacta (CSR) de um grafo.
+ * MostrarIntersecoesCSR e MostrarInterferenciasCSR so referncias O(n^2) do benchmark.
+ */
+int ConstruirGrafoCSR(Grafo* grafo, GrafoCSR* csr);
+int LibertarGrafoCSR(GrafoCSR* csr);
+int TravessiaEmProfundidadeCSR(const GrafoCSR* csr, int inicio, FILE* saida);
+int TravessiaEmLarguraCSR(const GrafoCSR* csr, int inicio, FILE* saida);
+int EncontrarCaminhosCSR(const GrafoCSR* csr, int origem, int destino, FILE* saida);
+int MostrarIntersecoesCSR(const GrafoCSR* csr, char freqA, char freqB, FILE* saida);
+int MostrarInterferenciasCSR(const GrafoCSR* csr, FILE* saida);
+int ReconstruirGrafo(const GrafoCSR* csr, Grafo* grafo);
+#pragma endregion
+
+#pragma region FuncoesGrafoBinario
+/**
+ * Funes para gravar e abrir grafos no formato binrio.
+ */
+int GuardarGrafoCSRBinario(const GrafoCSR* csr, const char* nomeFicheiro);
+int GuardarGrafoBinario(Grafo* grafo, const char* nomeFicheiro);
+int AbrirGrafoBinario(const char* nomeFicheiro, GrafoBinario* binario, bool validar);
+int FecharGrafoBinario(GrafoBinario* binario);
 #pragma endregion
 
 #endif // FUNCOES_H
@@ -0,0 +1,183 @@
+/*****************************************************************//**
+ * \file   arena.c
+ * \brief  Alocador por blocos (arena) para os ns do grafo de antenas.
+ *
+ * Os ns so cortados de blocos grandes e os que so libertados voltam a uma
+ * lista de livres do seu tipo, para serem reutilizados. Libertar o grafo
+ *  apenas devolver os blocos, sem percorrer as listas n a n.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "antenas.h"
+
+#define TAMANHO_BLOCO_INICIAL (64 * 1024)
+#define TAMANHO_BLOCO_MAXIMO (4 * 1024 * 1024)
+#define ALINHAMENTO_ARENA sizeof(void*)
+
+#ifdef INSTRUMENTACAO
+//Contador das alocaes de cada tipo de n
+static const ContadorInstrumentacao CONTADORES_ALOCACOES[NUM_TIPOS_NO] = {
+    [NO_ANTENA] = CONTADOR_ALOCACOES_ANTENA,
+    [NO_ADJACENCIA] = CONTADOR_ALOCACOES_ADJACENCIA
+};
+#endif
+
+#pragma region TamanhoNo
+/**
+ * Tamanho (j alinhado) de cada tipo de n.
+ */
+static size_t TamanhoNo(TipoNo tipo) {
+    size_t tamanho;
+    switch (tipo) {
+    case NO_ANTENA:     tamanho = sizeof(Antena); break;
+    case NO_ADJACENCIA: tamanho = sizeof(Adjacencia); break;
+    default:            return 0;
+    }
+    return (tamanho + ALINHAMENTO_ARENA - 1) & ~(size_t)(ALINHAMENTO_ARENA - 1);
+}
+#pragma endregion
+
+#pragma region CriarArena
+/**
+ * Funo para criar uma arena vazia (os blocos s so reservados quando forem precisos).
+ *
+ * @param arena --> Apontador para a nova arena.
+ * @return Apontador para a arena ou NULL se falhar a alocao.
+ */
+Arena* CriarArena(void) {
+    return calloc(1, sizeof(Arena));
+}
+#pragma endregion
+
+#pragma region AlocarNo
+/**
+ * Funo para obter um n de um determinado tipo a partir da arena.
+ * Reutiliza primeiro um n libertado do mesmo tipo; se no houver, corta-o do bloco atual
+ * e, quando o bloco acaba, reserva um novo com o dobro do tamanho (at TAMANHO_BLOCO_MAXIMO).
+ *
+ * @param arena --> Apontador para a arena.
+ * @param tipo --> Tipo de n a alocar.
+ * @param bloco --> Apontador para o bloco de onde o n  cortado.
+ * @return Apontador para o n (com o contedo por inicializar) ou NULL se falhar a alocao.
+ */
+void* AlocarNo(Arena* arena, TipoNo tipo) {
+    size_t tamanho = TamanhoNo(tipo);
+    if (!arena || tamanho == 0) return NULL;
+    CONTAR(CONTADORES_ALOCACOES[tipo], 1);
+
+    //Reutiliza um n livre do mesmo tipo
+    NoLivre* livre = arena->livres[tipo];
+    if (livre) {
+        arena->livres[tipo] = livre->proximo;
+        arena->nosEmUso[tipo]++;
+        return livre;
+    }
+
+    //Se o bloco atual no tiver espao, reserva um novo
+    BlocoArena* bloco = arena->blocos;
+    if (!bloco || bloco->usado + tamanho > bloco->tamanho) {
+        size_t tamanhoBloco = bloco ? bloco->tamanho * 2 : TAMANHO_BLOCO_INICIAL;
+        if (tamanhoBloco > TAMANHO_BLOCO_MAXIMO) tamanhoBloco = TAMANHO_BLOCO_MAXIMO;
+
+        BlocoArena* novo = malloc(sizeof(BlocoArena) + tamanhoBloco);
+        if (!novo) return NULL;
+        novo->tamanho = tamanhoBloco;
+        novo->usado = 0;
+        novo->proximo = arena->blocos;
+        arena->blocos = novo;
+        arena->bytesReservados += tamanhoBloco;
+        bloco = novo;
+    }
+
+    void* no = bloco->dados + bloco->usado;
+    bloco->usado += tamanho;
+    arena->bytesUsados += tamanho;
+    arena->nosEmUso[tipo]++;
+    arena->nosAlocados[tipo]++;
+    return no;
+}
+#pragma endregion
+
+#pragma region LibertarNo
+/**
+ * Funo para devolver um n  arena. O n passa para a lista de livres do seu tipo.
+ *
+ * @param arena --> Apontador para a arena.
+ * @param tipo --> Tipo do n.
+ * @param no --> Apontador para o n a devolver.
+ * @param return --> 0 se o n foi devolvido, -1 se os argumentos forem invlidos.
+ */
+int LibertarNo(Arena* arena, TipoNo tipo, void* no) {
+    if (!arena || !no || TamanhoNo(tipo) == 0) return -1;
+
+    NoLivre* livre = no;
+    livre->proximo = arena->livres[tipo];
+    arena->livres[tipo] = livre;
+    arena->nosEmUso[tipo]--;
+    return 0;
+}
+#pragma endregion
+
+#pragma region DestruirArena
+/**
+ * Funo para libertar todos os blocos de uma arena de uma s vez.
+ *
+ * @param arena --> Apontador para a arena.
+ * @param bloco --> Apontador para o bloco a libertar.
+ * @param return --> 0 se a arena foi destruda, -1 se for nula.
+ */
+int DestruirArena(Arena* arena) {
+    if (!arena) return -1;
+
+    BlocoArena* bloco = arena->blocos;
+    while (bloco) {
+        BlocoArena* temp = bloco;
+        bloco = bloco->proximo;
+        free(temp);
+    }
+    free(arena);
+    return 0;
+}
+#pragma endregion
+
+#pragma region ArenaDoGrafo
+/**
+ * Funo para obter a arena de um grafo, criando-a na primeira utilizao.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @return Apontador para a arena do grafo ou NULL se no for possvel cri-la.
+ */
+Arena* ArenaDoGrafo(Grafo* grafo) {
+    if (!grafo) return NULL;
+    if (!grafo->arena) grafo->arena = CriarArena();
+    return grafo->arena;
+}
+#pragma endregion
+
+#pragma region EstatisticasDoGrafo
+/**
+ * Funo para obter as estatsticas de memria do alocador de um grafo.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param estatisticas --> Apontador para a estrutura a preencher.
+ * @param return --> 0 se as estatsticas foram preenchidas, -1 se os argumentos forem nulos.
+ */
+int EstatisticasDoGrafo(const Grafo* grafo, EstatisticasArena* estatisticas) {
+    if (!grafo || !estatisticas) return -1;
+    memset(estatisticas, 0, sizeof(EstatisticasArena));
+    if (!grafo->arena) return 0;
+
+    estatisticas->bytesReservados = grafo->arena->bytesReservados;
+    estatisticas->bytesUsados = grafo->arena->bytesUsados;
+    for (int tipo = 0; tipo < NUM_TIPOS_NO; tipo++) {
+        estatisticas->nosEmUso[tipo] = grafo->arena->nosEmUso[tipo];
+        estatisticas->nosAlocados[tipo] = grafo->arena->nosAlocados[tipo];
+    }
+    for (BlocoArena* bloco = grafo->arena->blocos; bloco != NULL; bloco = bloco->proximo) {
+        estatisticas->totalBlocos++;
+    }
+    return 0;
+}
+#pragma endregion
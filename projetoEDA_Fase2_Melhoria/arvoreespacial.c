@@ -0,0 +1,638 @@
+/*****************************************************************//**
+ * \file   arvoreespacial.c
+ * \brief  rvore espacial (quadtree de pontos) das antenas e consultas por retngulo, raio e vizinhas.
+ *
+ * Cada n cobre um quadrado de lado potncia de 2; as folhas guardam at CAPACIDADE_FOLHA
+ * antenas e dividem-se em quatro quadrantes quando enchem. Como as coordenadas so inteiras,
+ * a profundidade nunca passa de 33 nveis, sem ser preciso reequilibrar. Cada n sabe quantas
+ * antenas tem e que frequncias aparecem na sua subrvore, por isso as consultas s descem
+ * aos ns que podem ter antenas da zona (e da frequncia) pedida: o custo  a altura da rvore
+ * mais o nmero de antenas encontradas.
+ *
+ * A rvore  construda na primeira consulta e depois mantida por AdicionarAoBalde e
+ * RemoverDoBalde, por onde passam todas as inseres e remoes de antenas
+ * (adicionarAntenaOrdenado, removerAntena, AplicarAlteracoes, ...).
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "antenas.h"
+
+#define CAPACIDADE_FOLHA 16
+
+static int InserirNo(ArvoreEspacial* arvore, NoArvore* no, Antena* antena);
+
+#pragma region Nos
+static NoArvore* CriarNo(ArvoreEspacial* arvore, long long coluna, long long linha, long long lado) {
+    NoArvore* no = calloc(1, sizeof(NoArvore));
+    if (!no) return NULL;
+    no->coluna = coluna;
+    no->linha = linha;
+    no->lado = lado;
+    no->folha = true;
+    arvore->totalNos++;
+    return no;
+}
+
+static void LibertarNoArvore(ArvoreEspacial* arvore, NoArvore* no) {
+    if (!no) return;
+    for (int q = 0; q < 4; q++) LibertarNoArvore(arvore, no->filhos[q]);
+    free(no->antenas);
+    free(no);
+    arvore->totalNos--;
+}
+
+static bool ContemPonto(const NoArvore* no, long long coluna, long long linha) {
+    return coluna >= no->coluna && coluna < no->coluna + no->lado && linha >= no->linha && linha < no->linha + no->lado;
+}
+
+/**
+ * Quadrante do n onde fica (coluna, linha): bit 0 para a metade alta das colunas, bit 1 para a das linhas.
+ */
+static int Quadrante(const NoArvore* no, long long coluna, long long linha) {
+    long long metade = no->lado / 2;
+    return (coluna >= no->coluna + metade ? 1 : 0) + (linha >= no->linha + metade ? 2 : 0);
+}
+
+static void MarcarFrequencia(unsigned int* frequencias, char frequencia) {
+    unsigned char f = (unsigned char)frequencia;
+    frequencias[f / 32] |= 1u << (f % 32);
+}
+
+/**
+ * Verdadeiro se a subrvore tem antenas da frequncia (ou de qualquer uma, com frequencia 0).
+ */
+static bool TemFrequencia(const NoArvore* no, char frequencia) {
+    unsigned char f = (unsigned char)frequencia;
+    return no->contagem > 0 && (f == 0 || ((no->frequencias[f / 32] >> (f % 32)) & 1));
+}
+
+/**
+ * Refaz as frequncias de um n a partir das suas antenas (folha) ou dos filhos.
+ */
+static void RefazerFrequencias(NoArvore* no) {
+    memset(no->frequencias, 0, sizeof(no->frequencias));
+    if (no->folha) {
+        for (int i = 0; i < no->total; i++) MarcarFrequencia(no->frequencias, no->antenas[i]->frequencia);
+        return;
+    }
+    for (int q = 0; q < 4; q++) {
+        if (!no->filhos[q]) continue;
+        for (int p = 0; p < PALAVRAS_FREQUENCIAS; p++) no->frequencias[p] |= no->filhos[q]->frequencias[p];
+    }
+}
+#pragma endregion
+
+#pragma region Insercao
+static int AcrescentarNaFolha(NoArvore* no, Antena* antena) {
+    if (no->total == no->capacidade) {
+        int novaCapacidade = no->capacidade ? no->capacidade * 2 : CAPACIDADE_FOLHA;
+        Antena** novas = realloc(no->antenas, novaCapacidade * sizeof(Antena*));
+        if (!novas) return -2;
+        no->antenas = novas;
+        no->capacidade = novaCapacidade;
+    }
+    no->antenas[no->total++] = antena;
+    return 0;
+}
+
+static int InserirNoFilho(ArvoreEspacial* arvore, NoArvore* no, Antena* antena) {
+    int q = Quadrante(no, antena->coluna, antena->linha);
+    if (!no->filhos[q]) {
+        long long metade = no->lado / 2;
+        no->filhos[q] = CriarNo(arvore, no->coluna + (q & 1 ? metade : 0), no->linha + (q & 2 ? metade : 0), metade);
+        if (!no->filhos[q]) return -2;
+    }
+    return InserirNo(arvore, no->filhos[q], antena);
+}
+
+/**
+ * Insere uma antena na subrvore de no (que a contm). Uma folha cheia passa a n interior
+ * e as suas antenas descem para os quadrantes; as folhas de lado 1 nunca se dividem.
+ */
+static int InserirNo(ArvoreEspacial* arvore, NoArvore* no, Antena* antena) {
+    no->contagem++;
+    MarcarFrequencia(no->frequencias, antena->frequencia);
+    if (no->folha) {
+        if (no->total < CAPACIDADE_FOLHA || no->lado == 1) return AcrescentarNaFolha(no, antena);
+
+        Antena** antigas = no->antenas;
+        int totalAntigas = no->total;
+        no->antenas = NULL;
+        no->total = 0;
+        no->capacidade = 0;
+        no->folha = false;
+        int resultado = 0;
+        for (int i = 0; i < totalAntigas && resultado == 0; i++) resultado = InserirNoFilho(arvore, no, antigas[i]);
+        free(antigas);
+        if (resultado != 0) return resultado;
+    }
+    return InserirNoFilho(arvore, no, antena);
+}
+
+/**
+ * Cria uma raiz com o dobro do lado, com a raiz atual num dos quadrantes, crescendo
+ * para o lado de (coluna, linha).
+ */
+static int CrescerRaiz(ArvoreEspacial* arvore, long long coluna, long long linha) {
+    NoArvore* antiga = arvore->raiz;
+    long long novaColuna = coluna < antiga->coluna ? antiga->coluna - antiga->lado : antiga->coluna;
+    long long novaLinha = linha < antiga->linha ? antiga->linha - antiga->lado : antiga->linha;
+    NoArvore* raiz = CriarNo(arvore, novaColuna, novaLinha, antiga->lado * 2);
+    if (!raiz) return -2;
+
+    raiz->folha = false;
+    raiz->filhos[Quadrante(raiz, antiga->coluna, antiga->linha)] = antiga;
+    raiz->contagem = antiga->contagem;
+    memcpy(raiz->frequencias, antiga->frequencias, sizeof(raiz->frequencias));
+    arvore->raiz = raiz;
+    return 0;
+}
+
+/**
+ * Insere uma antena na rvore, criando a raiz ou fazendo-a crescer se a antena ficar fora dela.
+ */
+static int InserirNaRaiz(ArvoreEspacial* arvore, Antena* antena) {
+    if (!arvore->raiz) {
+        arvore->raiz = CriarNo(arvore, antena->coluna, antena->linha, 1);
+        if (!arvore->raiz) return -2;
+    }
+    while (!ContemPonto(arvore->raiz, antena->coluna, antena->linha)) {
+        if (CrescerRaiz(arvore, antena->coluna, antena->linha) != 0) return -2;
+    }
+    return InserirNo(arvore, arvore->raiz, antena);
+}
+#pragma endregion
+
+#pragma region Remocao
+/**
+ * Copia para antenas todas as antenas da subrvore de no.
+ */
+static void RecolherAntenas(const NoArvore* no, Antena** antenas, int* total) {
+    if (no->folha) {
+        memcpy(antenas + *total, no->antenas, no->total * sizeof(Antena*));
+        *total += no->total;
+        return;
+    }
+    for (int q = 0; q < 4; q++) {
+        if (no->filhos[q]) RecolherAntenas(no->filhos[q], antenas, total);
+    }
+}
+
+/**
+ * Junta numa s folha as antenas de um n interior com poucas antenas.
+ * Se a alocao falhar o n fica como est, que continua a ser uma rvore vlida.
+ */
+static void JuntarFilhos(ArvoreEspacial* arvore, NoArvore* no) {
+    Antena** antenas = malloc(CAPACIDADE_FOLHA * sizeof(Antena*));
+    if (!antenas) return;
+
+    int total = 0;
+    RecolherAntenas(no, antenas, &total);
+    for (int q = 0; q < 4; q++) {
+        LibertarNoArvore(arvore, no->filhos[q]);
+        no->filhos[q] = NULL;
+    }
+    no->folha = true;
+    no->antenas = antenas;
+    no->total = total;
+    no->capacidade = CAPACIDADE_FOLHA;
+}
+
+/**
+ * Retira uma antena da subrvore de no. Os quadrantes que ficam vazios so libertados e um
+ * n interior com metade de uma folha de antenas volta a ser folha.
+ * Devolve verdadeiro se a antena estava na subrvore.
+ */
+static bool RetirarNo(ArvoreEspacial* arvore, NoArvore* no, const Antena* antena) {
+    if (no->folha) {
+        int i = 0;
+        while (i < no->total && no->antenas[i] != antena) i++;
+        if (i == no->total) return false;
+        no->antenas[i] = no->antenas[--no->total];
+    }
+    else {
+        int q = Quadrante(no, antena->coluna, antena->linha);
+        NoArvore* filho = no->filhos[q];
+        if (!filho || !RetirarNo(arvore, filho, antena)) return false;
+        if (filho->contagem == 0) {
+            LibertarNoArvore(arvore, filho);
+            no->filhos[q] = NULL;
+        }
+    }
+
+    no->contagem--;
+    if (!no->folha && no->contagem <= CAPACIDADE_FOLHA / 2) JuntarFilhos(arvore, no);
+    RefazerFrequencias(no);
+    return true;
+}
+#pragma endregion
+
+#pragma region ConstruirArvoreEspacial
+/**
+ * Funo para construir a rvore espacial com todas as antenas do grafo (substitui a que houver).
+ * A raiz comea com o menor quadrado que cobre a grelha e as antenas, para a rvore no ter
+ * nveis a mais; depois disso a rvore  mantida a cada antena inserida ou removida.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param arvore --> rvore a construir.
+ * @param minColuna, minLinha, maxColuna, maxLinha --> Limites da grelha e das antenas.
+ * @param lado --> Lado da raiz.
+ * @param return --> Nmero de antenas na rvore, -1 se o grafo for nulo, -2 se falhar a alocao.
+ */
+int ConstruirArvoreEspacial(Grafo* grafo) {
+    if (!grafo) return -1;
+    LibertarArvoreEspacial(grafo);
+
+    ArvoreEspacial* arvore = calloc(1, sizeof(ArvoreEspacial));
+    if (!arvore) return -2;
+
+    long long minColuna = 0, minLinha = 0;
+    long long maxColuna = grafo->largura > 0 ? grafo->largura - 1 : 0;
+    long long maxLinha = grafo->altura > 0 ? grafo->altura - 1 : 0;
+    for (const Antena* a = grafo->antenas; a != NULL; a = a->proxima) {
+        if (a->coluna < minColuna) minColuna = a->coluna;
+        if (a->coluna > maxColuna) maxColuna = a->coluna;
+        if (a->linha < minLinha) minLinha = a->linha;
+        if (a->linha > maxLinha) maxLinha = a->linha;
+    }
+    long long lado = 1;
+    while (lado <= maxColuna - minColuna || lado <= maxLinha - minLinha) lado *= 2;
+
+    int resultado = 0;
+    if (grafo->antenas) {
+        arvore->raiz = CriarNo(arvore, minColuna, minLinha, lado);
+        if (!arvore->raiz) resultado = -2;
+    }
+    for (Antena* a = grafo->antenas; a != NULL && resultado == 0; a = a->proxima) {
+        resultado = InserirNaRaiz(arvore, a);
+    }
+
+    if (resultado != 0) {
+        LibertarNoArvore(arvore, arvore->raiz);
+        free(arvore);
+        return resultado;
+    }
+    grafo->arvore = arvore;
+    return arvore->raiz ? arvore->raiz->contagem : 0;
+}
+#pragma endregion
+
+#pragma region LibertarArvoreEspacial
+/**
+ * Funo para descartar a rvore espacial do grafo (deixa de ser mantida at  prxima consulta).
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param return --> 0 se foi descartada, -1 se o grafo for nulo.
+ */
+int LibertarArvoreEspacial(Grafo* grafo) {
+    if (!grafo) return -1;
+    if (!grafo->arvore) return 0;
+
+    LibertarNoArvore(grafo->arvore, grafo->arvore->raiz);
+    free(grafo->arvore);
+    grafo->arvore = NULL;
+    return 0;
+}
+#pragma endregion
+
+#pragma region AtualizarArvoreEspacial
+/**
+ * Funo para acrescentar  rvore uma antena que entrou no grafo (chamada por AdicionarAoBalde).
+ * Se faltar memria a rvore  descartada, e volta a ser construda na prxima consulta,
+ * por isso nunca fica uma rvore sem todas as antenas do grafo.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param antena --> Antena inserida.
+ * @param return --> 0 se foi inserida (ou a rvore no existe), -1 se os argumentos forem nulos,
+ *                   -2 se falhar a alocao (a rvore foi descartada).
+ */
+int InserirNaArvore(Grafo* grafo, Antena* antena) {
+    if (!grafo || !antena) return -1;
+    if (!grafo->arvore) return 0;
+
+    if (InserirNaRaiz(grafo->arvore, antena) != 0) {
+        LibertarArvoreEspacial(grafo);
+        return -2;
+    }
+    return 0;
+}
+
+/**
+ * Funo para retirar da rvore uma antena que vai sair do grafo (chamada por RemoverDoBalde,
+ * antes de a antena ser libertada).
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param antena --> Antena removida.
+ * @param raiz --> Raiz da rvore.
+ * @param return --> 0 se foi retirada (ou a rvore no existe), -1 se os argumentos forem nulos,
+ *                   -3 se a antena no estiver na rvore.
+ */
+int RetirarDaArvore(Grafo* grafo, const Antena* antena) {
+    if (!grafo || !antena) return -1;
+    if (!grafo->arvore) return 0;
+
+    NoArvore* raiz = grafo->arvore->raiz;
+    if (!raiz || !ContemPonto(raiz, antena->coluna, antena->linha) || !RetirarNo(grafo->arvore, raiz, antena)) return -3;
+    if (raiz->contagem == 0) {
+        LibertarNoArvore(grafo->arvore, raiz);
+        grafo->arvore->raiz = NULL;
+    }
+    return 0;
+}
+#pragma endregion
+
+#pragma region Encontradas
+static int GarantirEncontradas(AntenasEncontradas* encontradas, int total) {
+    if (total <= encontradas->capacidade) return 0;
+    int novaCapacidade = encontradas->capacidade ? encontradas->capacidade : 64;
+    while (novaCapacidade < total) novaCapacidade *= 2;
+    Antena** novas = realloc(encontradas->antenas, novaCapacidade * sizeof(Antena*));
+    if (!novas) return -2;
+    encontradas->antenas = novas;
+    encontradas->capacidade = novaCapacidade;
+    return 0;
+}
+
+static int AcrescentarEncontrada(AntenasEncontradas* encontradas, Antena* antena) {
+    if (GarantirEncontradas(encontradas, encontradas->total + 1) != 0) return -2;
+    encontradas->antenas[encontradas->total++] = antena;
+    return 0;
+}
+
+/**
+ * Ordem das antenas encontradas: por linha, depois por coluna e depois por id.
+ */
+static int CompararPosicao(const void* a, const void* b) {
+    const Antena* x = *(Antena* const*)a;
+    const Antena* y = *(Antena* const*)b;
+    if (x->linha != y->linha) return x->linha < y->linha ? -1 : 1;
+    if (x->coluna != y->coluna) return x->coluna < y->coluna ? -1 : 1;
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+/**
+ * Prepara uma consulta: constri a rvore se ainda no existir e esvazia as encontradas.
+ */
+static int IniciarConsulta(Grafo* grafo, AntenasEncontradas* encontradas) {
+    encontradas->total = 0;
+    if (!grafo->arvore && ConstruirArvoreEspacial(grafo) < 0) return -2;
+    return 0;
+}
+
+/**
+ * Funo para libertar as antenas encontradas por uma consulta.
+ *
+ * @param encontradas --> Resultado a libertar (fica vazio).
+ * @param return --> 0, ou -1 se o apontador for nulo.
+ */
+int LibertarEncontradas(AntenasEncontradas* encontradas) {
+    if (!encontradas) return -1;
+    free(encontradas->antenas);
+    encontradas->antenas = NULL;
+    encontradas->total = 0;
+    encontradas->capacidade = 0;
+    return 0;
+}
+#pragma endregion
+
+#pragma region ProcurarNoRetangulo
+static int ProcurarRetanguloNo(const NoArvore* no, int colunaMin, int linhaMin, int colunaMax, int linhaMax,
+    char frequencia, AntenasEncontradas* encontradas) {
+    if (!no || !TemFrequencia(no, frequencia)) return 0;
+    if (no->coluna > colunaMax || no->coluna + no->lado <= colunaMin ||
+        no->linha > linhaMax || no->linha + no->lado <= linhaMin) return 0;
+
+    if (no->folha) {
+        for (int i = 0; i < no->total; i++) {
+            Antena* a = no->antenas[i];
+            if (frequencia && a->frequencia != frequencia) continue;
+            if (a->coluna < colunaMin || a->coluna > colunaMax || a->linha < linhaMin || a->linha > linhaMax) continue;
+            if (AcrescentarEncontrada(encontradas, a) != 0) return -2;
+        }
+        return 0;
+    }
+    for (int q = 0; q < 4; q++) {
+        if (ProcurarRetanguloNo(no->filhos[q], colunaMin, linhaMin, colunaMax, linhaMax, frequencia, encontradas) != 0) return -2;
+    }
+    return 0;
+}
+
+/**
+ * Funo para encontrar as antenas dentro de um retngulo (limites includos).
+ *
+ * @param grafo --> Apontador para o grafo (a rvore  construda se ainda no existir).
+ * @param colunaMin, linhaMin --> Canto do retngulo com a menor coluna e a menor linha.
+ * @param colunaMax, linhaMax --> Canto oposto.
+ * @param frequencia --> S as antenas desta frequncia, ou 0 para todas.
+ * @param encontradas --> Onde ficam as antenas, por linha e coluna (o contedo anterior  substitudo).
+ * @param return --> Nmero de antenas encontradas, -1 se os argumentos forem nulos, -2 se falhar a alocao.
+ */
+int ProcurarNoRetangulo(Grafo* grafo, int colunaMin, int linhaMin, int colunaMax, int linhaMax, char frequencia, AntenasEncontradas* encontradas) {
+    if (!grafo || !encontradas) return -1;
+    if (IniciarConsulta(grafo, encontradas) != 0) return -2;
+    if (ProcurarRetanguloNo(grafo->arvore->raiz, colunaMin, linhaMin, colunaMax, linhaMax, frequencia, encontradas) != 0) return -2;
+
+    if (encontradas->total > 1) qsort(encontradas->antenas, encontradas->total, sizeof(Antena*), CompararPosicao);
+    return encontradas->total;
+}
+#pragma endregion
+
+#pragma region ProcurarNoRaio
+/**
+ * Quadrado da menor distncia de (coluna, linha) a uma clula do n (0 se estiver dentro dele).
+ */
+static double DistanciaAoNo(const NoArvore* no, int coluna, int linha) {
+    double dx = 0, dy = 0;
+    if (coluna < no->coluna) dx = (double)(no->coluna - coluna);
+    else if (coluna > no->coluna + no->lado - 1) dx = (double)(coluna - (no->coluna + no->lado - 1));
+    if (linha < no->linha) dy = (double)(no->linha - linha);
+    else if (linha > no->linha + no->lado - 1) dy = (double)(linha - (no->linha + no->lado - 1));
+    return dx * dx + dy * dy;
+}
+
+static double DistanciaAntena(const Antena* antena, int coluna, int linha) {
+    double dx = (double)antena->coluna - coluna;
+    double dy = (double)antena->linha - linha;
+    return dx * dx + dy * dy;
+}
+
+static int ProcurarRaioNo(const NoArvore* no, int coluna, int linha, double raio2, char frequencia, AntenasEncontradas* encontradas) {
+    if (!no || !TemFrequencia(no, frequencia) || DistanciaAoNo(no, coluna, linha) > raio2) return 0;
+
+    if (no->folha) {
+        for (int i = 0; i < no->total; i++) {
+            Antena* a = no->antenas[i];
+            if (frequencia && a->frequencia != frequencia) continue;
+            if (DistanciaAntena(a, coluna, linha) > raio2) continue;
+            if (AcrescentarEncontrada(encontradas, a) != 0) return -2;
+        }
+        return 0;
+    }
+    for (int q = 0; q < 4; q++) {
+        if (ProcurarRaioNo(no->filhos[q], coluna, linha, raio2, frequencia, encontradas) != 0) return -2;
+    }
+    return 0;
+}
+
+/**
+ * Funo para encontrar as antenas a uma distncia (euclidiana) de (coluna, linha) menor ou igual a raio.
+ *
+ * @param grafo --> Apontador para o grafo (a rvore  construda se ainda no existir).
+ * @param coluna, linha --> Centro do crculo.
+ * @param raio --> Raio do crculo (um raio negativo no encontra nada).
+ * @param frequencia --> S as antenas desta frequncia, ou 0 para todas.
+ * @param encontradas --> Onde ficam as antenas, por linha e coluna (o contedo anterior  substitudo).
+ * @param return --> Nmero de antenas encontradas, -1 se os argumentos forem nulos, -2 se falhar a alocao.
+ */
+int ProcurarNoRaio(Grafo* grafo, int coluna, int linha, double raio, char frequencia, AntenasEncontradas* encontradas) {
+    if (!grafo || !encontradas) return -1;
+    if (IniciarConsulta(grafo, encontradas) != 0) return -2;
+    if (raio < 0) return 0;
+    if (ProcurarRaioNo(grafo->arvore->raiz, coluna, linha, raio * raio, frequencia, encontradas) != 0) return -2;
+
+    if (encontradas->total > 1) qsort(encontradas->antenas, encontradas->total, sizeof(Antena*), CompararPosicao);
+    return encontradas->total;
+}
+#pragma endregion
+
+#pragma region ProcurarMaisProximas
+/**
+ * Antena candidata a uma das k mais prximas.
+ * @param antena --> Antena.
+ * @param distancia --> Quadrado da distncia ao ponto da consulta.
+ */
+typedef struct Candidata {
+    Antena* antena;
+    double distancia;
+} Candidata;
+
+/**
+ * Estado da procura das k mais prximas: as melhores candidatas num monte de mximo,
+ * com a pior (a que sai primeiro) na raiz.
+ */
+typedef struct ProcuraVizinhas {
+    int coluna;
+    int linha;
+    char frequencia;
+    int k;
+    Candidata* monte;
+    int total;
+} ProcuraVizinhas;
+
+/**
+ * Verdadeiro se a vem antes de b: mais perto, ou  mesma distncia e antes por linha, coluna e id.
+ */
+static bool VemAntes(const Candidata* a, const Candidata* b) {
+    if (a->distancia != b->distancia) return a->distancia < b->distancia;
+    return CompararPosicao(&a->antena, &b->antena) < 0;
+}
+
+static void SubirNoMonte(Candidata* monte, int i) {
+    while (i > 0 && VemAntes(&monte[(i - 1) / 2], &monte[i])) {
+        Candidata troca = monte[i];
+        monte[i] = monte[(i - 1) / 2];
+        monte[(i - 1) / 2] = troca;
+        i = (i - 1) / 2;
+    }
+}
+
+static void DescerNoMonte(Candidata* monte, int total, int i) {
+    for (;;) {
+        int maior = i;
+        int e = 2 * i + 1, d = 2 * i + 2;
+        if (e < total && VemAntes(&monte[maior], &monte[e])) maior = e;
+        if (d < total && VemAntes(&monte[maior], &monte[d])) maior = d;
+        if (maior == i) return;
+        Candidata troca = monte[i];
+        monte[i] = monte[maior];
+        monte[maior] = troca;
+        i = maior;
+    }
+}
+
+static void ConsiderarAntena(ProcuraVizinhas* procura, Antena* antena) {
+    Candidata candidata = { antena, DistanciaAntena(antena, procura->coluna, procura->linha) };
+    if (procura->total < procura->k) {
+        procura->monte[procura->total] = candidata;
+        SubirNoMonte(procura->monte, procura->total++);
+    }
+    else if (VemAntes(&candidata, &procura->monte[0])) {
+        procura->monte[0] = candidata;
+        DescerNoMonte(procura->monte, procura->total, 0);
+    }
+}
+
+/**
+ * Percorre a subrvore comeando pelos quadrantes mais prximos e saltando os que j
+ * esto mais longe do que a pior das k candidatas.
+ */
+static void ProcurarVizinhasNo(ProcuraVizinhas* procura, const NoArvore* no) {
+    if (!no || !TemFrequencia(no, procura->frequencia)) return;
+    double distanciaNo = DistanciaAoNo(no, procura->coluna, procura->linha);
+    if (procura->total == procura->k && distanciaNo > procura->monte[0].distancia) return;
+
+    if (no->folha) {
+        for (int i = 0; i < no->total; i++) {
+            if (procura->frequencia && no->antenas[i]->frequencia != procura->frequencia) continue;
+            ConsiderarAntena(procura, no->antenas[i]);
+        }
+        return;
+    }
+
+    int ordem[4] = { 0, 1, 2, 3 };
+    double distancias[4];
+    for (int q = 0; q < 4; q++) {
+        distancias[q] = no->filhos[q] ? DistanciaAoNo(no->filhos[q], procura->coluna, procura->linha) : 0;
+    }
+    for (int i = 1; i < 4; i++) {
+        for (int j = i; j > 0 && distancias[ordem[j]] < distancias[ordem[j - 1]]; j--) {
+            int troca = ordem[j];
+            ordem[j] = ordem[j - 1];
+            ordem[j - 1] = troca;
+        }
+    }
+    for (int i = 0; i < 4; i++) ProcurarVizinhasNo(procura, no->filhos[ordem[i]]);
+}
+
+/**
+ * Funo para encontrar as k antenas mais prximas de (coluna, linha) (distncia euclidiana).
+ * Os empates so resolvidos por linha, coluna e id, por isso o resultado no depende da forma da rvore.
+ *
+ * @param grafo --> Apontador para o grafo (a rvore  construda se ainda no existir).
+ * @param coluna, linha --> Ponto da consulta (pode ter uma antena, que tambm conta).
+ * @param k --> Nmero de antenas pedidas.
+ * @param frequencia --> S as antenas desta frequncia, ou 0 para todas.
+ * @param encontradas --> Onde ficam as antenas, da mais prxima para a mais afastada
+ *                        (o contedo anterior  substitudo).
+ * @param procura --> Estado da procura.
+ * @param return --> Nmero de antenas encontradas (menos de k se no houver tantas), -1 se os argumentos
+ *                   forem invlidos, -2 se falhar a alocao.
+ */
+int ProcurarMaisProximas(Grafo* grafo, int coluna, int linha, int k, char frequencia, AntenasEncontradas* encontradas) {
+    if (!grafo || !encontradas || k < 0) return -1;
+    if (IniciarConsulta(grafo, encontradas) != 0) return -2;
+
+    const NoArvore* raiz = grafo->arvore->raiz;
+    if (!raiz || k == 0) return 0;
+    if (k > raiz->contagem) k = raiz->contagem;
+
+    ProcuraVizinhas procura = { coluna, linha, frequencia, k, malloc(k * sizeof(Candidata)), 0 };
+    if (!procura.monte) return -2;
+    ProcurarVizinhasNo(&procura, raiz);
+
+    //Tira a pior de cada vez, por isso as posies so preenchidas do fim para o incio
+    int resultado = GarantirEncontradas(encontradas, procura.total);
+    if (resultado == 0) {
+        encontradas->total = procura.total;
+        for (int i = procura.total - 1; i >= 0; i--) {
+            encontradas->antenas[i] = procura.monte[0].antena;
+            procura.monte[0] = procura.monte[i];
+            DescerNoMonte(procura.monte, i, 0);
+        }
+    }
+    free(procura.monte);
+    return resultado == 0 ? encontradas->total : resultado;
+}
+#pragma endregion
@@ -0,0 +1,941 @@
+/*****************************************************************//**
+ * \file   benchmark.c
+ * \brief  Tempos e conferncia dos resultados das funes do grafo numa grelha gerada.
+ *
+ * Programa independente (no faz parte do projeto Visual Studio). Exemplo em Linux:
+ *   make benchmark
+ *   ./benchmark 400 400 0.05 26 8
+ *
+ * Mede cada funo sobre o grafo em listas e, quando existe, sobre a cpia compacta (CSR)
+ * ou a verso paralela, e confere que os resultados so iguais: leitura com vrias threads,
+ * formato binrio, travessias, intersees, interferncias e mapa, exportao, relatrio,
+ * rvore espacial e alteraes em lote, alm de casos pequenos construdos  mo (caminhos
+ * interrompidos, nveis com mudana de direo, antenas repetidas). Cada conferncia
+ * escreve "igual" ou "DIFERENTE", e o programa termina com 1 se alguma der DIFERENTE
+ * (make testar corre-o em grelhas pequenas).
+ *
+ * Argumentos: largura, altura, densidade, frequncias, threads, assimetria das frequncias,
+ * ficheiro CSV e repeties. Com um ficheiro CSV ("-" para a sada padro) no so feitas
+ * as comparaes: cada funo pblica  medida  parte, repeticoes vezes, e  acrescentada
+ * uma linha por funo ao ficheiro (mnimo e mediana), para acompanhar as verses.
+ *   ./benchmark 400 400 0.05 26 0 0.8 benchmark.csv 5
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include <time.h>
+#include "antenas.h"
+
+#define FREQUENCIAS_DOMINANTES 3
+#define MAX_REPETICOES 100
+
+#pragma region Tempo
+static double Agora(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+#pragma endregion
+
+#pragma region GerarGrelha
+/**
+ * Gera um ficheiro de antenas com o formato de antenas.txt.
+ * Usa um gerador pseudo-aleatrio prprio para o resultado ser igual em qualquer plataforma.
+ * Com assimetria 0 as frequncias so uniformes; com assimetria a, uma frao a das antenas
+ * fica com uma das FREQUENCIAS_DOMINANTES primeiras frequncias e as restantes so uniformes.
+ *
+ * @param nomeFicheiro --> Nome do ficheiro a criar.
+ * @param largura --> Nmero de colunas da grelha.
+ * @param altura --> Nmero de linhas da grelha.
+ * @param densidade --> Probabilidade de cada clula ter uma antena (0..1).
+ * @param numFrequencias --> Nmero de frequncias diferentes (1..52).
+ * @param assimetria --> Frao das antenas nas frequncias dominantes (0..1).
+ * @param dominantes --> Nmero de frequncias dominantes (no mximo numFrequencias).
+ * @param return --> 0 se o ficheiro foi criado, -1 caso contrrio.
+ */
+static int GerarGrelha(const char* nomeFicheiro, int largura, int altura, double densidade, int numFrequencias, double assimetria) {
+    static const char simbolos[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+    FILE* ficheiro = fopen(nomeFicheiro, "w");
+    if (!ficheiro) return -1;
+
+    unsigned long long estado = 88172645463325252ULL;
+    unsigned long long limite = (unsigned long long)(densidade * 4294967296.0);
+    unsigned long long limiteDominantes = (unsigned long long)(assimetria * 65536.0);
+    int dominantes = numFrequencias < FREQUENCIAS_DOMINANTES ? numFrequencias : FREQUENCIAS_DOMINANTES;
+
+    fprintf(ficheiro, "%d %d\n", altura, largura);
+    for (int y = 0; y < altura; y++) {
+        for (int x = 0; x < largura; x++) {
+            estado ^= estado << 13; estado ^= estado >> 7; estado ^= estado << 17;
+            unsigned long long sorteio = estado & 0xFFFFFFFFULL;
+            int frequencia = (int)((estado >> 32) % numFrequencias);
+            if (limiteDominantes > 0) {
+                frequencia = ((estado >> 32) & 0xFFFF) < limiteDominantes
+                    ? (int)((estado >> 48) % dominantes)
+                    : (int)((estado >> 48) % numFrequencias);
+            }
+            fputc(sorteio < limite ? simbolos[frequencia] : '.', ficheiro);
+        }
+        fputc('\n', ficheiro);
+    }
+    fclose(ficheiro);
+    return 0;
+}
+#pragma endregion
+
+#pragma region Comparacao
+/**
+ * Compara o contedo de dois ficheiros temporrios (para confirmar que a sada  igual).
+ */
+static bool MesmoConteudo(FILE* a, FILE* b) {
+    rewind(a);
+    rewind(b);
+    int ca, cb;
+    do {
+        ca = fgetc(a);
+        cb = fgetc(b);
+        if (ca != cb) return false;
+    } while (ca != EOF);
+    return true;
+}
+
+/**
+ * Compara dois grafos antena a antena, pela ordem da lista e pela ordem de cada balde.
+ */
+static bool MesmoGrafo(const Grafo* a, const Grafo* b) {
+    if (a->totalAntenas != b->totalAntenas) return false;
+    const Antena* x = a->antenas;
+    const Antena* y = b->antenas;
+    while (x && y) {
+        if (x->frequencia != y->frequencia || x->coluna != y->coluna || x->linha != y->linha) return false;
+        x = x->proxima;
+        y = y->proxima;
+    }
+    if (x != NULL || y != NULL) return false;
+    if (!a->baldes || !b->baldes) return a->baldes == b->baldes;
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) {
+        if (a->baldes[f].total != b->baldes[f].total) return false;
+        for (int i = 0; i < a->baldes[f].total; i++) {
+            x = a->baldes[f].antenas[i];
+            y = b->baldes[f].antenas[i];
+            if (x->coluna != y->coluna || x->linha != y->linha) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Compara duas cpias compactas vetor a vetor.
+ */
+static bool MesmaCSR(const GrafoCSR* a, const GrafoCSR* b) {
+    int n = a->totalAntenas;
+    return n == b->totalAntenas && a->totalArestas == b->totalArestas &&
+        a->largura == b->largura && a->altura == b->altura &&
+        memcmp(a->frequencias, b->frequencias, n) == 0 &&
+        memcmp(a->colunas, b->colunas, n * sizeof(int)) == 0 &&
+        memcmp(a->linhas, b->linhas, n * sizeof(int)) == 0 &&
+        memcmp(a->inicioArestas, b->inicioArestas, (n + 1) * sizeof(int)) == 0 &&
+        memcmp(a->destinos, b->destinos, a->totalArestas * sizeof(int)) == 0 &&
+        memcmp(a->inicioBaldes, b->inicioBaldes, (NUM_FREQUENCIAS + 1) * sizeof(int)) == 0 &&
+        memcmp(a->membrosBaldes, b->membrosBaldes, a->inicioBaldes[NUM_FREQUENCIAS] * sizeof(int)) == 0;
+}
+
+static const Alteracao* alteracoesOrdenar;
+
+static int CompararPosicaoAlteracao(const void* a, const void* b) {
+    int i = *(const int*)a, j = *(const int*)b;
+    const Alteracao* x = &alteracoesOrdenar[i];
+    const Alteracao* y = &alteracoesOrdenar[j];
+    if (x->linha != y->linha) return x->linha < y->linha ? -1 : 1;
+    if (x->coluna != y->coluna) return x->coluna < y->coluna ? -1 : 1;
+    return i - j;
+}
+
+/**
+ * Aplica as alteraes uma a uma com as funes de uma antena/ligao, pela ordem em que
+ * AplicarAlteracoes as aplica (primeiro as de antenas, por posio, e depois as de ligaes),
+ * para que tambm os baldes fiquem pela mesma ordem.
+ */
+static void AplicarUmaAUma(Grafo* grafo, const Alteracao* alteracoes, int total) {
+    int* ordem = malloc((total > 0 ? total : 1) * sizeof(int));
+    if (!ordem) return;
+    for (int i = 0; i < total; i++) ordem[i] = i;
+    alteracoesOrdenar = alteracoes;
+    qsort(ordem, total, sizeof(int), CompararPosicaoAlteracao);
+    for (int k = 0; k < total; k++) {
+        const Alteracao* alteracao = &alteracoes[ordem[k]];
+        if (alteracao->tipo == INSERIR_ANTENA) adicionarAntenaOrdenado(grafo, alteracao->frequencia, alteracao->coluna, alteracao->linha);
+        else if (alteracao->tipo == REMOVER_ANTENA) removerAntena(grafo, alteracao->coluna, alteracao->linha);
+    }
+    free(ordem);
+    for (int i = 0; i < total; i++) {
+        if (alteracoes[i].tipo != INSERIR_LIGACAO && alteracoes[i].tipo != REMOVER_LIGACAO) continue;
+        Antena* origem = procurarAntena(grafo, alteracoes[i].coluna, alteracoes[i].linha);
+        Antena* destino = procurarAntena(grafo, alteracoes[i].colunaDestino, alteracoes[i].linhaDestino);
+        if (alteracoes[i].tipo == INSERIR_LIGACAO) adicionarAresta(grafo, origem, destino, alteracoes[i].verificarRepetidos);
+        else removerAresta(grafo, origem, destino);
+    }
+}
+
+/**
+ * Confere um mapa de interferncias com os pontos sem duplicados: cada ponto dentro do mapa
+ * tem de ter a clula marcada e tem de haver tantos pontos dentro como clulas marcadas.
+ */
+typedef struct ConferenciaMapa {
+    const MapaInterferencias* mapa;
+    long long dentro;
+    bool igual;
+} ConferenciaMapa;
+
+static int ConferirPonto(int coluna, int linha, void* contexto) {
+    ConferenciaMapa* conferencia = contexto;
+    if (coluna < 0 || coluna >= conferencia->mapa->largura || linha < 0 || linha >= conferencia->mapa->altura) return 0;
+    conferencia->dentro++;
+    if (!CelulaAfetada(conferencia->mapa, coluna, linha)) conferencia->igual = false;
+    return 0;
+}
+
+/**
+ * Antena encontrada pela pesquisa linear, com o quadrado da distncia ao ponto da consulta.
+ */
+typedef struct AntenaDistancia {
+    Antena* antena;
+    double distancia;
+} AntenaDistancia;
+
+//Mesma ordem das consultas da rvore: distncia, linha, coluna e id
+static int CompararDistancia(const void* a, const void* b) {
+    const AntenaDistancia* x = a;
+    const AntenaDistancia* y = b;
+    if (x->distancia != y->distancia) return x->distancia < y->distancia ? -1 : 1;
+    if (x->antena->linha != y->antena->linha) return x->antena->linha < y->antena->linha ? -1 : 1;
+    if (x->antena->coluna != y->antena->coluna) return x->antena->coluna < y->antena->coluna ? -1 : 1;
+    return (x->antena->id > y->antena->id) - (x->antena->id < y->antena->id);
+}
+
+/**
+ * Consulta por zona feita com uma pesquisa linear na lista (tipo 0 retngulo, 1 raio, 2 vizinhas).
+ * Nos tipos 0 e 1 a distncia  0, por isso a ordem fica por linha e coluna como na rvore.
+ */
+static int ConsultaLinear(const Grafo* grafo, int tipo, const int* parametros, double raio, char frequencia, AntenaDistancia* resultado) {
+    int total = 0;
+    for (Antena* a = grafo->antenas; a != NULL; a = a->proxima) {
+        if (frequencia && a->frequencia != frequencia) continue;
+        double dx = (double)a->coluna - parametros[0], dy = (double)a->linha - parametros[1];
+        if (tipo == 0 && (a->coluna < parametros[0] || a->coluna > parametros[2] || a->linha < parametros[1] || a->linha > parametros[3])) continue;
+        if (tipo == 1 && dx * dx + dy * dy > raio * raio) continue;
+        resultado[total].antena = a;
+        resultado[total].distancia = tipo == 2 ? dx * dx + dy * dy : 0;
+        total++;
+    }
+    qsort(resultado, total, sizeof(AntenaDistancia), CompararDistancia);
+    return tipo == 2 && total > parametros[2] ? parametros[2] : total;
+}
+
+/**
+ * Faz consultas ao acaso (retngulo, raio e vizinhas, com e sem frequncia)  rvore espacial
+ * e  pesquisa linear e confere que do as mesmas antenas pela mesma ordem.
+ * Os tempos de cada forma so somados em tArvore e tLinear.
+ */
+static bool ConferirConsultas(Grafo* grafo, int largura, int altura, int numFrequencias, int totalConsultas, double* tArvore, double* tLinear) {
+    AntenaDistancia* linear = malloc((grafo->totalAntenas + 1) * sizeof(AntenaDistancia));
+    AntenasEncontradas encontradas = { NULL, 0, 0 };
+    if (!linear) return false;
+
+    bool igual = true;
+    unsigned long long estado = 88172645463325252ULL;
+    for (int c = 0; c < totalConsultas && igual; c++) {
+        estado ^= estado << 13; estado ^= estado >> 7; estado ^= estado << 17;
+        int tipo = c % 3;
+        char frequencia = (estado >> 60) & 1 ? (char)('A' + (estado >> 40) % numFrequencias) : 0;
+        int parametros[4] = { (int)(estado % largura), (int)((estado >> 16) % altura), 0, 0 };
+        double raio = 0;
+        if (tipo == 0) {
+            parametros[2] = parametros[0] + (int)((estado >> 32) % (largura / 10 + 1));
+            parametros[3] = parametros[1] + (int)((estado >> 48) % (altura / 10 + 1));
+        }
+        else if (tipo == 1) raio = (double)((estado >> 32) % ((largura > altura ? largura : altura) / 20 + 1)) + 0.5;
+        else parametros[2] = 1 + (int)((estado >> 32) % 10);
+
+        double t0 = Agora();
+        int total = tipo == 0 ? ProcurarNoRetangulo(grafo, parametros[0], parametros[1], parametros[2], parametros[3], frequencia, &encontradas)
+            : tipo == 1 ? ProcurarNoRaio(grafo, parametros[0], parametros[1], raio, frequencia, &encontradas)
+            : ProcurarMaisProximas(grafo, parametros[0], parametros[1], parametros[2], frequencia, &encontradas);
+        *tArvore += Agora() - t0;
+        t0 = Agora();
+        int totalLinear = ConsultaLinear(grafo, tipo, parametros, raio, frequencia, linear);
+        *tLinear += Agora() - t0;
+
+        igual = total == totalLinear;
+        for (int i = 0; i < total && igual; i++) igual = encontradas.antenas[i] == linear[i].antena;
+    }
+    LibertarEncontradas(&encontradas);
+    free(linear);
+    return igual;
+}
+
+/**
+ * Exporta, em cada formato, os caminhos entre duas antenas de uma frequncia com 12 antenas
+ * (muito mais caminhos do que MAX_CAMINHOS_RELATORIO) e confere que cada ficheiro acaba
+ * com o registo de procura interrompida.
+ */
+static bool ConferirCaminhosInterrompidos(void) {
+    static const char* const finais[] = {
+        "... procura interrompida (limite de caminhos) depois de 1000 caminhos\n",
+        "1000,-1,limite,,\n",
+        "{\"interrompida\":true,\"motivo\":\"limite\",\"caminhos\":1000}\n",
+        "\xff\xff\xff\xff\x00\x00\x00\x00\xe8\x03\x00\x00"
+    };
+    Grafo grafo = { 0 };
+    for (int i = 0; i < 12; i++) adicionarAntenaOrdenado(&grafo, 'A', i, 0);
+
+    bool igual = grafo.totalAntenas == 12;
+    for (int f = EXPORTAR_TEXTO; f <= EXPORTAR_BINARIO && igual; f++) {
+        FILE* saida = tmpfile();
+        if (!saida) return false;
+        OpcoesExportacao exportacao;
+        memset(&exportacao, 0, sizeof(OpcoesExportacao));
+        exportacao.seccoes[SECCAO_CAMINHOS] = (DestinoExportacao){ (FormatoExportacao)f, saida };
+        size_t tamanho = f == EXPORTAR_BINARIO ? 12 : strlen(finais[f - EXPORTAR_TEXTO]);
+        char fim[80] = { 0 };
+        igual = ExportarResultados(&grafo, &exportacao) == 0 && fseek(saida, -(long)tamanho, SEEK_END) == 0 &&
+            fread(fim, 1, tamanho, saida) == tamanho && memcmp(fim, finais[f - EXPORTAR_TEXTO], tamanho) == 0;
+        fclose(saida);
+    }
+    LibertarGrafo(&grafo);
+    return igual;
+}
+
+//Camadas do grafo de ConstruirGrafoEmCamadas: trs largas e uma cauda em cadeia
+static const int TAMANHOS_CAMADAS[] = { 1, 24, 24, 24, 1, 1, 1, 1 };
+#define TOTAL_CAMADAS ((int)(sizeof(TAMANHOS_CAMADAS) / sizeof(TAMANHOS_CAMADAS[0])))
+
+/**
+ * Constri um grafo em camadas (TAMANHOS_CAMADAS), cada uma na sua linha e com a sua
+ * frequncia, ligada  seguinte s por ligaes explcitas (todas as antenas de uma
+ * camada para todas as da seguinte).
+ */
+static void ConstruirGrafoEmCamadas(Grafo* grafo) {
+    for (int c = 0; c < TOTAL_CAMADAS; c++) {
+        for (int i = 0; i < TAMANHOS_CAMADAS[c]; i++) adicionarAntenaOrdenado(grafo, (char)('A' + c), i, c);
+    }
+
+    //as antenas entram pela ordem das camadas, por isso os ids de cada camada so seguidos
+    int primeira = 0;
+    for (int c = 0; c + 1 < TOTAL_CAMADAS; c++) {
+        int seguinte = primeira + TAMANHOS_CAMADAS[c];
+        for (int i = 0; i < TAMANHOS_CAMADAS[c]; i++) {
+            for (int j = 0; j < TAMANHOS_CAMADAS[c + 1]; j++) {
+                adicionarAresta(grafo, grafo->porId[primeira + i], grafo->porId[seguinte + j], false);
+            }
+        }
+        primeira = seguinte;
+    }
+}
+
+/**
+ * Nveis em largura no grafo em camadas: as trs camadas largas levam a procura a passar
+ * a ascendente e a cauda em cadeia f-la voltar a descendente. Os nveis tm de ser
+ * iguais aos da procura s descendente.
+ *
+ * @param ascendentes --> Onde guardar o nmero de passos ascendentes da procura com direo.
+ * @param return --> Verdadeiro se os nveis forem iguais.
+ */
+static bool ConferirNiveisComDirecao(int* ascendentes) {
+    Grafo grafo = { 0 };
+    ConstruirGrafoEmCamadas(&grafo);
+
+    bool igual = false;
+    *ascendentes = 0;
+    int* niveis = malloc(grafo.totalIds * sizeof(int));
+    int* niveisDirecao = malloc(grafo.totalIds * sizeof(int));
+    int* pais = malloc(grafo.totalIds * sizeof(int));
+    ResultadoLargura descendente, direcao;
+    if (niveis && niveisDirecao && pais &&
+        NiveisEmLargura(&grafo, grafo.porId[0], LARGURA_DESCENDENTE, niveis, pais, &descendente) == 0 &&
+        NiveisEmLargura(&grafo, grafo.porId[0], LARGURA_DIRECAO_OTIMIZADA, niveisDirecao, pais, &direcao) == 0) {
+        *ascendentes = direcao.passosAscendentes;
+        igual = direcao.totalNiveis == TOTAL_CAMADAS && descendente.alcancadas == grafo.totalAntenas &&
+            memcmp(niveis, niveisDirecao, grafo.totalIds * sizeof(int)) == 0;
+    }
+    free(niveis); free(niveisDirecao); free(pais);
+    LibertarGrafo(&grafo);
+    return igual;
+}
+
+/**
+ * Ida e volta do grafo em camadas pelo formato binrio: as ligaes explcitas tm de
+ * voltar todas, pela mesma ordem (a cpia compacta do grafo reconstrudo  igual  do original).
+ *
+ * @param adjacencias --> Onde guardar o nmero de adjacncias na arena do grafo reconstrudo.
+ * @param return --> Verdadeiro se o grafo reconstrudo for igual ao original.
+ */
+static bool ConferirBinarioComLigacoes(long long* adjacencias) {
+    const char* nomeBinario = "benchmark_camadas.bin";
+    Grafo grafo = { 0 }, reconstruido = { 0 };
+    ConstruirGrafoEmCamadas(&grafo);
+    *adjacencias = 0;
+
+    GrafoBinario binario;
+    GrafoCSR original, copia;
+    bool igual = GuardarGrafoBinario(&grafo, nomeBinario) == 0 && AbrirGrafoBinario(nomeBinario, &binario, true) == 0;
+    if (igual) {
+        igual = ReconstruirGrafo(&binario.csr, &reconstruido) == 0;
+        FecharGrafoBinario(&binario);
+    }
+    if (igual && ConstruirGrafoCSR(&grafo, &original) == 0) {
+        if (ConstruirGrafoCSR(&reconstruido, &copia) == 0) {
+            igual = original.totalArestas > 0 && MesmaCSR(&original, &copia);
+            LibertarGrafoCSR(&copia);
+        }
+        else igual = false;
+        LibertarGrafoCSR(&original);
+    }
+    else igual = false;
+
+    EstatisticasArena estatisticas;
+    EstatisticasDoGrafo(&reconstruido, &estatisticas);
+    *adjacencias = estatisticas.nosEmUso[NO_ADJACENCIA];
+    remove(nomeBinario);
+    LibertarGrafo(&grafo);
+    LibertarGrafo(&reconstruido);
+    return igual;
+}
+
+/**
+ * Remoo de antenas repetidas numa coordenada (adicionarAntenaFim no verifica a posio):
+ * tirar uma repetida no pode tirar a indexada do ndice, e tirar a indexada passa o ndice
+ * para a que sobra.
+ */
+static bool ConferirRepetidasNoIndice(void) {
+    Grafo grafo = { 0 };
+    adicionarAntenaFim(&grafo, 'A', 1, 1);
+    adicionarAntenaFim(&grafo, 'B', 1, 1);
+    adicionarAntenaFim(&grafo, 'C', 1, 1);
+    Antena* repetida = grafo.antenas->proxima;
+    bool igual = grafo.antenasForaDoIndice == 2 && ProcurarNoIndice(&grafo, 1, 1) == grafo.antenas;
+
+    desligarAntena(&grafo, repetida);
+    RemoverDoBalde(&grafo, repetida);
+    igual = igual && ProcurarNoIndice(&grafo, 1, 1) == grafo.antenas && grafo.antenasForaDoIndice == 1;
+    removerAntena(&grafo, 1, 1);
+    Antena* restante = ProcurarNoIndice(&grafo, 1, 1);
+    igual = igual && restante && restante->frequencia == 'C' && grafo.antenasForaDoIndice == 0;
+    removerAntena(&grafo, 1, 1);
+    igual = igual && ProcurarNoIndice(&grafo, 1, 1) == NULL && grafo.totalAntenas == 0;
+    LibertarGrafo(&grafo);
+    return igual;
+}
+
+/**
+ * Alteraes em lote sobre uma lista que no est ordenada por (linha, coluna) (construda
+ * com adicionarAntenaFim ao contrrio): tm de dar o mesmo que as alteraes uma a uma.
+ */
+static bool ConferirLoteListaDesordenada(void) {
+    static const Alteracao ALTERACOES[] = {
+        { INSERIR_ANTENA, 'Z', 0, 0, 0, 0, false },
+        { INSERIR_ANTENA, 'Z', 5, 2, 0, 0, false },
+        { REMOVER_ANTENA, 'A', 1, 1, 0, 0, false },
+        { INSERIR_ANTENA, 'Z', 3, 1, 0, 0, false },
+        { INSERIR_ANTENA, 'Z', 9, 3, 0, 0, false },
+        { INSERIR_LIGACAO, 'Z', 5, 2, 0, 0, true },
+    };
+    int total = (int)(sizeof(ALTERACOES) / sizeof(ALTERACOES[0]));
+    int estados[sizeof(ALTERACOES) / sizeof(ALTERACOES[0])];
+    Grafo umaAUma = { 0 }, emLote = { 0 };
+    for (int i = 8; i >= 1; i--) {
+        adicionarAntenaFim(&umaAUma, 'A', i, i % 4);
+        adicionarAntenaFim(&emLote, 'A', i, i % 4);
+    }
+    AplicarUmaAUma(&umaAUma, ALTERACOES, total);
+    int falhas = AplicarAlteracoes(&emLote, ALTERACOES, total, estados);
+    bool igual = falhas == 0 && MesmoGrafo(&umaAUma, &emLote);
+    LibertarGrafo(&umaAUma);
+    LibertarGrafo(&emLote);
+    return igual;
+}
+
+/**
+ * Carregar a grelha para um grafo que j tem uma grelha mais larga e mais baixa: os dois
+ * carregadores tm de deixar a maior largura e a maior altura.
+ */
+static bool ConferirGrelhaAcumulada(const char* nomeGrelha, int largura, int altura) {
+    Grafo sequencial = { 0 }, paralelo = { 0 };
+    sequencial.largura = paralelo.largura = largura + 7;
+    sequencial.altura = paralelo.altura = 1;
+    bool igual = carregarAntenasDoFicheiro(&sequencial, nomeGrelha) == 0 &&
+        CarregarAntenasParalelo(&paralelo, nomeGrelha, 2, NULL) == 0 &&
+        sequencial.largura == largura + 7 && sequencial.altura == altura &&
+        paralelo.largura == largura + 7 && paralelo.altura == altura;
+    LibertarGrafo(&sequencial);
+    LibertarGrafo(&paralelo);
+    return igual;
+}
+
+static FILE* NovaSaida(FILE* anterior) {
+    if (anterior) fclose(anterior);
+    return tmpfile();
+}
+
+//Nmero de comparaes que deram diferente; o benchmark termina com 1 se houver alguma
+static int totalDiferentes = 0;
+
+/**
+ * Texto do resultado de uma comparao, contando as que deram diferente.
+ */
+static const char* Estado(bool igual) {
+    if (!igual) totalDiferentes++;
+    return igual ? "igual" : "DIFERENTE";
+}
+
+static void Relatar(const char* fase, double tLista, double tCSR, bool igual) {
+    printf("%-16s lista %9.3f ms   csr %9.3f ms   x%6.2f   %s\n",
+        fase, tLista * 1e3, tCSR * 1e3, tCSR > 0 ? tLista / tCSR : 0.0, Estado(igual));
+}
+#pragma endregion
+
+#pragma region Suite
+/**
+ * Funes medidas pela suite, pela ordem em que so chamadas em cada repetio.
+ */
+typedef enum OperacaoSuite {
+    OPERACAO_CARREGAR,
+    OPERACAO_CARREGAR_NOVAS,
+    OPERACAO_PROFUNDIDADE,
+    OPERACAO_LARGURA,
+    OPERACAO_CAMINHOS,
+    OPERACAO_INTERSECOES,
+    OPERACAO_INTERFERENCIAS,
+    OPERACAO_LIBERTAR,
+    NUM_OPERACOES
+} OperacaoSuite;
+
+static const char* const NOMES_OPERACOES[NUM_OPERACOES] = {
+    "CarregarAntenasDoFicheiro", "carregarAntenasDoFicheiro", "TravessiaEmProfundidade", "TravessiaEmLargura",
+    "EncontrarCaminhos", "MostrarIntersecoes", "MostrarInterferencias", "LibertarGrafo"
+};
+
+static int CompararTempos(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Mede cada funo pblica  parte, repeticoes vezes, sobre a grelha gerada, e acrescenta ao
+ * ficheiro CSV uma linha por funo com o mnimo e a mediana (o cabealho s  escrito se o
+ * ficheiro estiver vazio). As sadas vo para um ficheiro temporrio, recriado antes de cada
+ * chamada; os caminhos vo da primeira  terceira antena, com os limites de EncontrarCaminhos.
+ *
+ * @param nomeGrelha --> Ficheiro de antenas gerado.
+ * @param nomeCsv --> Ficheiro CSV onde acrescentar os resultados ("-" para a sada padro).
+ * @param largura, altura, densidade, numFrequencias, assimetria --> Parmetros da grelha (copiados para cada linha).
+ * @param repeticoes --> Nmero de vezes que cada funo  medida (1..MAX_REPETICOES).
+ * @param tempos --> Tempos de cada repetio, por funo.
+ * @param return --> 0 se a suite correu, -1 se no foi possvel abrir os ficheiros ou a grelha estiver vazia.
+ */
+static int ExecutarSuite(const char* nomeGrelha, const char* nomeCsv, int largura, int altura, double densidade,
+    int numFrequencias, double assimetria, int repeticoes) {
+    static double tempos[NUM_OPERACOES][MAX_REPETICOES];
+    char freqA = 'A', freqB = numFrequencias > 1 ? 'B' : 'A';
+    int totalAntenas = 0;
+    FILE* saida = NULL;
+
+    for (int r = 0; r < repeticoes; r++) {
+        double t0 = Agora();
+        Grafo grafo = CarregarAntenasDoFicheiro(nomeGrelha);
+        tempos[OPERACAO_CARREGAR][r] = Agora() - t0;
+        totalAntenas = grafo.totalAntenas;
+        if (!grafo.antenas) return -1;
+
+        Grafo cidade = { 0 };
+        t0 = Agora();
+        carregarAntenasDoFicheiro(&cidade, nomeGrelha);
+        tempos[OPERACAO_CARREGAR_NOVAS][r] = Agora() - t0;
+        LibertarGrafo(&cidade);
+
+        Antena* primeira = grafo.antenas;
+        Antena* terceira = primeira->proxima && primeira->proxima->proxima ? primeira->proxima->proxima : primeira;
+
+        if (!(saida = NovaSaida(saida))) return -1;
+        t0 = Agora();
+        TravessiaEmProfundidade(&grafo, primeira, saida);
+        tempos[OPERACAO_PROFUNDIDADE][r] = Agora() - t0;
+
+        if (!(saida = NovaSaida(saida))) return -1;
+        t0 = Agora();
+        TravessiaEmLargura(&grafo, primeira, saida);
+        tempos[OPERACAO_LARGURA][r] = Agora() - t0;
+
+        if (!(saida = NovaSaida(saida))) return -1;
+        t0 = Agora();
+        EncontrarCaminhos(&grafo, primeira, terceira, saida);
+        tempos[OPERACAO_CAMINHOS][r] = Agora() - t0;
+
+        if (!(saida = NovaSaida(saida))) return -1;
+        t0 = Agora();
+        MostrarIntersecoes(&grafo, freqA, freqB, saida);
+        tempos[OPERACAO_INTERSECOES][r] = Agora() - t0;
+
+        if (!(saida = NovaSaida(saida))) return -1;
+        t0 = Agora();
+        MostrarInterferencias(&grafo, saida);
+        tempos[OPERACAO_INTERFERENCIAS][r] = Agora() - t0;
+
+        t0 = Agora();
+        LibertarGrafo(&grafo);
+        tempos[OPERACAO_LIBERTAR][r] = Agora() - t0;
+    }
+    if (saida) fclose(saida);
+
+    bool saidaPadrao = strcmp(nomeCsv, "-") == 0;
+    FILE* csv = saidaPadrao ? stdout : fopen(nomeCsv, "a");
+    if (!csv) return -1;
+    fseek(csv, 0, SEEK_END);
+    if (saidaPadrao || ftell(csv) == 0) {
+        fprintf(csv, "largura,altura,densidade,frequencias,assimetria,antenas,operacao,repeticoes,minimo_ms,mediana_ms\n");
+    }
+    for (int o = 0; o < NUM_OPERACOES; o++) {
+        qsort(tempos[o], repeticoes, sizeof(double), CompararTempos);
+        double mediana = repeticoes % 2 ? tempos[o][repeticoes / 2] : (tempos[o][repeticoes / 2 - 1] + tempos[o][repeticoes / 2]) / 2;
+        fprintf(csv, "%d,%d,%.4f,%d,%.3f,%d,%s,%d,%.4f,%.4f\n", largura, altura, densidade, numFrequencias, assimetria,
+            totalAntenas, NOMES_OPERACOES[o], repeticoes, tempos[o][0] * 1e3, mediana * 1e3);
+    }
+    if (!saidaPadrao) fclose(csv);
+    return 0;
+}
+#pragma endregion
+
+#pragma region Main
+int main(int argc, char** argv) {
+    int largura = argc > 1 ? atoi(argv[1]) : 400;
+    int altura = argc > 2 ? atoi(argv[2]) : 400;
+    double densidade = argc > 3 ? atof(argv[3]) : 0.05;
+    int numFrequencias = argc > 4 ? atoi(argv[4]) : 26;
+    if (numFrequencias < 1) numFrequencias = 1;
+    if (numFrequencias > 52) numFrequencias = 52;
+    int numThreads = argc > 5 ? atoi(argv[5]) : 0;
+    double assimetria = argc > 6 ? atof(argv[6]) : 0.0;
+    if (assimetria < 0) assimetria = 0;
+    if (assimetria > 1) assimetria = 1;
+    const char* nomeCsv = argc > 7 ? argv[7] : NULL;
+    int repeticoes = argc > 8 ? atoi(argv[8]) : 3;
+    if (repeticoes < 1) repeticoes = 1;
+    if (repeticoes > MAX_REPETICOES) repeticoes = MAX_REPETICOES;
+
+    const char* nomeGrelha = "benchmark_grelha.txt";
+    if (GerarGrelha(nomeGrelha, largura, altura, densidade, numFrequencias, assimetria) != 0) {
+        fprintf(stderr, "Nao foi possivel criar %s\n", nomeGrelha);
+        return 1;
+    }
+
+    //Suite para CSV: cada funo medida  parte, sem as comparaes
+    if (nomeCsv) {
+        int estadoSuite = ExecutarSuite(nomeGrelha, nomeCsv, largura, altura, densidade, numFrequencias, assimetria, repeticoes);
+        remove(nomeGrelha);
+        if (estadoSuite != 0) fprintf(stderr, "Nao foi possivel executar a suite (%s)\n", nomeCsv);
+        return estadoSuite != 0;
+    }
+
+    Grafo grafo = { 0 };
+    EstatisticasCarregamento carregamento;
+    CarregarAntenasMapeado(&grafo, nomeGrelha, &carregamento);
+    if (grafo.totalAntenas == 0) {
+        fprintf(stderr, "Grelha vazia\n");
+        return 1;
+    }
+
+    //Leitura com vrias threads: o grafo tem de ficar igual
+    Grafo grafoParalelo = { 0 };
+    EstatisticasCarregamento carregamentoParalelo;
+    CarregarAntenasParalelo(&grafoParalelo, nomeGrelha, numThreads, &carregamentoParalelo);
+    bool mesmoGrafo = MesmoGrafo(&grafo, &grafoParalelo);
+    LibertarGrafo(&grafoParalelo);
+
+    GrafoCSR csr;
+    double t0 = Agora();
+    if (ConstruirGrafoCSR(&grafo, &csr) != 0) {
+        LibertarGrafo(&grafo);
+        return 1;
+    }
+    double tConstruir = Agora() - t0;
+
+    printf("grelha %dx%d, densidade %.3f, %d frequencias, %d antenas, coordenadas %s de %d bits\n",
+        largura, altura, densidade, numFrequencias, grafo.totalAntenas, InstrucoesVetoriais(), (int)sizeof(Coordenada) * 8);
+    printf("carregar %.3f ms (%.1f MB/s), construir csr %.3f ms\n",
+        carregamento.segundos * 1e3, carregamento.mbPorSegundo, tConstruir * 1e3);
+    printf("leitura da grelha: 1 thread %.3f ms, %d threads %.3f ms (x%.2f), total %.3f ms, %s\n",
+        carregamento.segundosAnalise * 1e3, carregamentoParalelo.threads, carregamentoParalelo.segundosAnalise * 1e3,
+        carregamentoParalelo.segundosAnalise > 0 ? carregamento.segundosAnalise / carregamentoParalelo.segundosAnalise : 0.0,
+        carregamentoParalelo.segundos * 1e3, Estado(mesmoGrafo));
+
+    EstatisticasArena estatisticas;
+    EstatisticasDoGrafo(&grafo, &estatisticas);
+    printf("arena: %zu bytes reservados em %d blocos, %zu usados, %lld antenas, %lld adjacencias\n",
+        estatisticas.bytesReservados, estatisticas.totalBlocos, estatisticas.bytesUsados,
+        estatisticas.nosEmUso[NO_ANTENA], estatisticas.nosEmUso[NO_ADJACENCIA]);
+
+    //Ida e volta pelo formato binrio: a cpia aberta tem de ser igual  construda
+    //e o grafo reconstrudo igual ao carregado do ficheiro de texto
+    const char* nomeBinario = "benchmark_grafo.bin";
+    t0 = Agora();
+    int gravado = GuardarGrafoBinario(&grafo, nomeBinario);
+    double tGravar = Agora() - t0;
+    GrafoBinario binario;
+    t0 = Agora();
+    int aberto = gravado == 0 ? AbrirGrafoBinario(nomeBinario, &binario, false) : -1;
+    double tAbrir = Agora() - t0;
+    if (aberto == 0) FecharGrafoBinario(&binario);
+    t0 = Agora();
+    aberto = gravado == 0 ? AbrirGrafoBinario(nomeBinario, &binario, true) : -1;
+    double tValidar = Agora() - t0;
+    bool binarioIgual = aberto == 0 && MesmaCSR(&csr, &binario.csr);
+    Grafo reconstruido = { 0 };
+    if (aberto == 0) {
+        binarioIgual = binarioIgual && ReconstruirGrafo(&binario.csr, &reconstruido) == 0 &&
+            MesmoGrafo(&grafo, &reconstruido) && reconstruido.largura == grafo.largura && reconstruido.altura == grafo.altura;
+        FecharGrafoBinario(&binario);
+    }
+    printf("binario: gravar %.3f ms, abrir %.3f ms, abrir e validar %.3f ms, ida e volta %s\n",
+        tGravar * 1e3, tAbrir * 1e3, tValidar * 1e3, Estado(binarioIgual));
+    remove(nomeBinario);
+    long long adjacenciasBinario;
+    binarioIgual = ConferirBinarioComLigacoes(&adjacenciasBinario);
+    printf("binario com ligacoes: %lld adjacencias reconstruidas, ida e volta %s\n",
+        adjacenciasBinario, Estado(binarioIgual));
+    printf("antenas repetidas: indice depois de remover %s\n", Estado(ConferirRepetidasNoIndice()));
+    printf("alteracoes com lista desordenada: %s\n", Estado(ConferirLoteListaDesordenada()));
+    printf("grelha ao carregar para um grafo com antenas: %s\n", Estado(ConferirGrelhaAcumulada(nomeGrelha, largura, altura)));
+
+    FILE* saidaLista = NovaSaida(NULL);
+    FILE* saidaCSR = NovaSaida(NULL);
+    if (!saidaLista || !saidaCSR) return 1;
+    double tLista, tCSR;
+
+    //Profundidade a partir da primeira antena (ndice 0 na cpia)
+    t0 = Agora();
+    TravessiaEmProfundidade(&grafo, grafo.antenas, saidaLista);
+    tLista = Agora() - t0;
+    t0 = Agora();
+    TravessiaEmProfundidadeCSR(&csr, 0, saidaCSR);
+    tCSR = Agora() - t0;
+    Relatar("profundidade", tLista, tCSR, MesmoConteudo(saidaLista, saidaCSR));
+
+    //A travessia do grafo reconstrudo a partir do binrio tem de dar o mesmo resultado
+    if (reconstruido.antenas) {
+        saidaCSR = NovaSaida(saidaCSR);
+        TravessiaEmProfundidade(&reconstruido, reconstruido.antenas, saidaCSR);
+        printf("profundidade no grafo reconstruido: %s\n", Estado(MesmoConteudo(saidaLista, saidaCSR)));
+    }
+    LibertarGrafo(&reconstruido);
+
+    //Largura
+    saidaLista = NovaSaida(saidaLista);
+    saidaCSR = NovaSaida(saidaCSR);
+    t0 = Agora();
+    TravessiaEmLargura(&grafo, grafo.antenas, saidaLista);
+    tLista = Agora() - t0;
+    t0 = Agora();
+    TravessiaEmLarguraCSR(&csr, 0, saidaCSR);
+    tCSR = Agora() - t0;
+    Relatar("largura", tLista, tCSR, MesmoConteudo(saidaLista, saidaCSR));
+
+    //Caminhos da primeira  terceira antena, com os limites do relatrio
+    if (grafo.totalAntenas > 2) {
+        saidaLista = NovaSaida(saidaLista);
+        saidaCSR = NovaSaida(saidaCSR);
+        t0 = Agora();
+        EncontrarCaminhos(&grafo, grafo.antenas, grafo.antenas->proxima->proxima, saidaLista);
+        tLista = Agora() - t0;
+        t0 = Agora();
+        EncontrarCaminhosCSR(&csr, 0, 2, saidaCSR);
+        tCSR = Agora() - t0;
+        Relatar("caminhos", tLista, tCSR, MesmoConteudo(saidaLista, saidaCSR));
+    }
+
+    //Nveis em largura: s descendente contra mudana de direo (os nveis tm de ser iguais)
+    int* niveis = malloc(grafo.totalIds * sizeof(int));
+    int* niveisDirecao = malloc(grafo.totalIds * sizeof(int));
+    int* pais = malloc(grafo.totalIds * sizeof(int));
+    if (niveis && niveisDirecao && pais) {
+        ResultadoLargura descendente, direcao;
+        t0 = Agora();
+        NiveisEmLargura(&grafo, grafo.antenas, LARGURA_DESCENDENTE, niveis, pais, &descendente);
+        double tDescendente = Agora() - t0;
+        t0 = Agora();
+        NiveisEmLargura(&grafo, grafo.antenas, LARGURA_DIRECAO_OTIMIZADA, niveisDirecao, pais, &direcao);
+        double tDirecao = Agora() - t0;
+        printf("niveis largura: descendente %.3f ms, com direcao %.3f ms (%d ascendentes), %d antenas em %d niveis, %s\n",
+            tDescendente * 1e3, tDirecao * 1e3, direcao.passosAscendentes, direcao.alcancadas, direcao.totalNiveis,
+            Estado(memcmp(niveis, niveisDirecao, grafo.totalIds * sizeof(int)) == 0));
+    }
+    free(niveis); free(niveisDirecao); free(pais);
+    int ascendentes;
+    bool niveisIguais = ConferirNiveisComDirecao(&ascendentes);
+    printf("niveis largura em camadas: %d ascendentes, %s\n", ascendentes, Estado(niveisIguais && ascendentes > 0));
+
+    //Componentes fracamente ligadas de toda a rede
+    t0 = Agora();
+    int totalComponentes = RotularComponentes(&grafo);
+    printf("componentes: %.3f ms, %d componentes\n", (Agora() - t0) * 1e3, totalComponentes);
+
+    //Intersees entre as duas primeiras frequncias
+    char freqA = 'A', freqB = numFrequencias > 1 ? 'B' : 'A';
+    saidaLista = NovaSaida(saidaLista);
+    saidaCSR = NovaSaida(saidaCSR);
+    t0 = Agora();
+    MostrarIntersecoes(&grafo, freqA, freqB, saidaLista);
+    tLista = Agora() - t0;
+    t0 = Agora();
+    MostrarIntersecoesCSR(&csr, freqA, freqB, saidaCSR);
+    tCSR = Agora() - t0;
+    Relatar("intersecoes", tLista, tCSR, MesmoConteudo(saidaLista, saidaCSR));
+
+    //Todas as intersees (cada par de frequncias uma s vez)
+    saidaLista = NovaSaida(saidaLista);
+    t0 = Agora();
+    MostrarTodasIntersecoes(&grafo, saidaLista);
+    printf("todas intersecoes %.3f ms, %ld bytes\n", (Agora() - t0) * 1e3, ftell(saidaLista));
+
+    //Interferncias
+    saidaLista = NovaSaida(saidaLista);
+    saidaCSR = NovaSaida(saidaCSR);
+    t0 = Agora();
+    MostrarInterferencias(&grafo, saidaLista);
+    tLista = Agora() - t0;
+    t0 = Agora();
+    MostrarInterferenciasCSR(&csr, saidaCSR);
+    tCSR = Agora() - t0;
+    Relatar("interferencias", tLista, tCSR, MesmoConteudo(saidaLista, saidaCSR));
+
+    //Interferncias sem pontos repetidos
+    saidaLista = NovaSaida(saidaLista);
+    OpcoesInterferencias semDuplicados = { numThreads, true };
+    t0 = Agora();
+    long long pontos = EscreverPontosInterferencia(&grafo, &semDuplicados, saidaLista);
+    printf("interferencias sem duplicados %.3f ms, %lld pontos\n", (Agora() - t0) * 1e3, pontos);
+
+    //Mapa das clulas afetadas, conferido com os pontos sem duplicados
+    MapaInterferencias mapa;
+    t0 = Agora();
+    long long celulas = CalcularMapaInterferencias(&grafo, &semDuplicados, true, &mapa);
+    double tMapa = Agora() - t0;
+    ConferenciaMapa conferencia = { &mapa, 0, celulas >= 0 };
+    PercorrerPontosInterferencia(&grafo, &semDuplicados, ConferirPonto, &conferencia);
+    printf("mapa de interferencias %.3f ms, %lld celulas em %dx%d (%lld pontos, %lld fora), %s\n",
+        tMapa * 1e3, celulas, mapa.largura, mapa.altura, mapa.pontosCalculados, mapa.pontosFora,
+        Estado(conferencia.igual && conferencia.dentro == celulas));
+    LibertarMapaInterferencias(&mapa);
+
+    //Exportao das intersees e interferncias em cada formato (tempo e tamanho)
+    const char* nomesFormatos[] = { "texto", "csv", "jsonl", "binario" };
+    printf("exportacao:");
+    for (int f = EXPORTAR_TEXTO; f <= EXPORTAR_BINARIO; f++) {
+        saidaLista = NovaSaida(saidaLista);
+        OpcoesExportacao exportacao;
+        memset(&exportacao, 0, sizeof(OpcoesExportacao));
+        exportacao.interferencias.numThreads = numThreads;
+        exportacao.seccoes[SECCAO_INTERSECOES] = (DestinoExportacao){ (FormatoExportacao)f, saidaLista };
+        exportacao.seccoes[SECCAO_INTERFERENCIAS] = (DestinoExportacao){ (FormatoExportacao)f, saidaLista };
+        t0 = Agora();
+        int estadoExportacao = ExportarResultados(&grafo, &exportacao);
+        printf(" %s %.3f ms %ld bytes%s", nomesFormatos[f - EXPORTAR_TEXTO], (Agora() - t0) * 1e3, ftell(saidaLista),
+            estadoExportacao == 0 ? "" : " (FALHOU)");
+    }
+    printf("\n");
+    printf("caminhos exportados: procura interrompida assinalada em todos os formatos, %s\n",
+        Estado(ConferirCaminhosInterrompidos()));
+
+    //Relatrio: uma seco a uma contra as seces em paralelo (os ficheiros tm de ser iguais),
+    //e s a seco das interferncias
+    const char* nomesRelatorio[] = { "benchmark_relatorio_1.txt", "benchmark_relatorio_n.txt", "benchmark_relatorio_s.txt" };
+    OpcoesRelatorio relatorio;
+    memset(&relatorio, 0, sizeof(OpcoesRelatorio));
+    relatorio.analises = ANALISE_TODAS | ANALISE_COMPONENTES;
+    relatorio.interferencias.numThreads = numThreads;
+    relatorio.numThreads = 1;
+    t0 = Agora();
+    ResultadosOpcoes(&grafo, nomesRelatorio[0], &relatorio, NULL);
+    double tSequencial = Agora() - t0;
+    relatorio.numThreads = numThreads;
+    t0 = Agora();
+    ResultadosOpcoes(&grafo, nomesRelatorio[1], &relatorio, NULL);
+    double tParalelo = Agora() - t0;
+    relatorio.analises = ANALISE_INTERFERENCIAS;
+    t0 = Agora();
+    ResultadosOpcoes(&grafo, nomesRelatorio[2], &relatorio, NULL);
+    double tSeccao = Agora() - t0;
+    FILE* relatorioSequencial = fopen(nomesRelatorio[0], "rb");
+    FILE* relatorioParalelo = fopen(nomesRelatorio[1], "rb");
+    printf("relatorio: seccoes uma a uma %.3f ms, em paralelo %.3f ms (x%.2f), so interferencias %.3f ms, %s\n",
+        tSequencial * 1e3, tParalelo * 1e3, tParalelo > 0 ? tSequencial / tParalelo : 0.0, tSeccao * 1e3,
+        Estado(relatorioSequencial && relatorioParalelo && MesmoConteudo(relatorioSequencial, relatorioParalelo)));
+    if (relatorioSequencial) fclose(relatorioSequencial);
+    if (relatorioParalelo) fclose(relatorioParalelo);
+    for (int i = 0; i < 3; i++) remove(nomesRelatorio[i]);
+
+    //Consultas por zona: rvore espacial contra pesquisa linear
+    t0 = Agora();
+    ConstruirArvoreEspacial(&grafo);
+    double tArvoreConstruir = Agora() - t0;
+    double tArvore = 0, tLinear = 0;
+    bool consultasIguais = ConferirConsultas(&grafo, largura, altura, numFrequencias, 3000, &tArvore, &tLinear);
+    printf("arvore espacial: construir %.3f ms (%d nos), 3000 consultas %.3f ms, linear %.3f ms (x%.1f), %s\n",
+        tArvoreConstruir * 1e3, grafo.arvore ? grafo.arvore->totalNos : 0, tArvore * 1e3, tLinear * 1e3,
+        tArvore > 0 ? tLinear / tArvore : 0.0, Estado(consultasIguais));
+
+    //Alteraes em lote contra as mesmas alteraes uma a uma, em duas cpias do grafo
+    int totalAlteracoes = grafo.totalAntenas;
+    Alteracao* alteracoes = malloc(totalAlteracoes * sizeof(Alteracao));
+    int* estados = malloc(totalAlteracoes * sizeof(int));
+    Grafo umaAUma = { 0 }, emLote = { 0 };
+    if (alteracoes && estados && ReconstruirGrafo(&csr, &umaAUma) == 0 && ReconstruirGrafo(&csr, &emLote) == 0) {
+        //As rvores espaciais so construdas antes das alteraes, para serem conferidas depois delas
+        ConstruirArvoreEspacial(&umaAUma);
+        ConstruirArvoreEspacial(&emLote);
+        unsigned long long estado = 2463534242ULL;
+        for (int i = 0; i < totalAlteracoes; i++) {
+            estado ^= estado << 13; estado ^= estado >> 7; estado ^= estado << 17;
+            Alteracao* alteracao = &alteracoes[i];
+            int sorteio = (int)(estado % 10);
+            alteracao->tipo = sorteio < 4 ? INSERIR_ANTENA : sorteio < 6 ? REMOVER_ANTENA : sorteio < 9 ? INSERIR_LIGACAO : REMOVER_LIGACAO;
+            alteracao->frequencia = (char)('A' + (estado >> 8) % numFrequencias);
+            alteracao->coluna = (int)((estado >> 16) % largura);
+            alteracao->linha = (int)((estado >> 32) % altura);
+            alteracao->colunaDestino = (int)((estado >> 24) % largura);
+            alteracao->linhaDestino = (int)((estado >> 40) % altura);
+            alteracao->verificarRepetidos = (estado >> 60) & 1;
+        }
+        t0 = Agora();
+        AplicarUmaAUma(&umaAUma, alteracoes, totalAlteracoes);
+        double tUmaAUma = Agora() - t0;
+        t0 = Agora();
+        int falhas = AplicarAlteracoes(&emLote, alteracoes, totalAlteracoes, estados);
+        double tLote = Agora() - t0;
+        EstatisticasArena arenaUmaAUma, arenaLote;
+        EstatisticasDoGrafo(&umaAUma, &arenaUmaAUma);
+        EstatisticasDoGrafo(&emLote, &arenaLote);
+        printf("alteracoes: %d (%d falharam), uma a uma %.3f ms, em lote %.3f ms (x%.2f), %s\n",
+            totalAlteracoes, falhas, tUmaAUma * 1e3, tLote * 1e3, tLote > 0 ? tUmaAUma / tLote : 0.0,
+            Estado(MesmoGrafo(&umaAUma, &emLote) && arenaUmaAUma.nosEmUso[NO_ADJACENCIA] == arenaLote.nosEmUso[NO_ADJACENCIA]));
+
+        double tArvore = 0, tLinear = 0;
+        bool consultasIguais = ConferirConsultas(&umaAUma, largura, altura, numFrequencias, 300, &tArvore, &tLinear) &&
+            ConferirConsultas(&emLote, largura, altura, numFrequencias, 300, &tArvore, &tLinear);
+        printf("arvore espacial depois das alteracoes: %d nos, %s\n", umaAUma.arvore ? umaAUma.arvore->totalNos : 0,
+            Estado(consultasIguais));
+    }
+    free(alteracoes);
+    free(estados);
+    LibertarGrafo(&umaAUma);
+    LibertarGrafo(&emLote);
+
+    fclose(saidaLista);
+    fclose(saidaCSR);
+    LibertarGrafoCSR(&csr);
+    LibertarGrafo(&grafo);
+    remove(nomeGrelha);
+    if (totalDiferentes > 0) fprintf(stderr, "%d comparacoes deram DIFERENTE\n", totalDiferentes);
+    return totalDiferentes > 0;
+}
+#pragma endregion
@@ -0,0 +1,151 @@
+/*****************************************************************//**
+ * \file   buffertexto.c
+ * \brief  Buffer de texto que cresce conforme  preciso.
+ *
+ * Serve para formatar resultados em memria (por exemplo, um por thread)
+ * e escrev-los depois no ficheiro de uma s vez. Os inteiros e as coordenadas
+ * so convertidos  mo, sem passar pelo printf, por FormatarInteiro e
+ * FormatarCoordenada, que tambm servem o EscritorTexto.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "antenas.h"
+
+#define CAPACIDADE_BUFFER_INICIAL 4096
+
+#pragma region Formatar
+/**
+ * Funo para converter valor para decimal nos bytes que acabam em fim (igual a "%lld").
+ *
+ * @param fim --> Posio a seguir ao ltimo dgito (h de haver pelo menos 20 bytes antes).
+ * @param valor --> Valor a converter.
+ * @param resto --> Valor sem sinal, para o menor long long tambm funcionar.
+ * @param return --> Posio onde comea o texto.
+ */
+char* FormatarInteiro(char* fim, long long valor) {
+    unsigned long long resto = valor < 0 ? 0ULL - (unsigned long long)valor : (unsigned long long)valor;
+    do {
+        *--fim = (char)('0' + resto % 10);
+        resto /= 10;
+    } while (resto);
+    if (valor < 0) *--fim = '-';
+    return fim;
+}
+
+/**
+ * Funo para converter uma coordenada para "(coluna,linha)" (igual a "(%d,%d)") nos bytes
+ * que acabam em fim, do fim para o incio.
+ *
+ * @param fim --> Posio a seguir ao ')' (h de haver pelo menos TAMANHO_COORDENADA bytes antes).
+ * @param coluna --> Coluna (X).
+ * @param linha --> Linha (Y).
+ * @param return --> Posio onde comea o texto.
+ */
+char* FormatarCoordenada(char* fim, int coluna, int linha) {
+    *--fim = ')';
+    fim = FormatarInteiro(fim, linha);
+    *--fim = ',';
+    fim = FormatarInteiro(fim, coluna);
+    *--fim = '(';
+    return fim;
+}
+#pragma endregion
+
+#pragma region GarantirEspaco
+/**
+ * Funo para garantir que cabem mais extra bytes no buffer.
+ *
+ * @param buffer --> Apontador para o buffer.
+ * @param extra --> Nmero de bytes que vo ser acrescentados.
+ * @param novaCapacidade --> Capacidade depois de crescer (duplica at chegar).
+ * @param return --> 0 se h espao, -2 se falhar a alocao.
+ */
+int GarantirEspaco(BufferTexto* buffer, size_t extra) {
+    if (buffer->tamanho + extra <= buffer->capacidade) return 0;
+
+    size_t novaCapacidade = buffer->capacidade ? buffer->capacidade : CAPACIDADE_BUFFER_INICIAL;
+    while (novaCapacidade < buffer->tamanho + extra) novaCapacidade *= 2;
+
+    char* novos = realloc(buffer->dados, novaCapacidade);
+    if (!novos) return -2;
+    buffer->dados = novos;
+    buffer->capacidade = novaCapacidade;
+    return 0;
+}
+#pragma endregion
+
+#pragma region AcrescentarTexto
+/**
+ * Funo para acrescentar bytes ao fim do buffer.
+ *
+ * @param buffer --> Apontador para o buffer.
+ * @param texto --> Bytes a acrescentar.
+ * @param tamanho --> Nmero de bytes.
+ * @param return --> 0 se o texto foi acrescentado, -2 se falhar a alocao.
+ */
+int AcrescentarTexto(BufferTexto* buffer, const char* texto, size_t tamanho) {
+    if (GarantirEspaco(buffer, tamanho) != 0) return -2;
+    memcpy(buffer->dados + buffer->tamanho, texto, tamanho);
+    buffer->tamanho += tamanho;
+    return 0;
+}
+
+/**
+ * Funo para acrescentar um carcter ao fim do buffer.
+ *
+ * @param buffer --> Apontador para o buffer.
+ * @param c --> Carcter a acrescentar.
+ * @param return --> 0 se o carcter foi acrescentado, -2 se falhar a alocao.
+ */
+int AcrescentarCaracter(BufferTexto* buffer, char c) {
+    if (GarantirEspaco(buffer, 1) != 0) return -2;
+    buffer->dados[buffer->tamanho++] = c;
+    return 0;
+}
+
+/**
+ * Funo para acrescentar um inteiro em decimal (igual a "%d" / "%lld").
+ *
+ * @param buffer --> Apontador para o buffer.
+ * @param valor --> Valor a escrever.
+ * @param digitos --> Dgitos do valor, escritos do fim para o incio.
+ * @param return --> 0 se o inteiro foi acrescentado, -2 se falhar a alocao.
+ */
+int AcrescentarInteiro(BufferTexto* buffer, long long valor) {
+    char digitos[24];
+    char* inicio = FormatarInteiro(digitos + sizeof(digitos), valor);
+    return AcrescentarTexto(buffer, inicio, digitos + sizeof(digitos) - inicio);
+}
+#pragma endregion
+
+#pragma region EscreverBuffer
+/**
+ * Funo para escrever o contedo do buffer num ficheiro.
+ *
+ * @param buffer --> Apontador para o buffer.
+ * @param saida --> Ficheiro de destino.
+ * @param return --> 0 se foi tudo escrito, -1 se os argumentos forem nulos, -3 se a escrita falhar.
+ */
+int EscreverBuffer(const BufferTexto* buffer, FILE* saida) {
+    if (!buffer || !saida) return -1;
+    if (buffer->tamanho == 0) return 0;
+    return fwrite(buffer->dados, 1, buffer->tamanho, saida) == buffer->tamanho ? 0 : -3;
+}
+#pragma endregion
+
+#pragma region LibertarBuffer
+/**
+ * Funo para libertar a memria de um buffer (fica vazio e pode voltar a ser usado).
+ *
+ * @param buffer --> Apontador para o buffer.
+ * @param return --> 0 se foi libertado, -1 se for nulo.
+ */
+int LibertarBuffer(BufferTexto* buffer) {
+    if (!buffer) return -1;
+    free(buffer->dados);
+    memset(buffer, 0, sizeof(BufferTexto));
+    return 0;
+}
+#pragma endregion
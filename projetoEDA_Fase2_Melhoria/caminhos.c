@@ -0,0 +1,608 @@
+/*****************************************************************//**
+ * \file   caminhos.c
+ * \brief  Procura de caminhos entre duas antenas, com limites.
+ *
+ * Enumerar todos os caminhos simples cresce de forma exponencial (numa
+ * frequncia com k antenas h da ordem de k! caminhos), por isso a procura
+ * tem vrios modos: o caminho mais curto (procura em largura), os k caminhos
+ * mais curtos (algoritmo de Yen), a contagem de caminhos simples (enumerados
+ * sem serem entregues), a contagem de passeios at um comprimento mximo (sem
+ * enumerar) e a enumerao de caminhos simples, limitadas em nmero de
+ * caminhos, profundidade e tempo. Os caminhos so entregues um a
+ * um a um callback. O estado de cada procura fica em vetores indexados pelo
+ * id das antenas, por isso a marca visitada das antenas no  usada.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include <limits.h>
+#include "antenas.h"
+
+//O relgio s  consultado a cada PASSOS_ENTRE_RELOGIO passos da enumerao
+#define PASSOS_ENTRE_RELOGIO 1024
+
+/**
+ * Estado partilhado pelos modos de uma procura.
+ * @param grafo --> Grafo onde se procura.
+ * @param consulta --> Consulta a responder.
+ * @param resultado --> Resultado a preencher.
+ * @param n --> Nmero de ids do grafo (tamanho dos vetores por antena).
+ * @param fimTempo --> Instante (TempoAtual) em que a procura tem de parar, 0 se no houver limite.
+ * @param passos --> Passos dados desde o incio, para espaar a consulta do relgio.
+ * @param caminho --> Antenas do caminho entregue ao callback.
+ */
+typedef struct ProcuraCaminhos {
+    Grafo* grafo;
+    const ConsultaCaminhos* consulta;
+    ResultadoCaminhos* resultado;
+    int n;
+    double fimTempo;
+    unsigned int passos;
+    Antena** caminho;
+} ProcuraCaminhos;
+
+#pragma region Limites
+/**
+ * Confirma se o tempo da procura acabou. Sem verificarJa, o relgio s  lido de
+ * PASSOS_ENTRE_RELOGIO em PASSOS_ENTRE_RELOGIO chamadas.
+ */
+static bool TempoEsgotado(ProcuraCaminhos* p, bool verificarJa) {
+    if (p->fimTempo <= 0) return false;
+    if (!verificarJa && (++p->passos % PASSOS_ENTRE_RELOGIO) != 0) return false;
+    if (TempoAtual() < p->fimTempo) return false;
+    p->resultado->esgotouTempo = true;
+    p->resultado->truncado = true;
+    return true;
+}
+
+/**
+ * Entrega ao callback o caminho guardado em p->caminho. ultimo indica que a procura
+ * acaba neste caminho de qualquer forma (no conta como truncada).
+ * Devolve verdadeiro se a procura deve parar (o callback pediu ou chegou a maxCaminhos).
+ */
+static bool EntregarCaminho(ProcuraCaminhos* p, int comprimento, bool ultimo) {
+    const ConsultaCaminhos* consulta = p->consulta;
+    p->resultado->caminhos++;
+    if (consulta->modo != CAMINHOS_CONTAR && consulta->callback && consulta->callback(p->caminho, comprimento, consulta->contexto) != 0) return true;
+    if (!ultimo && consulta->limites.maxCaminhos > 0 && p->resultado->caminhos >= consulta->limites.maxCaminhos) {
+        p->resultado->truncado = true;
+        return true;
+    }
+    return false;
+}
+
+static bool ExcedeProfundidade(const ProcuraCaminhos* p, int ligacoes) {
+    return p->consulta->limites.maxProfundidade > 0 && ligacoes > p->consulta->limites.maxProfundidade;
+}
+#pragma endregion
+
+#pragma region ProcuraEmLargura
+/**
+ * Procura em largura de origem at destino, sobre os ids das antenas.
+ * As antenas com bloqueadas[id] e as ligaes origem -> w com arestaBloqueada[w]
+ * so ignoradas (qualquer dos vetores pode ser NULL). Cada balde de frequncia s
+ *  percorrido uma vez: depois disso todas as antenas dele j foram encontradas.
+ * A exceo  a origem, porque as suas ligaes bloqueadas no podem impedir que
+ * as outras antenas da mesma frequncia cheguem a essas antenas.
+ * Escreve os ids do caminho em caminho e devolve o nmero de antenas (0 se o destino
+ * no for alcanvel).
+ */
+static int ProcuraEmLargura(ProcuraCaminhos* p, int origem, int destino,
+    const bool* bloqueadas, const bool* arestaBloqueada, int* pai, int* fila, int* caminho) {
+    Grafo* grafo = p->grafo;
+    bool baldeExpandido[NUM_FREQUENCIAS] = { false };
+
+    //pai: -2 ainda no encontrada, -1 origem
+    for (int i = 0; i < p->n; i++) pai[i] = -2;
+    pai[origem] = -1;
+    int frente = 0, tras = 0;
+    fila[tras++] = origem;
+
+    while (frente < tras && pai[destino] == -2) {
+        int v = fila[frente++];
+        Antena* antena = grafo->porId[v];
+
+        for (Adjacencia* adj = antena->ligacoes; adj != NULL; adj = adj->proxima) {
+            int w = adj->destino->id;
+            if (pai[w] != -2 || (bloqueadas && bloqueadas[w])) continue;
+            if (v == origem && arestaBloqueada && arestaBloqueada[w]) continue;
+            pai[w] = v;
+            fila[tras++] = w;
+        }
+
+        int f = (unsigned char)antena->frequencia;
+        if (!grafo->baldes || baldeExpandido[f]) continue;
+        if (v != origem) baldeExpandido[f] = true;
+        BaldeFrequencia* balde = &grafo->baldes[f];
+        for (int i = 0; i < balde->total; i++) {
+            int w = balde->antenas[i]->id;
+            if (w == v || pai[w] != -2 || (bloqueadas && bloqueadas[w])) continue;
+            if (v == origem && arestaBloqueada && arestaBloqueada[w]) continue;
+            pai[w] = v;
+            fila[tras++] = w;
+        }
+    }
+    if (pai[destino] == -2) return 0;
+
+    int comprimento = 0;
+    for (int v = destino; v != -1; v = pai[v]) comprimento++;
+    int i = comprimento;
+    for (int v = destino; v != -1; v = pai[v]) caminho[--i] = v;
+    return comprimento;
+}
+#pragma endregion
+
+#pragma region KMaisCurtos
+/**
+ * Caminho guardado pelo algoritmo de Yen (ids das antenas).
+ */
+typedef struct CaminhoGuardado {
+    int* nos;
+    int comprimento;
+} CaminhoGuardado;
+
+typedef struct ListaCaminhos {
+    CaminhoGuardado* itens;
+    int total;
+    int capacidade;
+} ListaCaminhos;
+
+static int CrescerLista(ListaCaminhos* lista) {
+    if (lista->total < lista->capacidade) return 0;
+    int novaCapacidade = lista->capacidade ? lista->capacidade * 2 : 16;
+    CaminhoGuardado* novos = realloc(lista->itens, novaCapacidade * sizeof(CaminhoGuardado));
+    if (!novos) return -2;
+    lista->itens = novos;
+    lista->capacidade = novaCapacidade;
+    return 0;
+}
+
+static int GuardarCaminho(ListaCaminhos* lista, const int* nos, int comprimento) {
+    if (CrescerLista(lista) != 0) return -2;
+    int* copia = malloc(comprimento * sizeof(int));
+    if (!copia) return -2;
+    memcpy(copia, nos, comprimento * sizeof(int));
+    lista->itens[lista->total].nos = copia;
+    lista->itens[lista->total].comprimento = comprimento;
+    lista->total++;
+    return 0;
+}
+
+/**
+ * Passa o caminho na posio indice de origem para o fim de destino, sem alterar a
+ * ordem dos restantes caminhos de origem.
+ */
+static int MoverCaminho(ListaCaminhos* origem, int indice, ListaCaminhos* destino) {
+    if (CrescerLista(destino) != 0) return -2;
+    destino->itens[destino->total++] = origem->itens[indice];
+    memmove(&origem->itens[indice], &origem->itens[indice + 1], (origem->total - indice - 1) * sizeof(CaminhoGuardado));
+    origem->total--;
+    return 0;
+}
+
+static bool ContemCaminho(const ListaCaminhos* lista, const int* nos, int comprimento) {
+    for (int i = 0; i < lista->total; i++) {
+        if (lista->itens[i].comprimento == comprimento &&
+            memcmp(lista->itens[i].nos, nos, comprimento * sizeof(int)) == 0) return true;
+    }
+    return false;
+}
+
+static void LibertarListaCaminhos(ListaCaminhos* lista) {
+    for (int i = 0; i < lista->total; i++) free(lista->itens[i].nos);
+    free(lista->itens);
+    memset(lista, 0, sizeof(ListaCaminhos));
+}
+
+/**
+ * Entrega os k caminhos simples mais curtos de origem a destino, por ordem de comprimento
+ * (algoritmo de Yen). Cada caminho novo  um desvio de um caminho j entregue: para cada
+ * antena do ltimo caminho, procura em largura o caminho mais curto dessa antena ao destino
+ * sem passar pelas antenas anteriores nem pelas ligaes j usadas pelos caminhos com a
+ * mesma raiz. Entre candidatos do mesmo comprimento ganha o que foi encontrado primeiro.
+ *
+ * @param entregues --> Caminhos j entregues (A no algoritmo de Yen).
+ * @param candidatos --> Caminhos por entregar (B no algoritmo de Yen).
+ * @param desvio --> Caminho mais curto da antena de desvio ao destino.
+ * @param candidato --> Raiz do ltimo caminho seguida do desvio.
+ * @param return --> 0 se a procura terminou, -2 se falhar a alocao.
+ */
+static int KMaisCurtos(ProcuraCaminhos* p, int origem, int destino, int k) {
+    int n = p->n;
+    bool* bloqueadas = calloc(n, sizeof(bool));
+    bool* arestaBloqueada = calloc(n, sizeof(bool));
+    int* pai = malloc(n * sizeof(int));
+    int* fila = malloc(n * sizeof(int));
+    int* desvio = malloc(n * sizeof(int));
+    int* candidato = malloc(n * sizeof(int));
+    ListaCaminhos entregues = { 0 }, candidatos = { 0 };
+    int resultado = 0;
+
+    if (!bloqueadas || !arestaBloqueada || !pai || !fila || !desvio || !candidato) {
+        resultado = -2;
+        goto fim;
+    }
+
+    int comprimento = ProcuraEmLargura(p, origem, destino, NULL, NULL, pai, fila, desvio);
+    if (comprimento > 0 && !ExcedeProfundidade(p, comprimento - 1) &&
+        GuardarCaminho(&candidatos, desvio, comprimento) != 0) {
+        resultado = -2;
+        goto fim;
+    }
+
+    while (entregues.total < k && candidatos.total > 0) {
+        //Escolhe o candidato mais curto (o primeiro, em caso de empate) e entrega-o
+        int melhor = 0;
+        for (int i = 1; i < candidatos.total; i++) {
+            if (candidatos.itens[i].comprimento < candidatos.itens[melhor].comprimento) melhor = i;
+        }
+        if (MoverCaminho(&candidatos, melhor, &entregues) != 0) {
+            resultado = -2;
+            goto fim;
+        }
+        const CaminhoGuardado* ultimo = &entregues.itens[entregues.total - 1];
+        for (int i = 0; i < ultimo->comprimento; i++) p->caminho[i] = p->grafo->porId[ultimo->nos[i]];
+        if (EntregarCaminho(p, ultimo->comprimento, entregues.total == k) || entregues.total == k) break;
+
+        //Desvios a partir de cada antena do ltimo caminho (menos o destino)
+        for (int i = 0; i + 1 < ultimo->comprimento; i++) {
+            if (TempoEsgotado(p, true)) goto fim;
+
+            //A raiz (antenas antes do desvio) no pode ser repetida
+            memset(bloqueadas, 0, n * sizeof(bool));
+            memset(arestaBloqueada, 0, n * sizeof(bool));
+            for (int j = 0; j < i; j++) bloqueadas[ultimo->nos[j]] = true;
+            //Nem a ligao seguinte de um caminho j entregue com a mesma raiz
+            for (int c = 0; c < entregues.total; c++) {
+                const CaminhoGuardado* outro = &entregues.itens[c];
+                if (outro->comprimento > i + 1 && memcmp(outro->nos, ultimo->nos, (i + 1) * sizeof(int)) == 0) {
+                    arestaBloqueada[outro->nos[i + 1]] = true;
+                }
+            }
+
+            int tamanhoDesvio = ProcuraEmLargura(p, ultimo->nos[i], destino, bloqueadas, arestaBloqueada, pai, fila, desvio);
+            if (tamanhoDesvio == 0) continue;
+            int total = i + tamanhoDesvio;
+            if (ExcedeProfundidade(p, total - 1)) continue;
+
+            memcpy(candidato, ultimo->nos, i * sizeof(int));
+            memcpy(candidato + i, desvio, tamanhoDesvio * sizeof(int));
+            if (ContemCaminho(&entregues, candidato, total) || ContemCaminho(&candidatos, candidato, total)) continue;
+            if (GuardarCaminho(&candidatos, candidato, total) != 0) {
+                resultado = -2;
+                goto fim;
+            }
+        }
+    }
+
+fim:
+    LibertarListaCaminhos(&entregues);
+    LibertarListaCaminhos(&candidatos);
+    free(bloqueadas); free(arestaBloqueada); free(pai); free(fila); free(desvio); free(candidato);
+    return resultado;
+}
+#pragma endregion
+
+#pragma region ContarPasseios
+static unsigned long long SomarSaturado(unsigned long long a, unsigned long long b, bool* saturado) {
+    if (a > ULLONG_MAX - b) {
+        *saturado = true;
+        return ULLONG_MAX;
+    }
+    return a + b;
+}
+
+/**
+ * Conta os passeios de origem a destino com no mximo maxProfundidade ligaes
+ * (n-1 se no houver limite) que s passam pelo destino no fim, sem os enumerar.
+ * Ao contrrio dos caminhos simples, um passeio pode repetir antenas: contar caminhos
+ * simples no tem soluo eficiente, contar passeios custa O(L * (antenas + ligaes)).
+ * Como na enumerao, cada ligao paralela conta como um passeio diferente.
+ * Se a contagem no couber em unsigned long long fica ULLONG_MAX e o resultado  truncado.
+ *
+ * @param atual --> Nmero de passeios com l ligaes que acabam em cada antena.
+ * @param proximo --> O mesmo para l+1 ligaes.
+ * @param somas --> Soma de atual sobre as antenas de cada frequncia (ligaes pelo balde).
+ * @param return --> 0 se a contagem terminou, -2 se falhar a alocao.
+ */
+static int ContarPasseios(ProcuraCaminhos* p, int origem, int destino) {
+    Grafo* grafo = p->grafo;
+    int n = p->n;
+    int maximo = p->consulta->limites.maxProfundidade > 0 ? p->consulta->limites.maxProfundidade : n - 1;
+    unsigned long long* atual = calloc(n, sizeof(unsigned long long));
+    unsigned long long* proximo = calloc(n, sizeof(unsigned long long));
+    if (!atual || !proximo) {
+        free(atual); free(proximo);
+        return -2;
+    }
+
+    unsigned long long total = 0;
+    bool saturado = false;
+    atual[origem] = 1;
+    for (int l = 0; !saturado; l++) {
+        total = SomarSaturado(total, atual[destino], &saturado);
+        atual[destino] = 0; //Os passeios acabam quando chegam ao destino
+        if (l == maximo || TempoEsgotado(p, true)) break;
+
+        //Soma por frequncia: cada antena do balde f recebe os passeios das outras antenas de f
+        unsigned long long somas[NUM_FREQUENCIAS] = { 0 };
+        bool algum = false;
+        for (int v = 0; v < n; v++) {
+            if (!atual[v]) continue;
+            algum = true;
+            int f = (unsigned char)grafo->porId[v]->frequencia;
+            somas[f] = SomarSaturado(somas[f], atual[v], &saturado);
+        }
+        if (!algum) break;
+
+        memset(proximo, 0, n * sizeof(unsigned long long));
+        for (int v = 0; v < n; v++) {
+            if (!atual[v]) continue;
+            for (Adjacencia* adj = grafo->porId[v]->ligacoes; adj != NULL; adj = adj->proxima) {
+                int w = adj->destino->id;
+                proximo[w] = SomarSaturado(proximo[w], atual[v], &saturado);
+            }
+        }
+        for (int f = 0; grafo->baldes && f < NUM_FREQUENCIAS; f++) {
+            if (!somas[f]) continue;
+            BaldeFrequencia* balde = &grafo->baldes[f];
+            for (int i = 0; i < balde->total; i++) {
+                int w = balde->antenas[i]->id;
+                proximo[w] = SomarSaturado(proximo[w], somas[f] - atual[w], &saturado);
+            }
+        }
+
+        unsigned long long* troca = atual;
+        atual = proximo;
+        proximo = troca;
+    }
+
+    if (saturado) {
+        total = ULLONG_MAX;
+        p->resultado->truncado = true;
+    }
+    p->resultado->contagem = total;
+    free(atual);
+    free(proximo);
+    return 0;
+}
+#pragma endregion
+
+#pragma region TodosCaminhos
+/**
+ * Calcula, para cada antena, o menor nmero de ligaes at ao destino (-1 se no chegar),
+ * com uma procura em largura no sentido contrrio das ligaes. As ligaes explcitas
+ * so invertidas num vetor local; as do balde so simtricas, mas partem de qualquer antena
+ * da frequncia e chegam s s antenas que esto no balde.
+ *
+ * @param inicioEntradas --> Para a antena w, as antenas com ligao para w esto em
+ *                           entradas[inicioEntradas[w]..inicioEntradas[w+1]-1].
+ * @param porFrequencia --> Ids agrupados por frequncia, com o incio de cada uma em inicioFrequencia.
+ * @param noBalde --> Se a antena est no balde da sua frequncia.
+ * @param return --> 0 se as distncias foram calculadas, -2 se falhar a alocao.
+ */
+static int DistanciasAteDestino(ProcuraCaminhos* p, int destino, int* distancia) {
+    Grafo* grafo = p->grafo;
+    int n = p->n;
+    int totalEntradas = 0;
+    for (int v = 0; v < n; v++) {
+        if (!grafo->porId[v]) continue;
+        for (Adjacencia* adj = grafo->porId[v]->ligacoes; adj != NULL; adj = adj->proxima) totalEntradas++;
+    }
+
+    int* inicioEntradas = calloc(n + 1, sizeof(int));
+    int* entradas = malloc((totalEntradas > 0 ? totalEntradas : 1) * sizeof(int));
+    int* porFrequencia = malloc((n > 0 ? n : 1) * sizeof(int));
+    bool* noBalde = calloc(n > 0 ? n : 1, sizeof(bool));
+    int* fila = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!inicioEntradas || !entradas || !porFrequencia || !noBalde || !fila) {
+        free(inicioEntradas); free(entradas); free(porFrequencia); free(noBalde); free(fila);
+        return -2;
+    }
+
+    int inicioFrequencia[NUM_FREQUENCIAS + 1] = { 0 };
+    for (int v = 0; v < n; v++) {
+        Antena* antena = grafo->porId[v];
+        if (!antena) continue;
+        inicioFrequencia[(unsigned char)antena->frequencia + 1]++;
+        for (Adjacencia* adj = antena->ligacoes; adj != NULL; adj = adj->proxima) inicioEntradas[adj->destino->id + 1]++;
+    }
+    for (int v = 0; v < n; v++) inicioEntradas[v + 1] += inicioEntradas[v];
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) inicioFrequencia[f + 1] += inicioFrequencia[f];
+
+    //Preenche os vetores avanando uma cpia dos incios
+    int* posicaoEntradas = distancia;
+    memcpy(posicaoEntradas, inicioEntradas, n * sizeof(int));
+    int posicaoFrequencia[NUM_FREQUENCIAS];
+    memcpy(posicaoFrequencia, inicioFrequencia, sizeof(posicaoFrequencia));
+    for (int v = 0; v < n; v++) {
+        Antena* antena = grafo->porId[v];
+        if (!antena) continue;
+        porFrequencia[posicaoFrequencia[(unsigned char)antena->frequencia]++] = v;
+        for (Adjacencia* adj = antena->ligacoes; adj != NULL; adj = adj->proxima) {
+            entradas[posicaoEntradas[adj->destino->id]++] = v;
+        }
+    }
+    for (int f = 0; grafo->baldes && f < NUM_FREQUENCIAS; f++) {
+        for (int i = 0; i < grafo->baldes[f].total; i++) noBalde[grafo->baldes[f].antenas[i]->id] = true;
+    }
+
+    //Procura em largura a partir do destino; cada frequncia s  percorrida uma vez
+    bool frequenciaExpandida[NUM_FREQUENCIAS] = { false };
+    for (int v = 0; v < n; v++) distancia[v] = -1;
+    distancia[destino] = 0;
+    int frente = 0, tras = 0;
+    fila[tras++] = destino;
+    while (frente < tras) {
+        int w = fila[frente++];
+        for (int k = inicioEntradas[w]; k < inicioEntradas[w + 1]; k++) {
+            int v = entradas[k];
+            if (distancia[v] != -1) continue;
+            distancia[v] = distancia[w] + 1;
+            fila[tras++] = v;
+        }
+
+        int f = (unsigned char)grafo->porId[w]->frequencia;
+        if (!noBalde[w] || frequenciaExpandida[f]) continue;
+        frequenciaExpandida[f] = true;
+        for (int k = inicioFrequencia[f]; k < inicioFrequencia[f + 1]; k++) {
+            int v = porFrequencia[k];
+            if (distancia[v] != -1) continue;
+            distancia[v] = distancia[w] + 1;
+            fila[tras++] = v;
+        }
+    }
+
+    free(inicioEntradas); free(entradas); free(porFrequencia); free(noBalde); free(fila);
+    return 0;
+}
+
+/**
+ * Entrega os caminhos simples de origem a destino pela mesma ordem da antiga procura
+ * recursiva (procura em profundidade, vizinhos pela ordem de IteradorVizinhos), mas com
+ * uma pilha explcita de iteradores. No entra em antenas que j no chegam ao destino
+ * dentro de maxProfundidade ligaes, o que no altera os caminhos encontrados; mesmo
+ * assim o nmero de caminhos pode ser exponencial, por isso os limites devem ser usados.
+ *
+ * @param distancia --> Menor nmero de ligaes de cada antena ao destino.
+ * @param visitadas --> Antenas no caminho atual.
+ * @param pilha --> Iterador dos vizinhos de cada antena do caminho atual.
+ * @param return --> 0 se a procura terminou ou parou num limite, -2 se falhar a alocao.
+ */
+static int TodosCaminhos(ProcuraCaminhos* p, Antena* origem, Antena* destino) {
+    int n = p->n;
+    int maximo = p->consulta->limites.maxProfundidade > 0 ? p->consulta->limites.maxProfundidade : n;
+    int* distancia = malloc(n * sizeof(int));
+    bool* visitadas = calloc(n, sizeof(bool));
+    IteradorVizinhos* pilha = malloc(n * sizeof(IteradorVizinhos));
+    int resultado = 0;
+    if (!distancia || !visitadas || !pilha || DistanciasAteDestino(p, destino->id, distancia) != 0) {
+        resultado = -2;
+        goto fim;
+    }
+    if (distancia[origem->id] < 0 || distancia[origem->id] > maximo) goto fim;
+
+    p->caminho[0] = origem;
+    if (origem == destino) {
+        EntregarCaminho(p, 1, true);
+        goto fim;
+    }
+
+    int topo = 0;
+    visitadas[origem->id] = true;
+    IniciarVizinhos(p->grafo, origem, &pilha[0]);
+    while (topo >= 0) {
+        if (TempoEsgotado(p, false)) break;
+
+        Antena* vizinho = ProximoVizinho(&pilha[topo]);
+        if (!vizinho) {
+            //Desmarca ao recuar, para permitir outros caminhos por esta antena
+            visitadas[p->caminho[topo]->id] = false;
+            topo--;
+            continue;
+        }
+        int d = distancia[vizinho->id];
+        if (visitadas[vizinho->id] || d < 0 || topo + 1 + d > maximo) continue;
+
+        p->caminho[topo + 1] = vizinho;
+        if (vizinho == destino) {
+            //Chegou ao destino: entrega o caminho e no continua a partir dele
+            if (EntregarCaminho(p, topo + 2, false)) break;
+        }
+        else {
+            topo++;
+            visitadas[vizinho->id] = true;
+            IniciarVizinhos(p->grafo, vizinho, &pilha[topo]);
+        }
+    }
+
+fim:
+    free(distancia);
+    free(visitadas);
+    free(pilha);
+    return resultado;
+}
+
+/**
+ * Conta os caminhos simples de origem a destino com a procura de TodosCaminhos, sem os
+ * entregar ao callback. No h forma eficiente de os contar, por isso o custo  o da
+ * enumerao: maxCaminhos e maxSegundos param a contagem e o resultado fica truncado.
+ *
+ * @param return --> 0 se a contagem terminou ou parou num limite, -2 se falhar a alocao.
+ */
+static int ContarCaminhosSimples(ProcuraCaminhos* p, Antena* origem, Antena* destino) {
+    int estado = TodosCaminhos(p, origem, destino);
+    p->resultado->contagem = (unsigned long long)p->resultado->caminhos;
+    p->resultado->caminhos = 0;
+    return estado;
+}
+#pragma endregion
+
+#pragma region ProcurarCaminhos
+static bool AntenaDoGrafo(const Grafo* grafo, const Antena* antena) {
+    return antena->id >= 0 && antena->id < grafo->totalIds && grafo->porId[antena->id] == antena;
+}
+
+/**
+ * Funo para procurar caminhos entre duas antenas de um grafo.
+ * - CAMINHO_MAIS_CURTO: um caminho com o menor nmero de ligaes.
+ * - CAMINHOS_K_MAIS_CURTOS: os consulta->k caminhos simples mais curtos, por ordem de comprimento.
+ * - CAMINHOS_CONTAR: nmero de caminhos simples at maxProfundidade ligaes em
+ *   resultado->contagem (nenhum caminho  entregue ao callback; custa o mesmo que CAMINHOS_TODOS).
+ * - CAMINHOS_TODOS: todos os caminhos simples, pela ordem da procura em profundidade.
+ * - CAMINHOS_CONTAR_PASSEIOS: nmero de passeios (podem repetir antenas) at maxProfundidade
+ *   ligaes em resultado->contagem, em O(maxProfundidade * (antenas + ligaes)).
+ * Os limites valem para todos os modos; se um deles parar a procura, resultado->truncado fica verdadeiro.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param origem --> Antena de origem.
+ * @param destino --> Antena de destino.
+ * @param consulta --> Modo, limites e callback.
+ * @param resultado --> Apontador para o resultado a preencher.
+ * @param p --> Estado da procura.
+ * @param return --> 0 se a procura terminou (mesmo sem caminhos), -1 se os argumentos forem invlidos,
+ *                   -2 se falhar a alocao.
+ */
+int ProcurarCaminhos(Grafo* grafo, Antena* origem, Antena* destino, const ConsultaCaminhos* consulta, ResultadoCaminhos* resultado) {
+    if (!grafo || !origem || !destino || !consulta || !resultado) return -1;
+    memset(resultado, 0, sizeof(ResultadoCaminhos));
+    if (!AntenaDoGrafo(grafo, origem) || !AntenaDoGrafo(grafo, destino)) return -1;
+    if (consulta->modo == CAMINHOS_K_MAIS_CURTOS && consulta->k <= 0) return -1;
+
+    ProcuraCaminhos p;
+    p.grafo = grafo;
+    p.consulta = consulta;
+    p.resultado = resultado;
+    p.n = grafo->totalIds;
+    p.fimTempo = consulta->limites.maxSegundos > 0 ? TempoAtual() + consulta->limites.maxSegundos : 0;
+    p.passos = 0;
+    p.caminho = malloc((p.n + 1) * sizeof(Antena*));
+    if (!p.caminho) return -2;
+
+    int estado;
+    switch (consulta->modo) {
+    case CAMINHO_MAIS_CURTO:
+        estado = KMaisCurtos(&p, origem->id, destino->id, 1);
+        break;
+    case CAMINHOS_K_MAIS_CURTOS:
+        estado = KMaisCurtos(&p, origem->id, destino->id, consulta->k);
+        break;
+    case CAMINHOS_CONTAR:
+        estado = ContarCaminhosSimples(&p, origem, destino);
+        break;
+    case CAMINHOS_TODOS:
+        estado = TodosCaminhos(&p, origem, destino);
+        break;
+    case CAMINHOS_CONTAR_PASSEIOS:
+        estado = ContarPasseios(&p, origem->id, destino->id);
+        break;
+    default:
+        estado = -1;
+        break;
+    }
+
+    free(p.caminho);
+    return estado;
+}
+#pragma endregion
@@ -0,0 +1,568 @@
+/*****************************************************************//**
+ * \file   carregamento.c
+ * \brief  Leitura rpida de ficheiros de antenas atravs de mapeamento em memria.
+ *
+ * O ficheiro  mapeado (mmap / MapViewOfFile) e as linhas so percorridas
+ * diretamente na memria mapeada, sem limite de largura. Dentro de cada linha
+ * as clulas diferentes de '.' so encontradas 16 bytes de cada vez (SSE2),
+ * com uma verso escalar para as restantes plataformas. Ficheiros grandes podem
+ * ser lidos por vrias threads, cada uma com o seu troo de linhas.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include <time.h>
+#include "antenas.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CARREGAMENTO_SSE2 1
+#endif
+
+#define TAMANHO_BLOCO_LEITURA (1 << 20)
+#define MINIMO_BYTES_TROCO (256 * 1024)
+
+#pragma region TempoAtual
+/**
+ * Funo para obter o tempo de relgio atual em segundos.
+ *
+ * @return Segundos desde uma origem fixa (s serve para medir intervalos).
+ */
+double TempoAtual(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+#pragma endregion
+
+#pragma region MapearFicheiro
+/**
+ * Funo para mapear um ficheiro inteiro em memria, s para leitura.
+ * Se o mapeamento no for possvel (ficheiro vazio, sistema sem suporte) o ficheiro
+ *  lido para memria em blocos grandes.
+ *
+ * @param nomeFicheiro --> Nome do ficheiro a mapear.
+ * @param mapa --> Apontador para a estrutura a preencher.
+ * @param return --> 0 se o ficheiro ficou disponvel, -1 se os argumentos forem nulos,
+ *                   -2 se no for possvel abrir ou ler o ficheiro.
+ */
+int MapearFicheiro(const char* nomeFicheiro, FicheiroMapeado* mapa) {
+    if (!nomeFicheiro || !mapa) return -1;
+    memset(mapa, 0, sizeof(FicheiroMapeado));
+
+#ifdef _WIN32
+    HANDLE ficheiro = CreateFileA(nomeFicheiro, GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (ficheiro == INVALID_HANDLE_VALUE) return -2;
+
+    LARGE_INTEGER tamanho;
+    if (GetFileSizeEx(ficheiro, &tamanho) && tamanho.QuadPart > 0) {
+        HANDLE vista = CreateFileMappingA(ficheiro, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (vista) {
+            const char* dados = MapViewOfFile(vista, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(vista);
+            if (dados) {
+                CloseHandle(ficheiro);
+                mapa->dados = dados;
+                mapa->tamanho = (size_t)tamanho.QuadPart;
+                mapa->mapeado = true;
+                return 0;
+            }
+        }
+    }
+    CloseHandle(ficheiro);
+#else
+    int descritor = open(nomeFicheiro, O_RDONLY);
+    if (descritor < 0) return -2;
+
+    struct stat info;
+    if (fstat(descritor, &info) == 0 && info.st_size > 0) {
+        void* dados = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, descritor, 0);
+        if (dados != MAP_FAILED) {
+            madvise(dados, (size_t)info.st_size, MADV_SEQUENTIAL);
+            close(descritor);
+            mapa->dados = dados;
+            mapa->tamanho = (size_t)info.st_size;
+            mapa->mapeado = true;
+            return 0;
+        }
+    }
+    close(descritor);
+#endif
+
+    //Alternativa: ler o ficheiro todo para memria em blocos de TAMANHO_BLOCO_LEITURA
+    FILE* ficheiroLido = fopen(nomeFicheiro, "rb");
+    if (!ficheiroLido) return -2;
+
+    size_t capacidade = TAMANHO_BLOCO_LEITURA, total = 0;
+    char* buffer = malloc(capacidade);
+    while (buffer) {
+        size_t lidos = fread(buffer + total, 1, capacidade - total, ficheiroLido);
+        total += lidos;
+        if (total < capacidade) break;
+
+        char* maior = realloc(buffer, capacidade * 2);
+        if (!maior) {
+            free(buffer);
+            buffer = NULL;
+            break;
+        }
+        buffer = maior;
+        capacidade *= 2;
+    }
+    fclose(ficheiroLido);
+    if (!buffer) return -2;
+
+    mapa->dados = buffer;
+    mapa->tamanho = total;
+    mapa->mapeado = false;
+    return 0;
+}
+#pragma endregion
+
+#pragma region DesmapearFicheiro
+/**
+ * Funo para libertar um ficheiro mapeado com MapearFicheiro.
+ *
+ * @param mapa --> Apontador para o ficheiro mapeado.
+ * @param return --> 0 se foi libertado, -1 se o argumento for nulo.
+ */
+int DesmapearFicheiro(FicheiroMapeado* mapa) {
+    if (!mapa) return -1;
+
+    if (mapa->dados) {
+        if (mapa->mapeado) {
+#ifdef _WIN32
+            UnmapViewOfFile(mapa->dados);
+#else
+            munmap((void*)mapa->dados, mapa->tamanho);
+#endif
+        }
+        else {
+            free((void*)mapa->dados);
+        }
+    }
+    memset(mapa, 0, sizeof(FicheiroMapeado));
+    return 0;
+}
+#pragma endregion
+
+#pragma region LoteAntenas
+/**
+ * Funo para acrescentar uma antena lida a um lote.
+ *
+ * @param lote --> Apontador para o lote.
+ * @param freq --> Frequncia da antena.
+ * @param coluna --> Coluna da antena.
+ * @param linha --> Linha da antena.
+ * @param return --> 0 se a antena foi acrescentada, -2 se falhar a alocao.
+ */
+int AcrescentarAoLote(LoteAntenas* lote, char freq, int coluna, int linha) {
+    if (lote->total == lote->capacidade) {
+        int novaCapacidade = lote->capacidade ? lote->capacidade * 2 : 1024;
+        RegistoAntena* novos = realloc(lote->registos, novaCapacidade * sizeof(RegistoAntena));
+        if (!novos) return -2;
+        lote->registos = novos;
+        lote->capacidade = novaCapacidade;
+    }
+    RegistoAntena* registo = &lote->registos[lote->total++];
+    registo->frequencia = freq;
+    registo->coluna = coluna;
+    registo->linha = linha;
+    return 0;
+}
+
+/**
+ * Funo para libertar a memria de um lote de antenas.
+ *
+ * @param lote --> Apontador para o lote.
+ * @param return --> 0 se o lote foi libertado, -1 se for nulo.
+ */
+int LibertarLote(LoteAntenas* lote) {
+    if (!lote) return -1;
+    free(lote->registos);
+    memset(lote, 0, sizeof(LoteAntenas));
+    return 0;
+}
+#pragma endregion
+
+#pragma region AnalisarLinha
+/**
+ * ndice do bit menos significativo ligado (mascara != 0).
+ */
+static int PrimeiroBit(unsigned int mascara) {
+#if defined(_MSC_VER)
+    unsigned long indice;
+    _BitScanForward(&indice, mascara);
+    return (int)indice;
+#else
+    return __builtin_ctz(mascara);
+#endif
+}
+
+/**
+ * Guarda uma clula se ela for uma antena (nem '.', nem espao, nem fim de linha).
+ */
+static int GuardarCelula(LoteAntenas* lote, char c, int x, int y) {
+    if (c == '.' || c == ' ' || c == '\r' || c == '\n' || c == '\0') return 0;
+    return AcrescentarAoLote(lote, c, x, y);
+}
+
+/**
+ * Percorre uma linha (sem o '\n') e guarda no lote todas as antenas com coluna < largura.
+ */
+static int AnalisarLinha(const char* linha, int largura, int y, LoteAntenas* lote) {
+    int x = 0;
+#ifdef CARREGAMENTO_SSE2
+    const __m128i ponto = _mm_set1_epi8('.');
+    for (; x + 16 <= largura; x += 16) {
+        __m128i bloco = _mm_loadu_si128((const __m128i*)(linha + x));
+        unsigned int diferentes = (~(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bloco, ponto))) & 0xFFFFu;
+        while (diferentes) {
+            int i = PrimeiroBit(diferentes);
+            if (GuardarCelula(lote, linha[x + i], x + i, y) != 0) return -2;
+            diferentes &= diferentes - 1;
+        }
+    }
+#endif
+    for (; x < largura; x++) {
+        if (linha[x] != '.' && GuardarCelula(lote, linha[x], x, y) != 0) return -2;
+    }
+    return 0;
+}
+#pragma endregion
+
+#pragma region AnalisarGrelha
+/**
+ * Funo para extrair as antenas de um troo de grelha j em memria.
+ * Cada linha termina em '\n' (a ltima pode no ter); um '\r' final  ignorado.
+ *
+ * @param dados --> Incio do troo (primeira clula de uma linha).
+ * @param tamanho --> Nmero de bytes do troo.
+ * @param linhaInicial --> Nmero (y) da primeira linha do troo.
+ * @param maxLinhas --> Nmero mximo de linhas a ler (negativo para no limitar).
+ * @param maxColunas --> Nmero mximo de colunas por linha (negativo para no limitar).
+ * @param lote --> Lote onde as antenas so acrescentadas, por ordem de linha e coluna.
+ * @param return --> Nmero de linhas lidas, ou -2 se falhar a alocao.
+ */
+int AnalisarGrelha(const char* dados, size_t tamanho, int linhaInicial, int maxLinhas, int maxColunas, LoteAntenas* lote) {
+    if (!dados || !lote) return -1;
+
+    const char* atual = dados;
+    const char* fim = dados + tamanho;
+    int linhas = 0;
+
+    while (atual < fim && (maxLinhas < 0 || linhas < maxLinhas)) {
+        const char* fimLinha = memchr(atual, '\n', (size_t)(fim - atual));
+        if (!fimLinha) fimLinha = fim;
+
+        size_t largura = (size_t)(fimLinha - atual);
+        if (largura > 0 && atual[largura - 1] == '\r') largura--;
+        if (maxColunas >= 0 && largura > (size_t)maxColunas) largura = (size_t)maxColunas;
+
+        if (AnalisarLinha(atual, (int)largura, linhaInicial + linhas, lote) != 0) return -2;
+
+        linhas++;
+        atual = fimLinha + 1;
+    }
+    return linhas;
+}
+#pragma endregion
+
+#pragma region LerCabecalho
+/**
+ * L um inteiro no negativo a partir de *pos, saltando espaos antes dele.
+ */
+static bool LerInteiro(const char** pos, const char* fim, int* valor) {
+    const char* p = *pos;
+    while (p < fim && (*p == ' ' || *p == '\t')) p++;
+    if (p >= fim || *p < '0' || *p > '9') return false;
+
+    long long v = 0;
+    while (p < fim && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p - '0');
+        if (v > 0x7FFFFFFF) return false;
+        p++;
+    }
+    *valor = (int)v;
+    *pos = p;
+    return true;
+}
+
+/**
+ * Funo para ler o cabealho "numLinhas numColunas" de um ficheiro de antenas em memria.
+ *
+ * @param dados --> Incio do ficheiro.
+ * @param tamanho --> Tamanho do ficheiro.
+ * @param numLinhas --> Onde  guardado o nmero de linhas da grelha.
+ * @param numColunas --> Onde  guardado o nmero de colunas da grelha.
+ * @param return --> Deslocamento da primeira linha da grelha, ou -1 se o cabealho for invlido.
+ */
+long long LerCabecalhoGrelha(const char* dados, size_t tamanho, int* numLinhas, int* numColunas) {
+    const char* p = dados;
+    const char* fim = dados + tamanho;
+    if (!LerInteiro(&p, fim, numLinhas) || !LerInteiro(&p, fim, numColunas)) return -1;
+
+    //Ignora o restante da primeira linha
+    const char* fimLinha = memchr(p, '\n', (size_t)(fim - p));
+    return fimLinha ? (long long)(fimLinha + 1 - dados) : (long long)tamanho;
+}
+#pragma endregion
+
+#pragma region LerGrelhaAntenas
+/**
+ * Troo da grelha lido por uma thread.
+ * @param inicio --> Primeira clula do troo (incio de uma linha).
+ * @param tamanho --> Nmero de bytes do troo.
+ * @param linhas --> Nmero de linhas lidas no troo.
+ * @param lote --> Antenas do troo, com as linhas contadas a partir do incio do troo.
+ */
+typedef struct TrocoGrelha {
+    const char* inicio;
+    size_t tamanho;
+    int linhas;
+    LoteAntenas lote;
+} TrocoGrelha;
+
+/**
+ * Dados partilhados pelas threads de uma leitura.
+ * @param trocos --> Troos a ler, um por tarefa.
+ * @param numColunas --> Nmero mximo de colunas por linha.
+ */
+typedef struct LeituraGrelha {
+    TrocoGrelha* trocos;
+    int numColunas;
+} LeituraGrelha;
+
+/**
+ * Tarefa de cada thread: l um troo para o seu prprio lote.
+ */
+static int AnalisarTroco(int indice, void* contexto) {
+    LeituraGrelha* leitura = contexto;
+    TrocoGrelha* troco = &leitura->trocos[indice];
+    troco->linhas = AnalisarGrelha(troco->inicio, troco->tamanho, 0, -1, leitura->numColunas, &troco->lote);
+    return troco->linhas < 0 ? -2 : 0;
+}
+
+/**
+ * Divide a grelha em numTrocos troos de tamanho parecido, cortados sempre a seguir a um '\n'.
+ */
+static void DividirGrelha(const char* dados, size_t tamanho, int numTrocos, TrocoGrelha* trocos) {
+    const char* fim = dados + tamanho;
+    const char* inicio = dados;
+    for (int i = 0; i < numTrocos; i++) {
+        const char* corte = fim;
+        if (i < numTrocos - 1) {
+            corte = dados + tamanho / numTrocos * (i + 1);
+            if (corte < inicio) corte = inicio;
+            const char* fimLinha = corte < fim ? memchr(corte, '\n', (size_t)(fim - corte)) : NULL;
+            corte = fimLinha ? fimLinha + 1 : fim;
+        }
+        trocos[i].inicio = inicio;
+        trocos[i].tamanho = (size_t)(corte - inicio);
+        inicio = corte;
+    }
+}
+
+/**
+ * Junta os lotes dos troos, pela ordem dos troos, acertando o nmero da linha
+ * e descartando as linhas a partir de maxLinhas.
+ */
+static int JuntarTrocos(TrocoGrelha* trocos, int numTrocos, int maxLinhas, LoteAntenas* lote, int* linhasLidas) {
+    long long total = lote->total;
+    for (int i = 0; i < numTrocos; i++) total += trocos[i].lote.total;
+    if (total > 0x7FFFFFFF) return -2;
+
+    if (total > lote->capacidade) {
+        RegistoAntena* novos = realloc(lote->registos, (size_t)total * sizeof(RegistoAntena));
+        if (!novos) return -2;
+        lote->registos = novos;
+        lote->capacidade = (int)total;
+    }
+
+    int deslocamento = 0;
+    for (int i = 0; i < numTrocos && deslocamento < maxLinhas; i++) {
+        const LoteAntenas* origem = &trocos[i].lote;
+        for (int j = 0; j < origem->total; j++) {
+            int linha = origem->registos[j].linha + deslocamento;
+            if (linha >= maxLinhas) break;
+            RegistoAntena* registo = &lote->registos[lote->total++];
+            *registo = origem->registos[j];
+            registo->linha = linha;
+        }
+        deslocamento += trocos[i].linhas;
+    }
+    *linhasLidas = deslocamento < maxLinhas ? deslocamento : maxLinhas;
+    return 0;
+}
+
+/**
+ * Funo para ler todas as antenas de um ficheiro de grelha para um lote, por ordem de linha e coluna.
+ * A grelha  dividida em troos de linhas inteiras; cada thread l os seus troos para um lote
+ * prprio e no fim os lotes so juntos pela ordem do ficheiro, por isso o resultado  o mesmo
+ * com qualquer nmero de threads.
+ *
+ * @param nomeFicheiro --> Nome do ficheiro de antenas.
+ * @param numThreads --> Nmero de threads (0 ou negativo para usar todos os processadores, 1 para ler sem threads).
+ * @param lote --> Lote onde as antenas so acrescentadas.
+ * @param estatisticas --> Apontador para as estatsticas de leitura (pode ser NULL).
+ * @param mapa --> Ficheiro mapeado em memria.
+ * @param trocos --> Troos da grelha, um por tarefa.
+ * @param return --> 0 se o ficheiro foi lido, -1 se os argumentos forem nulos,
+ *                   -2 se o ficheiro no puder ser lido, -3 se o cabealho for invlido,
+ *                   -4 se falhar a alocao.
+ */
+int LerGrelhaAntenas(const char* nomeFicheiro, int numThreads, LoteAntenas* lote, EstatisticasCarregamento* estatisticas) {
+    if (!nomeFicheiro || !lote) return -1;
+    double inicio = TempoAtual();
+
+    FicheiroMapeado mapa;
+    if (MapearFicheiro(nomeFicheiro, &mapa) != 0) return -2;
+
+    int numLinhas, numColunas;
+    long long deslocamento = LerCabecalhoGrelha(mapa.dados, mapa.tamanho, &numLinhas, &numColunas);
+    if (deslocamento < 0) {
+        DesmapearFicheiro(&mapa);
+        return -3;
+    }
+    const char* grelha = mapa.dados + deslocamento;
+    size_t tamanhoGrelha = mapa.tamanho - (size_t)deslocamento;
+
+    //No vale a pena criar troos com menos de MINIMO_BYTES_TROCO
+    if (numThreads <= 0) numThreads = NumeroProcessadores();
+    size_t maxTrocos = tamanhoGrelha / MINIMO_BYTES_TROCO + 1;
+    int numTrocos = (size_t)numThreads < maxTrocos ? numThreads : (int)maxTrocos;
+
+    int antenasAntes = lote->total;
+    int linhasLidas = 0;
+    int resultado = 0;
+
+    if (numTrocos <= 1) {
+        linhasLidas = AnalisarGrelha(grelha, tamanhoGrelha, 0, numLinhas, numColunas, lote);
+        if (linhasLidas < 0) {
+            linhasLidas = 0;
+            resultado = -4;
+        }
+    }
+    else {
+        TrocoGrelha* trocos = calloc((size_t)numTrocos, sizeof(TrocoGrelha));
+        if (!trocos) {
+            DesmapearFicheiro(&mapa);
+            return -4;
+        }
+        DividirGrelha(grelha, tamanhoGrelha, numTrocos, trocos);
+
+        LeituraGrelha leitura = { trocos, numColunas };
+        if (ExecutarEmParalelo(numTrocos, numThreads, AnalisarTroco, &leitura) != 0 ||
+            JuntarTrocos(trocos, numTrocos, numLinhas, lote, &linhasLidas) != 0) {
+            resultado = -4;
+        }
+
+        for (int i = 0; i < numTrocos; i++) LibertarLote(&trocos[i].lote);
+        free(trocos);
+    }
+
+    if (estatisticas) {
+        memset(estatisticas, 0, sizeof(EstatisticasCarregamento));
+        estatisticas->bytes = mapa.tamanho;
+        estatisticas->linhas = linhasLidas;
+        estatisticas->antenas = lote->total - antenasAntes;
+        estatisticas->threads = numTrocos;
+        estatisticas->largura = numColunas;
+        estatisticas->altura = numLinhas;
+        estatisticas->segundosAnalise = TempoAtual() - inicio;
+        estatisticas->segundos = estatisticas->segundosAnalise;
+    }
+
+    DesmapearFicheiro(&mapa);
+    return resultado;
+}
+#pragma endregion
+
+#pragma region AlargarGrelha
+/**
+ * Funo para acertar a grelha do grafo depois de carregar um ficheiro: como as antenas so
+ * acrescentadas s que j existem, o grafo fica com a maior largura e a maior altura.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param largura --> Nmero de colunas da grelha lida.
+ * @param altura --> Nmero de linhas da grelha lida.
+ */
+void AlargarGrelha(Grafo* grafo, int largura, int altura) {
+    if (largura > grafo->largura) grafo->largura = largura;
+    if (altura > grafo->altura) grafo->altura = altura;
+}
+#pragma endregion
+
+#pragma region CarregarAntenasParalelo
+/**
+ * Funo para carregar as antenas de um ficheiro para um grafo, lendo a grelha com vrias threads.
+ * A leitura  feita por LerGrelhaAntenas e as antenas so depois inseridas com AdicionarAntena,
+ * por ordem de linha e coluna, por isso o grafo fica igual ao do carregamento sequencial.
+ * Se o grafo j tiver antenas, fica com a maior grelha entre a sua e a do cabealho (AlargarGrelha).
+ *
+ * @param grafo --> Apontador para o grafo onde as antenas sero carregadas.
+ * @param nomeFicheiro --> Nome do ficheiro de antenas.
+ * @param numThreads --> Nmero de threads da leitura (0 ou negativo para usar todos os processadores).
+ * @param estatisticas --> Apontador para as estatsticas de leitura (pode ser NULL).
+ * @param lidas --> Estatsticas usadas quando o chamador no as pede.
+ * @param lote --> Antenas lidas, por ordem de linha e coluna.
+ * @param return --> 0 se as antenas foram carregadas, -1 se os argumentos forem nulos,
+ *                   -2 se o ficheiro no puder ser lido, -3 se o cabealho for invlido,
+ *                   -4 se falhar a alocao.
+ */
+int CarregarAntenasParalelo(Grafo* grafo, const char* nomeFicheiro, int numThreads, EstatisticasCarregamento* estatisticas) {
+    if (!grafo || !nomeFicheiro) return -1;
+    double inicio = TempoAtual();
+
+    EstatisticasCarregamento lidas;
+    if (!estatisticas) estatisticas = &lidas;
+    LoteAntenas lote = { NULL, 0, 0 };
+    int resultado = LerGrelhaAntenas(nomeFicheiro, numThreads, &lote, estatisticas);
+    if (resultado == -2 || resultado == -3) return resultado;
+    AlargarGrelha(grafo, estatisticas->largura, estatisticas->altura);
+
+    //A insero no grafo  sequencial, pela ordem do ficheiro
+    for (int i = 0; i < lote.total && resultado == 0; i++) {
+        if (AdicionarAntena(grafo, lote.registos[i].frequencia, lote.registos[i].coluna, lote.registos[i].linha) != 0) {
+            resultado = -4;
+        }
+    }
+
+    estatisticas->segundos = TempoAtual() - inicio;
+    estatisticas->mbPorSegundo = estatisticas->segundos > 0
+        ? (double)estatisticas->bytes / (1024.0 * 1024.0) / estatisticas->segundos : 0.0;
+
+    LibertarLote(&lote);
+    return resultado;
+}
+#pragma endregion
+
+#pragma region CarregarAntenasMapeado
+/**
+ * Funo para carregar as antenas de um ficheiro mapeado em memria para um grafo, sem threads.
+ * As antenas so inseridas com AdicionarAntena, pela mesma ordem que CarregarAntenasDoFicheiro,
+ * e as linhas podem ter qualquer largura.
+ *
+ * @param grafo --> Apontador para o grafo onde as antenas sero carregadas.
+ * @param nomeFicheiro --> Nome do ficheiro de antenas.
+ * @param estatisticas --> Apontador para as estatsticas de leitura (pode ser NULL).
+ * @param return --> 0 se as antenas foram carregadas, -1 se os argumentos forem nulos,
+ *                   -2 se o ficheiro no puder ser lido, -3 se o cabealho for invlido,
+ *                   -4 se falhar a alocao.
+ */
+int CarregarAntenasMapeado(Grafo* grafo, const char* nomeFicheiro, EstatisticasCarregamento* estatisticas) {
+    return CarregarAntenasParalelo(grafo, nomeFicheiro, 1, estatisticas);
+}
+#pragma endregion
@@ -0,0 +1,259 @@
+/*****************************************************************//**
+ * \file   componentes.c
+ * \brief  Componentes fracamente ligadas da rede de antenas, mantidas a cada alterao do grafo.
+ *
+ * Todas as antenas de uma frequncia esto ligadas entre si (pelo balde), por isso
+ * cada componente  um conjunto de frequncias, juntas pelas ligaes explcitas
+ * entre antenas de frequncias diferentes. As ligaes so tratadas como no
+ * orientadas (componentes fracas): duas antenas esto na mesma componente se houver
+ * um caminho entre elas quando se ignora o sentido das ligaes. No so componentes
+ * fortemente ligadas: com ligaes explcitas s num sentido, uma antena pode estar
+ * na mesma componente de outra que no alcana.
+ * Basta ento guardar, por frequncia, o nmero de antenas e, por par de
+ * frequncias, o nmero de ligaes explcitas. Adicionar ou remover antenas e
+ * ligaes s altera estas contagens; as componentes s so refeitas (sobre as
+ * NUM_FREQUENCIAS frequncias, sem olhar para as antenas) quando uma frequncia
+ * aparece ou desaparece, ou um par de frequncias ganha ou perde a ltima ligao.
+ * O tamanho e as frequncias de cada componente so consultados em O(1).
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "antenas.h"
+
+#pragma region Reagrupar
+/**
+ * Refaz as componentes a partir das contagens, com uma procura em largura sobre as
+ * frequncias que tm antenas. As componentes so numeradas pela ordem da menor
+ * frequncia de cada uma. Custa O(NUM_FREQUENCIAS^2), seja qual for o tamanho do grafo.
+ *
+ * @param fila --> Frequncias por visitar na componente atual.
+ */
+static void Reagrupar(Componentes* componentes) {
+    int fila[NUM_FREQUENCIAS];
+    int total = 0;
+
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) componentes->rotulo[f] = -1;
+    memset(componentes->tamanho, 0, sizeof(componentes->tamanho));
+    memset(componentes->numFrequencias, 0, sizeof(componentes->numFrequencias));
+    memset(componentes->frequencias, 0, sizeof(componentes->frequencias));
+
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) {
+        if (componentes->antenasFrequencia[f] == 0 || componentes->rotulo[f] != -1) continue;
+
+        int c = total++;
+        int frente = 0, tras = 0;
+        componentes->rotulo[f] = c;
+        fila[tras++] = f;
+        while (frente < tras) {
+            int g = fila[frente++];
+            componentes->tamanho[c] += componentes->antenasFrequencia[g];
+            componentes->numFrequencias[c]++;
+            componentes->frequencias[c][g / 32] |= 1u << (g % 32);
+
+            const int* ligacoes = &componentes->ligacoesEntre[g * NUM_FREQUENCIAS];
+            for (int h = 0; h < NUM_FREQUENCIAS; h++) {
+                if (ligacoes[h] == 0 || componentes->rotulo[h] != -1 || componentes->antenasFrequencia[h] == 0) continue;
+                componentes->rotulo[h] = c;
+                fila[tras++] = h;
+            }
+        }
+    }
+    componentes->totalComponentes = total;
+}
+#pragma endregion
+
+#pragma region RotularComponentes
+/**
+ * Funo para calcular as componentes fracamente ligadas de todo o grafo e guard-las em grafo->componentes.
+ * Conta as antenas de cada frequncia e as ligaes explcitas entre frequncias diferentes
+ * (O(antenas + ligaes)); a partir da as componentes so mantidas pelas funes que
+ * alteram o grafo, sem voltar a percorr-lo.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param componentes --> Contagens e componentes do grafo.
+ * @param return --> Nmero de componentes, -1 se o grafo for nulo, -2 se falhar a alocao.
+ */
+int RotularComponentes(Grafo* grafo) {
+    if (!grafo) return -1;
+
+    Componentes* componentes = grafo->componentes;
+    if (!componentes) {
+        componentes = calloc(1, sizeof(Componentes));
+        if (!componentes) return -2;
+        componentes->ligacoesEntre = calloc(NUM_FREQUENCIAS * NUM_FREQUENCIAS, sizeof(int));
+        if (!componentes->ligacoesEntre) {
+            free(componentes);
+            return -2;
+        }
+        grafo->componentes = componentes;
+    }
+    else {
+        memset(componentes->antenasFrequencia, 0, sizeof(componentes->antenasFrequencia));
+        memset(componentes->ligacoesEntre, 0, NUM_FREQUENCIAS * NUM_FREQUENCIAS * sizeof(int));
+    }
+
+    for (int v = 0; v < grafo->totalIds; v++) {
+        Antena* antena = grafo->porId[v];
+        if (!antena) continue;
+        int f = (unsigned char)antena->frequencia;
+        componentes->antenasFrequencia[f]++;
+        for (Adjacencia* adj = antena->ligacoes; adj != NULL; adj = adj->proxima) {
+            int g = (unsigned char)adj->destino->frequencia;
+            if (f == g) continue;
+            componentes->ligacoesEntre[f * NUM_FREQUENCIAS + g]++;
+            componentes->ligacoesEntre[g * NUM_FREQUENCIAS + f]++;
+        }
+    }
+
+    Reagrupar(componentes);
+    return componentes->totalComponentes;
+}
+#pragma endregion
+
+#pragma region AtualizarComponentes
+/**
+ * Funo para atualizar as componentes quando uma antena entra (variacao 1) ou sai
+ * (variacao -1) do balde da sua frequncia. S refaz as componentes se a frequncia
+ * aparecer ou desaparecer do grafo; caso contrrio custa O(1).
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param antena --> Antena adicionada ou removida.
+ * @param variacao --> 1 ou -1.
+ * @param return --> 0 se foram atualizadas (ou no esto calculadas), -1 se os argumentos forem invlidos.
+ */
+int AtualizarComponentesAntena(Grafo* grafo, const Antena* antena, int variacao) {
+    if (!grafo || !antena || (variacao != 1 && variacao != -1)) return -1;
+    Componentes* componentes = grafo->componentes;
+    if (!componentes) return 0;
+
+    int f = (unsigned char)antena->frequencia;
+    componentes->antenasFrequencia[f] += variacao;
+    if (componentes->antenasFrequencia[f] == (variacao > 0 ? 1 : 0)) Reagrupar(componentes);
+    else componentes->tamanho[componentes->rotulo[f]] += variacao;
+    return 0;
+}
+
+/**
+ * Funo para atualizar as componentes quando uma ligao explcita  criada (variacao 1)
+ * ou removida (variacao -1). S refaz as componentes se for a primeira ou a ltima
+ * ligao entre as duas frequncias; caso contrrio custa O(1).
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param origem --> Antena de onde sai a ligao.
+ * @param destino --> Antena onde chega a ligao.
+ * @param variacao --> 1 ou -1.
+ * @param return --> 0 se foram atualizadas (ou no esto calculadas), -1 se os argumentos forem invlidos.
+ */
+int AtualizarComponentesLigacao(Grafo* grafo, const Antena* origem, const Antena* destino, int variacao) {
+    if (!grafo || !origem || !destino || (variacao != 1 && variacao != -1)) return -1;
+    Componentes* componentes = grafo->componentes;
+    if (!componentes) return 0;
+
+    int f = (unsigned char)origem->frequencia;
+    int g = (unsigned char)destino->frequencia;
+    if (f == g) return 0; //J esto ligadas pelo balde
+
+    componentes->ligacoesEntre[f * NUM_FREQUENCIAS + g] += variacao;
+    componentes->ligacoesEntre[g * NUM_FREQUENCIAS + f] += variacao;
+    if (componentes->ligacoesEntre[f * NUM_FREQUENCIAS + g] == (variacao > 0 ? 1 : 0)) Reagrupar(componentes);
+    return 0;
+}
+#pragma endregion
+
+#pragma region LibertarComponentes
+/**
+ * Funo para descartar as componentes do grafo (deixam de ser mantidas).
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param return --> 0 se foram descartadas, -1 se o grafo for nulo.
+ */
+int LibertarComponentes(Grafo* grafo) {
+    if (!grafo) return -1;
+    if (!grafo->componentes) return 0;
+
+    free(grafo->componentes->ligacoesEntre);
+    free(grafo->componentes);
+    grafo->componentes = NULL;
+    return 0;
+}
+#pragma endregion
+
+#pragma region Consultas
+/**
+ * Funo para obter o nmero de componentes.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param return --> Nmero de componentes ou -1 se ainda no foram calculadas.
+ */
+int TotalComponentes(const Grafo* grafo) {
+    if (!grafo || !grafo->componentes) return -1;
+    return grafo->componentes->totalComponentes;
+}
+
+/**
+ * Funo para obter a componente de uma antena.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param antena --> Antena do grafo.
+ * @param return --> Nmero da componente ou -1 se as componentes no foram calculadas.
+ */
+int ComponenteDe(const Grafo* grafo, const Antena* antena) {
+    if (!grafo || !antena || !grafo->componentes) return -1;
+    return grafo->componentes->rotulo[(unsigned char)antena->frequencia];
+}
+
+/**
+ * Funo para obter o nmero de antenas de uma componente.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param componente --> Nmero da componente.
+ * @param return --> Nmero de antenas ou -1 se a componente no existir.
+ */
+int TamanhoComponente(const Grafo* grafo, int componente) {
+    if (!grafo || !grafo->componentes || componente < 0 || componente >= grafo->componentes->totalComponentes) return -1;
+    return grafo->componentes->tamanho[componente];
+}
+
+/**
+ * Funo para obter o nmero de frequncias diferentes de uma componente.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param componente --> Nmero da componente.
+ * @param return --> Nmero de frequncias ou -1 se a componente no existir.
+ */
+int FrequenciasComponente(const Grafo* grafo, int componente) {
+    if (!grafo || !grafo->componentes || componente < 0 || componente >= grafo->componentes->totalComponentes) return -1;
+    return grafo->componentes->numFrequencias[componente];
+}
+
+/**
+ * Funo para saber se uma componente tem antenas de uma frequncia.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param componente --> Nmero da componente.
+ * @param freq --> Frequncia a procurar.
+ * @param return --> Verdadeiro se a componente tiver antenas de freq.
+ */
+bool ComponenteTemFrequencia(const Grafo* grafo, int componente, char freq) {
+    if (!grafo || !grafo->componentes || componente < 0 || componente >= grafo->componentes->totalComponentes) return false;
+    unsigned char f = (unsigned char)freq;
+    return (grafo->componentes->frequencias[componente][f / 32] >> (f % 32)) & 1u;
+}
+
+/**
+ * Funo para saber se duas antenas esto na mesma componente fracamente ligada (ligadas
+ * por algum caminho quando se ignora o sentido das ligaes), sem percorrer o grafo.
+ * No diz se uma alcana a outra: com ligaes s num sentido, isso exige uma travessia.
+ *
+ * @param grafo --> Apontador para o grafo com as componentes calculadas.
+ * @param a --> Primeira antena.
+ * @param b --> Segunda antena.
+ * @param return --> Verdadeiro se estiverem na mesma componente.
+ */
+bool MesmaComponenteFraca(const Grafo* grafo, const Antena* a, const Antena* b) {
+    int ca = ComponenteDe(grafo, a);
+    return ca >= 0 && ca == ComponenteDe(grafo, b);
+}
+#pragma endregion
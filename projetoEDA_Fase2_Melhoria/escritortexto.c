@@ -0,0 +1,164 @@
+/*****************************************************************//**
+ * \file   escritortexto.c
+ * \brief  Escritor de texto com buffer fixo, usado por todas as funes que escrevem resultados.
+ *
+ * Os resultados so escritos em muitos pedaos pequenos (uma antena, uma coordenada),
+ * muitas vezes dentro de ciclos grandes. Com fprintf cada pedao paga a anlise do
+ * formato e o bloqueio do FILE; aqui os pedaos so copiados para um buffer de
+ * TAMANHO_ESCRITOR bytes que faz parte do prprio escritor (sem alocaes) e os
+ * inteiros e as coordenadas so convertidos  mo, pelos mesmos FormatarInteiro e
+ * FormatarCoordenada do BufferTexto. O buffer s  passado ao ficheiro quando enche
+ * ou quando  descarregado, com um nico fwrite (ou acrescentado a um BufferTexto,
+ * quando o destino  a memria, para juntar mais tarde resultados feitos em paralelo).
+ * O texto produzido  igual ao de "%c", "%d" e "%s".
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "antenas.h"
+
+#pragma region IniciarEscritor
+/**
+ * Funo para preparar um escritor para escrever em saida.
+ *
+ * @param escritor --> Apontador para o escritor.
+ * @param saida --> Ficheiro de destino.
+ * @param return --> 0 se ficou pronto, -1 se os argumentos forem nulos.
+ */
+int IniciarEscritor(EscritorTexto* escritor, FILE* saida) {
+    if (!escritor || !saida) return -1;
+    escritor->saida = saida;
+    escritor->memoria = NULL;
+    escritor->usado = 0;
+    escritor->erro = 0;
+    return 0;
+}
+
+/**
+ * Funo para preparar um escritor para acrescentar o texto a um buffer em memria.
+ *
+ * @param escritor --> Apontador para o escritor.
+ * @param memoria --> Buffer de destino (o texto  acrescentado ao que j l estiver).
+ * @param return --> 0 se ficou pronto, -1 se os argumentos forem nulos.
+ */
+int IniciarEscritorMemoria(EscritorTexto* escritor, BufferTexto* memoria) {
+    if (!escritor || !memoria) return -1;
+    escritor->saida = NULL;
+    escritor->memoria = memoria;
+    escritor->usado = 0;
+    escritor->erro = 0;
+    return 0;
+}
+#pragma endregion
+
+/**
+ * Passa tamanho bytes ao destino do escritor e regista a falha, se houver.
+ */
+static void EnviarBytes(EscritorTexto* escritor, const char* texto, size_t tamanho) {
+    if (escritor->memoria) {
+        if (AcrescentarTexto(escritor->memoria, texto, tamanho) != 0) escritor->erro = -2;
+    }
+    else if (fwrite(texto, 1, tamanho, escritor->saida) != tamanho) {
+        escritor->erro = -3;
+    }
+    else {
+        CONTAR(CONTADOR_BYTES_ESCRITOS, tamanho);
+    }
+}
+
+#pragma region DescarregarEscritor
+/**
+ * Funo para passar ao destino o que est no buffer. Tem de ser chamada antes de
+ * escrever no mesmo ficheiro por outro meio e no fim.
+ *
+ * @param escritor --> Apontador para o escritor.
+ * @param return --> 0 se foi tudo escrito at agora, -1 se for nulo, -3 se alguma escrita falhou,
+ *                   -2 se o buffer de destino no pde crescer.
+ */
+int DescarregarEscritor(EscritorTexto* escritor) {
+    if (!escritor) return -1;
+    if (escritor->usado > 0) EnviarBytes(escritor, escritor->dados, escritor->usado);
+    escritor->usado = 0;
+    return escritor->erro;
+}
+#pragma endregion
+
+#pragma region EscreverTexto
+/**
+ * Funo para escrever bytes. Blocos maiores do que o buffer vo diretamente para o destino.
+ *
+ * @param escritor --> Apontador para o escritor.
+ * @param texto --> Bytes a escrever.
+ * @param tamanho --> Nmero de bytes.
+ * @param return --> 0, ou o erro do escritor (-3 ou -2) se alguma escrita falhou.
+ */
+int EscreverBytes(EscritorTexto* escritor, const char* texto, size_t tamanho) {
+    if (escritor->usado + tamanho > TAMANHO_ESCRITOR) {
+        DescarregarEscritor(escritor);
+        if (tamanho > TAMANHO_ESCRITOR) {
+            EnviarBytes(escritor, texto, tamanho);
+            return escritor->erro;
+        }
+    }
+    memcpy(escritor->dados + escritor->usado, texto, tamanho);
+    escritor->usado += tamanho;
+    return escritor->erro;
+}
+
+/**
+ * Funo para escrever uma string terminada em '\0' (igual a "%s").
+ *
+ * @param escritor --> Apontador para o escritor.
+ * @param texto --> Texto a escrever.
+ * @param return --> 0, ou o erro do escritor (-3 ou -2) se alguma escrita falhou.
+ */
+int EscreverTexto(EscritorTexto* escritor, const char* texto) {
+    return EscreverBytes(escritor, texto, strlen(texto));
+}
+
+/**
+ * Funo para escrever um carcter (igual a "%c").
+ *
+ * @param escritor --> Apontador para o escritor.
+ * @param c --> Carcter a escrever.
+ * @param return --> 0, ou o erro do escritor (-3 ou -2) se alguma escrita falhou.
+ */
+int EscreverCaracter(EscritorTexto* escritor, char c) {
+    if (escritor->usado == TAMANHO_ESCRITOR) DescarregarEscritor(escritor);
+    escritor->dados[escritor->usado++] = c;
+    return escritor->erro;
+}
+#pragma endregion
+
+#pragma region EscreverInteiro
+/**
+ * Funo para escrever um inteiro em decimal (igual a "%d" / "%lld").
+ *
+ * @param escritor --> Apontador para o escritor.
+ * @param valor --> Valor a escrever.
+ * @param digitos --> Dgitos do valor, escritos do fim para o incio.
+ * @param return --> 0, ou o erro do escritor (-3 ou -2) se alguma escrita falhou.
+ */
+int EscreverInteiro(EscritorTexto* escritor, long long valor) {
+    char digitos[24];
+    char* inicio = FormatarInteiro(digitos + sizeof(digitos), valor);
+    return EscreverBytes(escritor, inicio, digitos + sizeof(digitos) - inicio);
+}
+
+/**
+ * Funo para escrever uma coordenada no formato "(coluna,linha)" (igual a "(%d,%d)").
+ *  formatada do fim para o incio num vetor local e copiada de uma s vez.
+ *
+ * @param escritor --> Apontador para o escritor.
+ * @param coluna --> Coluna (X).
+ * @param linha --> Linha (Y).
+ * @param texto --> Espao para a coordenada.
+ * @param return --> 0, ou o erro do escritor (-3 ou -2) se alguma escrita falhou.
+ */
+int EscreverCoordenada(EscritorTexto* escritor, int coluna, int linha) {
+    char texto[TAMANHO_COORDENADA];
+    char* inicio = FormatarCoordenada(texto + sizeof(texto), coluna, linha);
+    return EscreverBytes(escritor, inicio, texto + sizeof(texto) - inicio);
+}
+#pragma endregion
@@ -0,0 +1,491 @@
+/*****************************************************************//**
+ * \file   exportacao.c
+ * \brief  Exportao dos resultados em CSV, JSON Lines ou binrio, seco a seco.
+ *
+ * Cada seco do relatrio (antenas, travessias, caminhos, intersees e pontos de
+ * interferncia) pode ir para o seu ficheiro e no seu formato. Os registos so
+ * escritos  medida que so produzidos, pelos visitantes das travessias, da procura
+ * de caminhos, das intersees e das interferncias, sem juntar os resultados em
+ * memria; todas as seces partilham o mesmo escritor.
+ *
+ * Formatos (um registo por antena, passo, caminho, interseo ou ponto):
+ *  - texto: as linhas das seces do relatrio, sem os ttulos;
+ *  - CSV: uma linha de cabealho e uma linha por registo (num caminho, uma por passo);
+ *  - JSON Lines: um objeto por linha (um caminho  um objeto com o vetor das antenas);
+ *  - binrio: cabealho de 8 bytes ("EDARES", verso, seco) seguido dos registos,
+ *    com os inteiros de 32 bits em little-endian. Uma antena so 9 bytes (frequncia,
+ *    coluna, linha); uma antena de uma travessia vem depois do seu nvel; um caminho 
+ *    o nmero de antenas seguido das antenas; uma interseo so duas antenas; um ponto
+ *     a coluna e a linha.
+ *
+ * Se a procura de caminhos parar num limite, a seco dos caminhos acaba com um registo
+ * a diz-lo, depois dos caminhos j escritos: em texto a mesma linha do relatrio; em CSV
+ * a linha "caminhos,-1,motivo,," (motivo "limite" ou "tempo"); em JSON Lines o objeto
+ * {"interrompida":true,"motivo":...,"caminhos":...}; em binrio o comprimento -1 seguido
+ * do motivo (0 limite de caminhos, 1 tempo esgotado) e do nmero de caminhos.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdint.h>
+#include "antenas.h"
+
+#define ASSINATURA_RESULTADOS "EDARES"
+#define VERSAO_RESULTADOS 2
+
+//Cabealho CSV de cada seco, indexado por SeccaoExportacao
+static const char* const CABECALHOS_CSV[NUM_SECCOES] = {
+    "frequencia,coluna,linha\n",
+    "ordem,nivel,frequencia,coluna,linha\n",
+    "ordem,nivel,frequencia,coluna,linha\n",
+    "caminho,passo,frequencia,coluna,linha\n",
+    "frequenciaA,colunaA,linhaA,frequenciaB,colunaB,linhaB\n",
+    "coluna,linha\n"
+};
+
+/**
+ * Estado de uma seco em exportao, passado como contexto aos visitantes.
+ * @param escritor --> Escritor da seco.
+ * @param formato --> Formato da seco.
+ * @param registos --> Nmero de registos j escritos (ordem na travessia ou nmero do caminho).
+ */
+typedef struct Exportador {
+    EscritorTexto* escritor;
+    FormatoExportacao formato;
+    long long registos;
+} Exportador;
+
+#pragma region EscreverCampos
+static void EscreverInteiro32(EscritorTexto* escritor, int valor) {
+    uint32_t v = (uint32_t)valor;
+    char bytes[4] = { (char)(v & 0xFF), (char)((v >> 8) & 0xFF), (char)((v >> 16) & 0xFF), (char)(v >> 24) };
+    EscreverBytes(escritor, bytes, 4);
+}
+
+/**
+ * Escreve a frequncia como campo CSV, entre aspas se for um separador, aspas ou mudana de linha.
+ */
+static void EscreverFrequenciaCsv(EscritorTexto* escritor, char frequencia) {
+    if (frequencia != ',' && frequencia != '"' && frequencia != '\n' && frequencia != '\r') {
+        EscreverCaracter(escritor, frequencia);
+        return;
+    }
+    EscreverCaracter(escritor, '"');
+    if (frequencia == '"') EscreverCaracter(escritor, '"');
+    EscreverCaracter(escritor, frequencia);
+    EscreverCaracter(escritor, '"');
+}
+
+/**
+ * Escreve a frequncia como string JSON. Os carateres de controlo e os bytes acima de 0x7E
+ * so escritos como \u00XX (a frequncia  um byte, lido como Latin-1).
+ */
+static void EscreverFrequenciaJson(EscritorTexto* escritor, char frequencia) {
+    static const char hexadecimal[] = "0123456789abcdef";
+    unsigned char c = (unsigned char)frequencia;
+    EscreverCaracter(escritor, '"');
+    if (c == '"' || c == '\\') {
+        EscreverCaracter(escritor, '\\');
+        EscreverCaracter(escritor, (char)c);
+    }
+    else if (c < 0x20 || c > 0x7E) {
+        char escape[6] = { '\\', 'u', '0', '0', hexadecimal[c >> 4], hexadecimal[c & 0xF] };
+        EscreverBytes(escritor, escape, 6);
+    }
+    else {
+        EscreverCaracter(escritor, (char)c);
+    }
+    EscreverCaracter(escritor, '"');
+}
+
+/**
+ * Escreve os campos de uma antena no formato do exportador (sem o fim do registo).
+ * Em JSON escreve os pares "chave":valor, sem as chavetas do objeto.
+ */
+static void EscreverCamposAntena(Exportador* exportador, const Antena* antena) {
+    EscritorTexto* escritor = exportador->escritor;
+    switch (exportador->formato) {
+    case EXPORTAR_CSV:
+        EscreverFrequenciaCsv(escritor, antena->frequencia);
+        EscreverCaracter(escritor, ',');
+        EscreverInteiro(escritor, antena->coluna);
+        EscreverCaracter(escritor, ',');
+        EscreverInteiro(escritor, antena->linha);
+        break;
+    case EXPORTAR_JSONL:
+        EscreverTexto(escritor, "\"frequencia\":");
+        EscreverFrequenciaJson(escritor, antena->frequencia);
+        EscreverTexto(escritor, ",\"coluna\":");
+        EscreverInteiro(escritor, antena->coluna);
+        EscreverTexto(escritor, ",\"linha\":");
+        EscreverInteiro(escritor, antena->linha);
+        break;
+    case EXPORTAR_BINARIO:
+        EscreverCaracter(escritor, antena->frequencia);
+        EscreverInteiro32(escritor, antena->coluna);
+        EscreverInteiro32(escritor, antena->linha);
+        break;
+    default:
+        EscreverCaracter(escritor, antena->frequencia);
+        EscreverCoordenada(escritor, antena->coluna, antena->linha);
+        break;
+    }
+}
+
+/**
+ * Escreve o incio de uma seco: a linha de cabealho em CSV, o cabealho de 8 bytes em binrio.
+ */
+static void IniciarSeccao(Exportador* exportador, SeccaoExportacao seccao) {
+    if (exportador->formato == EXPORTAR_CSV) {
+        EscreverTexto(exportador->escritor, CABECALHOS_CSV[seccao]);
+    }
+    else if (exportador->formato == EXPORTAR_BINARIO) {
+        EscreverBytes(exportador->escritor, ASSINATURA_RESULTADOS, 6);
+        EscreverCaracter(exportador->escritor, VERSAO_RESULTADOS);
+        EscreverCaracter(exportador->escritor, (char)seccao);
+    }
+}
+#pragma endregion
+
+#pragma region Visitantes
+/**
+ * Registo da seco de antenas. Devolve o erro do escritor, para parar se a escrita falhar.
+ */
+static int ExportarAntena(Exportador* exportador, const Antena* antena) {
+    EscritorTexto* escritor = exportador->escritor;
+    switch (exportador->formato) {
+    case EXPORTAR_TEXTO:
+        EscreverCaracter(escritor, antena->frequencia);
+        EscreverBytes(escritor, " @ ", 3);
+        EscreverCoordenada(escritor, antena->coluna, antena->linha);
+        EscreverCaracter(escritor, '\n');
+        break;
+    case EXPORTAR_JSONL:
+        EscreverCaracter(escritor, '{');
+        EscreverCamposAntena(exportador, antena);
+        EscreverBytes(escritor, "}\n", 2);
+        break;
+    default:
+        EscreverCamposAntena(exportador, antena);
+        if (exportador->formato == EXPORTAR_CSV) EscreverCaracter(escritor, '\n');
+        break;
+    }
+    exportador->registos++;
+    return escritor->erro;
+}
+
+/**
+ * Registo de uma travessia (VisitanteAntena): ordem de visita, nvel e antena.
+ */
+static int ExportarVisitada(Antena* antena, int nivel, void* contexto) {
+    Exportador* exportador = contexto;
+    EscritorTexto* escritor = exportador->escritor;
+    switch (exportador->formato) {
+    case EXPORTAR_TEXTO:
+        EscreverBytes(escritor, "Antena ", 7);
+        EscreverCaracter(escritor, antena->frequencia);
+        EscreverBytes(escritor, " @ ", 3);
+        EscreverCoordenada(escritor, antena->coluna, antena->linha);
+        EscreverCaracter(escritor, '\n');
+        break;
+    case EXPORTAR_CSV:
+        EscreverInteiro(escritor, exportador->registos);
+        EscreverCaracter(escritor, ',');
+        EscreverInteiro(escritor, nivel);
+        EscreverCaracter(escritor, ',');
+        EscreverCamposAntena(exportador, antena);
+        EscreverCaracter(escritor, '\n');
+        break;
+    case EXPORTAR_JSONL:
+        EscreverTexto(escritor, "{\"ordem\":");
+        EscreverInteiro(escritor, exportador->registos);
+        EscreverTexto(escritor, ",\"nivel\":");
+        EscreverInteiro(escritor, nivel);
+        EscreverCaracter(escritor, ',');
+        EscreverCamposAntena(exportador, antena);
+        EscreverBytes(escritor, "}\n", 2);
+        break;
+    default:
+        EscreverInteiro32(escritor, nivel);
+        EscreverCamposAntena(exportador, antena);
+        break;
+    }
+    exportador->registos++;
+    return escritor->erro;
+}
+
+/**
+ * Registo de um caminho (CallbackCaminho). Em CSV cada passo  uma linha, com o nmero do caminho.
+ */
+static int ExportarCaminho(Antena** caminho, int comprimento, void* contexto) {
+    Exportador* exportador = contexto;
+    EscritorTexto* escritor = exportador->escritor;
+    switch (exportador->formato) {
+    case EXPORTAR_TEXTO:
+        for (int i = 0; i < comprimento; i++) {
+            EscreverCamposAntena(exportador, caminho[i]);
+            if (i + 1 < comprimento) EscreverBytes(escritor, " -> ", 4);
+        }
+        EscreverCaracter(escritor, '\n');
+        break;
+    case EXPORTAR_CSV:
+        for (int i = 0; i < comprimento; i++) {
+            EscreverInteiro(escritor, exportador->registos);
+            EscreverCaracter(escritor, ',');
+            EscreverInteiro(escritor, i);
+            EscreverCaracter(escritor, ',');
+            EscreverCamposAntena(exportador, caminho[i]);
+            EscreverCaracter(escritor, '\n');
+        }
+        break;
+    case EXPORTAR_JSONL:
+        EscreverTexto(escritor, "{\"caminho\":");
+        EscreverInteiro(escritor, exportador->registos);
+        EscreverTexto(escritor, ",\"antenas\":[");
+        for (int i = 0; i < comprimento; i++) {
+            if (i > 0) EscreverCaracter(escritor, ',');
+            EscreverCaracter(escritor, '{');
+            EscreverCamposAntena(exportador, caminho[i]);
+            EscreverCaracter(escritor, '}');
+        }
+        EscreverBytes(escritor, "]}\n", 3);
+        break;
+    default:
+        EscreverInteiro32(escritor, comprimento);
+        for (int i = 0; i < comprimento; i++) EscreverCamposAntena(exportador, caminho[i]);
+        break;
+    }
+    exportador->registos++;
+    return escritor->erro;
+}
+
+/**
+ * Registo final da seco dos caminhos quando a procura parou num limite, para quem l
+ * o ficheiro saber que a lista de caminhos est incompleta.
+ */
+static int ExportarInterrupcao(Exportador* exportador, const ResultadoCaminhos* resultado) {
+    EscritorTexto* escritor = exportador->escritor;
+    const char* motivo = resultado->esgotouTempo ? "tempo" : "limite";
+    switch (exportador->formato) {
+    case EXPORTAR_TEXTO:
+        EscreverTexto(escritor, "... procura interrompida (");
+        EscreverTexto(escritor, resultado->esgotouTempo ? "tempo esgotado" : "limite de caminhos");
+        EscreverTexto(escritor, ") depois de ");
+        EscreverInteiro(escritor, resultado->caminhos);
+        EscreverTexto(escritor, " caminhos\n");
+        break;
+    case EXPORTAR_CSV:
+        EscreverInteiro(escritor, resultado->caminhos);
+        EscreverTexto(escritor, ",-1,");
+        EscreverTexto(escritor, motivo);
+        EscreverBytes(escritor, ",,\n", 3);
+        break;
+    case EXPORTAR_JSONL:
+        EscreverTexto(escritor, "{\"interrompida\":true,\"motivo\":\"");
+        EscreverTexto(escritor, motivo);
+        EscreverTexto(escritor, "\",\"caminhos\":");
+        EscreverInteiro(escritor, resultado->caminhos);
+        EscreverBytes(escritor, "}\n", 2);
+        break;
+    default:
+        EscreverInteiro32(escritor, -1);
+        EscreverInteiro32(escritor, resultado->esgotouTempo ? 1 : 0);
+        EscreverInteiro32(escritor, (int)resultado->caminhos);
+        break;
+    }
+    return escritor->erro;
+}
+
+/**
+ * Registo de uma interseo (VisitanteIntersecao).
+ */
+static int ExportarIntersecao(const Antena* a, const Antena* b, void* contexto) {
+    Exportador* exportador = contexto;
+    EscritorTexto* escritor = exportador->escritor;
+    switch (exportador->formato) {
+    case EXPORTAR_TEXTO:
+        EscreverCamposAntena(exportador, a);
+        EscreverBytes(escritor, " - ", 3);
+        EscreverCamposAntena(exportador, b);
+        EscreverCaracter(escritor, '\n');
+        break;
+    case EXPORTAR_CSV:
+        EscreverCamposAntena(exportador, a);
+        EscreverCaracter(escritor, ',');
+        EscreverCamposAntena(exportador, b);
+        EscreverCaracter(escritor, '\n');
+        break;
+    case EXPORTAR_JSONL:
+        EscreverTexto(escritor, "{\"a\":{");
+        EscreverCamposAntena(exportador, a);
+        EscreverTexto(escritor, "},\"b\":{");
+        EscreverCamposAntena(exportador, b);
+        EscreverBytes(escritor, "}}\n", 3);
+        break;
+    default:
+        EscreverCamposAntena(exportador, a);
+        EscreverCamposAntena(exportador, b);
+        break;
+    }
+    exportador->registos++;
+    return escritor->erro;
+}
+
+/**
+ * Registo de um ponto de interferncia (VisitantePonto).
+ */
+static int ExportarPonto(int coluna, int linha, void* contexto) {
+    Exportador* exportador = contexto;
+    EscritorTexto* escritor = exportador->escritor;
+    switch (exportador->formato) {
+    case EXPORTAR_TEXTO:
+        EscreverCoordenada(escritor, coluna, linha);
+        EscreverCaracter(escritor, '\n');
+        break;
+    case EXPORTAR_CSV:
+        EscreverInteiro(escritor, coluna);
+        EscreverCaracter(escritor, ',');
+        EscreverInteiro(escritor, linha);
+        EscreverCaracter(escritor, '\n');
+        break;
+    case EXPORTAR_JSONL:
+        EscreverTexto(escritor, "{\"coluna\":");
+        EscreverInteiro(escritor, coluna);
+        EscreverTexto(escritor, ",\"linha\":");
+        EscreverInteiro(escritor, linha);
+        EscreverBytes(escritor, "}\n", 2);
+        break;
+    default:
+        EscreverInteiro32(escritor, coluna);
+        EscreverInteiro32(escritor, linha);
+        break;
+    }
+    exportador->registos++;
+    return escritor->erro;
+}
+#pragma endregion
+
+#pragma region ExportarSeccao
+/**
+ * Cdigo de uma seco depois de a percorrer: o erro do escritor se alguma escrita falhou
+ * (foi o visitante que parou a procura, por isso o cdigo da procura no diz porqu),
+ * -2 se a procura falhou por outra razo e 0 caso contrrio.
+ *
+ * @param exportador --> Exportador da seco.
+ * @param resultado --> Cdigo (ou nmero de registos) devolvido pela procura.
+ * @param return --> 0, -2 se falhar a alocao, -3 se a escrita falhar.
+ */
+static int EstadoSeccao(const Exportador* exportador, long long resultado) {
+    if (exportador->escritor->erro != 0) return exportador->escritor->erro;
+    return resultado < 0 ? -2 : 0;
+}
+
+/**
+ * Produz os registos de uma seco, com as mesmas escolhas do relatrio: por omisso as
+ * travessias comeam na primeira antena da lista e os caminhos vo da primeira  terceira,
+ * com os limites de EncontrarCaminhos. Os caminhos so escritos  medida que so encontrados;
+ * se a procura parar num limite, a seco acaba com o registo de ExportarInterrupcao.
+ *
+ * @param grafo --> Grafo a analisar.
+ * @param seccao --> Seco a exportar.
+ * @param opcoes --> Opes da exportao.
+ * @param exportador --> Exportador da seco.
+ * @param visitados --> Marcas de visita das travessias, criadas na primeira que for exportada.
+ * @param return --> 0, -2 se falhar a alocao, -3 se a escrita falhar.
+ */
+static int ExportarSeccao(Grafo* grafo, SeccaoExportacao seccao, const OpcoesExportacao* opcoes,
+    Exportador* exportador, Visitados* visitados) {
+    Antena* primeira = grafo->antenas;
+    Antena* inicio = opcoes->inicio ? opcoes->inicio : primeira;
+
+    switch (seccao) {
+    case SECCAO_ANTENAS:
+        for (Antena* a = grafo->antenas; a != NULL; a = a->proxima) {
+            if (ExportarAntena(exportador, a) != 0) break;
+        }
+        return EstadoSeccao(exportador, 0);
+
+    case SECCAO_PROFUNDIDADE:
+    case SECCAO_LARGURA: {
+        if (!inicio) return 0;
+        if (!visitados->marcas && CriarVisitados(visitados, grafo->totalIds) != 0) return -2;
+        int resultado = seccao == SECCAO_PROFUNDIDADE
+            ? PercorrerEmProfundidadeVisitante(grafo, inicio, visitados, ExportarVisitada, exportador)
+            : PercorrerEmLarguraVisitante(grafo, inicio, visitados, ExportarVisitada, exportador);
+        return EstadoSeccao(exportador, resultado);
+    }
+
+    case SECCAO_CAMINHOS: {
+        Antena* origem = opcoes->origem ? opcoes->origem : primeira;
+        Antena* destino = opcoes->destino;
+        if (!destino && grafo->totalAntenas > 2) destino = primeira->proxima->proxima;
+        if (!origem || !destino) return 0;
+        ConsultaCaminhos consulta = { CAMINHOS_TODOS, 0, { MAX_CAMINHOS_RELATORIO, 0, MAX_SEGUNDOS_CAMINHOS }, ExportarCaminho, exportador };
+        ResultadoCaminhos resultado;
+        int estado = ProcurarCaminhos(grafo, origem, destino, &consulta, &resultado);
+        if (estado == 0 && resultado.truncado && exportador->escritor->erro == 0) ExportarInterrupcao(exportador, &resultado);
+        return EstadoSeccao(exportador, estado);
+    }
+
+    case SECCAO_INTERSECOES: {
+        IndiceIntersecoes indice;
+        if (ConstruirIndiceIntersecoes(grafo, &indice) != 0) return -2;
+        int resultado = 0;
+        if (!opcoes->paresFrequencias) resultado = PercorrerTodasIntersecoes(&indice, ExportarIntersecao, exportador);
+        for (const char* par = opcoes->paresFrequencias; par && par[0] && par[1] && resultado >= 0; par += 2) {
+            resultado = PercorrerIntersecoesPar(&indice, par[0], par[1], ExportarIntersecao, exportador);
+        }
+        LibertarIndiceIntersecoes(&indice);
+        return EstadoSeccao(exportador, resultado);
+    }
+
+    case SECCAO_INTERFERENCIAS:
+        return EstadoSeccao(exportador, PercorrerPontosInterferencia(grafo, &opcoes->interferencias, ExportarPonto, exportador));
+
+    default:
+        return 0;
+    }
+}
+#pragma endregion
+
+#pragma region ExportarResultados
+/**
+ * Funo para exportar os resultados das anlises, cada seco no formato e no ficheiro
+ * indicados em opcoes (as seces com EXPORTAR_NADA so omitidas). As seces so escritas
+ * pela ordem do relatrio, por isso vrias podem partilhar o mesmo ficheiro.
+ *
+ * @param grafo --> Grafo a analisar.
+ * @param opcoes --> Formato e destino de cada seco, e opes das interferncias.
+ * @param escritor --> Escritor com buffer, reutilizado por todas as seces.
+ * @param visitados --> Marcas de visita das travessias.
+ * @param exportador --> Estado da seco atual.
+ * @param return --> 0 se foi tudo exportado, -1 se os argumentos forem invlidos,
+ *                   -2 se falhar a alocao, -3 se a escrita falhar.
+ */
+int ExportarResultados(Grafo* grafo, const OpcoesExportacao* opcoes) {
+    if (!grafo || !opcoes) return -1;
+    for (int s = 0; s < NUM_SECCOES; s++) {
+        const DestinoExportacao* destino = &opcoes->seccoes[s];
+        if (destino->formato < EXPORTAR_NADA || destino->formato > EXPORTAR_BINARIO) return -1;
+        if (destino->formato != EXPORTAR_NADA && !destino->saida) return -1;
+    }
+
+    EscritorTexto escritor;
+    Visitados visitados = { NULL, 0, 0 };
+    int resultado = 0;
+    for (int s = 0; s < NUM_SECCOES && resultado == 0; s++) {
+        const DestinoExportacao* destino = &opcoes->seccoes[s];
+        if (destino->formato == EXPORTAR_NADA) continue;
+
+        Exportador exportador = { &escritor, destino->formato, 0 };
+        IniciarEscritor(&escritor, destino->saida);
+        IniciarSeccao(&exportador, (SeccaoExportacao)s);
+        resultado = ExportarSeccao(grafo, (SeccaoExportacao)s, opcoes, &exportador, &visitados);
+        if (DescarregarEscritor(&escritor) != 0 && resultado == 0) resultado = -3;
+    }
+
+    if (visitados.marcas) LibertarVisitados(&visitados);
+    return resultado;
+}
+#pragma endregion
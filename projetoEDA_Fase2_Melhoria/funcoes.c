@@ -11,24 +11,36 @@
 #pragma region AdicionarAdj
 /**
  * Funo para adicionar uma adjacncia entre duas antenas.
+ * A ligao fica tambm na lista de entradas do destino, para que remover qualquer das
+ * antenas no obrigue a percorrer o grafo  procura de ligaes para ela.
  * 
+ * @param grafo --> Apontador para o grafo dono da arena de onde sai a adjacncia.
  * @param origem --> Apontador para a antena de origem.
  * @param destino --> Apontador para a antena de destino.
  * @param nova --> Apontador para a nova adjacncia a ser adicionada.
- * @param return --> Verdadeiro se a adjacncia foi adicionada com sucesso, falso caso contrrio.
+ * @param entrada --> Apontador para o n da lista de entradas do destino (aponta para a origem).
+ * @param return --> 0 se a adjacncia foi adicionada, -15 se os argumentos forem nulos, -2 se falhar a alocao.
  */
-int AdicionarAdj(Antena* origem, Antena* destino) {
+int AdicionarAdj(Grafo* grafo, Antena* origem, Antena* destino) {
 	//Se as Antenas de destino ou origem forem nulas, no  possvel adicionar a adjacncia.
-    if (!origem || !destino) return -15;
+    if (!grafo || !origem || !destino) return -15;
 
-    //Aloca a memoria para a memria para uma nova ligao entre 2 vertices
-    Adjacencia* nova = malloc(sizeof(Adjacencia));
+    //Obtm da arena do grafo a memria para uma nova ligao entre 2 vertices
+    Adjacencia* nova = AlocarNo(ArenaDoGrafo(grafo), NO_ADJACENCIA);
 	//Se a alocao falhar, retorna falso.
     if (!nova) return -2;
+    Adjacencia* entrada = AlocarNo(grafo->arena, NO_ADJACENCIA);
+    if (!entrada) {
+        LibertarNo(grafo->arena, NO_ADJACENCIA, nova);
+        return -2;
+    }
     nova->destino = destino;            //define o vertice de destino da nova adjacencia 
     nova->proxima = origem->ligacoes;   //Liga essa nova ligao  lista de ligaes que o ponto de origem j tem
     origem->ligacoes = nova;            //Atualiza o ponto de origem para que a nova ligao seja a primeira da lista
-    return 0;
+    entrada->destino = origem;          //Do lado do destino guarda-se de onde vem a ligao
+    entrada->proxima = destino->entradas;
+    destino->entradas = entrada;
+    return AtualizarComponentesLigacao(grafo, origem, destino, 1);
 }
 #pragma endregion
 
@@ -46,23 +58,18 @@ int AdicionarAntena(Grafo* grafo, char freq, int col, int lin) {
     //Verifica se o grafo existe
     if (!grafo) return false;
 
-    //Aloca a memoria para uma nova antena(aresta)
-    Antena* nova = malloc(sizeof(Antena));
+    //Obtm da arena uma nova antena j preenchida com freq, col e linha, sem ligaes e sem ser visitada
+    Antena* nova = popularAntena(grafo, freq, col, lin);
 
 	//Se a alocao falhar, retorna falso.
     if (!nova) return -2;
 
-    //preenche os dados da nova antena nos campos freq, col, linha
-    nova->frequencia = freq;
-    nova->coluna = col;
-    nova->linha = lin;
-
-    //Inicializa a Nova antena sem ligaes e sem ser visitada
-    nova->ligacoes = NULL;
-    nova->visitada = false;
+    //Regista a antena no ndice espacial e no balde da sua frequncia; se falhar o grafo fica como estava
+    if (RegistarAntena(grafo, nova) != 0) return -2;
 
     //Insere a nova antena no comeo da lista de antenas do grafo
     nova->proxima = grafo->antenas;
+    if (grafo->antenas) grafo->antenas->anterior = nova;
     grafo->antenas = nova;
 
     //Aumenta o total de antenas registadas
@@ -71,310 +78,443 @@ int AdicionarAntena(Grafo* grafo, char freq, int col, int lin) {
 }
 #pragma endregion
 
-#pragma region CarregarAntenasDoFicheiro
+#pragma region AdicionarAoBalde
 /**
- * Funo para carregar antenas de um ficheiro e construir o grafo.
+ * Funo para registar uma antena no balde da sua frequncia.
  * 
- * @param nomeFicheiro --> Nome do ficheiro contendo as antenas.
- * @param grafo --> Apontador para o grafo onde as antenas sero carregadas.
- * @param ficheiro --> Apontador para o ficheiro aberto.
- * @param numLinhas --> Nmero de linhas do ficheiro (altura da matriz).
- * @param numColunas --> Nmero de colunas do ficheiro (largura da matriz).
- * @param bufferLinha --> Buffer para ler cada linha do ficheiro.
- * @param AdionarAntena --> Funo para adicionar uma antena ao grafo.
- * @return Grafo contendo as antenas carregadas.
+ * @param grafo --> Apontador para o grafo que contm os baldes.
+ * @param antena --> Apontador para a antena a registar.
+ * @param balde --> Apontador para o balde da frequncia da antena.
+ * @param novoVetor --> Apontador para o vetor realocado quando o balde fica cheio.
+ * @param return --> 0 se a antena foi registada, -1 se os argumentos forem nulos, -2 se falhar a alocao.
  */
-Grafo CarregarAntenasDoFicheiro(const char* nomeFicheiro) {
-	//Inicializa o grafo vazio
-    Grafo grafo = { NULL, 0 };
-
-	//Se o nome do ficheiro for nulo, retorna o grafo vazio
-    if (!nomeFicheiro) return grafo;
+int AdicionarAoBalde(Grafo* grafo, Antena* antena) {
+    if (!grafo || !antena) return -1;
 
-	//Abre o ficheiro para leitura
-    FILE* ficheiro = fopen(nomeFicheiro, "r");
-    if (!ficheiro) {
-		return grafo; // Se no conseguir abrir o ficheiro, retorna o grafo vazio
+    //Cria a tabela de baldes na primeira utilizao (uma entrada por frequncia possvel)
+    if (!grafo->baldes) {
+        grafo->baldes = calloc(NUM_FREQUENCIAS, sizeof(BaldeFrequencia));
+        if (!grafo->baldes) return -2;
     }
 
-	//L as dimenses do grafo (nmero de linhas e colunas)
-    int numLinhas, numColunas; 
-    if (fscanf(ficheiro, "%d %d", &numLinhas, &numColunas) != 2) {
-        fclose(ficheiro);
-        return grafo;
-    }
-
-	while (fgetc(ficheiro) != '\n');  //Ignora o restante da primeira linha(ex se tiver um espao)
+    BaldeFrequencia* balde = &grafo->baldes[(unsigned char)antena->frequencia];
 
-    char bufferLinha[1024];  // Buffer para ler cada linha do ficheiro
-    for (int y = 0; y < numLinhas && fgets(bufferLinha, sizeof(bufferLinha), ficheiro) != NULL; y++) {
+    //Se o vetor estiver cheio duplica a capacidade
+    if (balde->total == balde->capacidade) {
+        int novaCapacidade = balde->capacidade ? balde->capacidade * 2 : 8;
+        Antena** novoVetor = realloc(balde->antenas, novaCapacidade * sizeof(Antena*));
+        if (!novoVetor) return -2;
+        balde->antenas = novoVetor;
+        balde->capacidade = novaCapacidade;
+    }
 
-        bufferLinha[strcspn(bufferLinha, "\n")] = '\0';//remove o caractere de \n do final da linha
+    //Acrescenta no fim, para manter a ordem de insero
+    balde->antenas[balde->total++] = antena;
 
-		//Para cada caracter valido adiciona uma antena ao grafo com freq, coluna e linha
-        for (int x = 0; x < numColunas && x < (int)strlen(bufferLinha); x++) {
-            if (bufferLinha[x] != '.' && bufferLinha[x] != ' ') {
-                AdicionarAntena(&grafo, bufferLinha[x], x, y);
-            }
-        }
+    //Se a rvore espacial no conseguir crescer  descartada e reconstruda na prxima consulta
+    InserirNaArvore(grafo, antena);
+    if (AtualizarComponentesAntena(grafo, antena, 1) != 0) {
+        RetirarDaArvore(grafo, antena);
+        balde->total--;
+        return -2;
     }
+    return 0;
+}
+#pragma endregion
 
-	//fecha o ficheiro aps a leitura
-    fclose(ficheiro);
-
-    // Cria as adjacncias entre antenas da mesma frequncia
-    //percorre todas as antenas duas a duas 
-    for (Antena* a1 = grafo.antenas; a1 != NULL; a1 = a1->proxima) {
-        for (Antena* a2 = grafo.antenas; a2 != NULL; a2 = a2->proxima) {
-            //se nao forem a mesma antena e tiverem a mesma frequencia
-            if (a1 != a2 && a1->frequencia == a2->frequencia) {
-                AdicionarAdj(a1, a2);
-            }
-        }
+#pragma region RegistarAntena
+/**
+ * Funo para registar uma antena acabada de criar (popularAntena) no ndice espacial e no
+ * balde da sua frequncia, antes de ser ligada  lista. Ou fica registada nos dois, ou no
+ * fica em nenhum e  devolvida  arena, por isso uma falha nunca deixa uma antena a meio
+ * de ser inserida. Se j houver uma antena na mesma coordenada a nova no entra no ndice,
+ * como antes (s as funes que no verificam a posio o permitem).
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param antena --> Antena criada por popularAntena, ainda fora da lista.
+ * @param indexada --> Verdadeiro se a antena entrou no ndice (e tem de sair se o balde falhar).
+ * @param return --> 0 se a antena foi registada, -1 se os argumentos forem nulos,
+ *                   -2 se falhar a alocao (a antena foi libertada).
+ */
+int RegistarAntena(Grafo* grafo, Antena* antena) {
+    if (!grafo || !antena) return -1;
+
+    int estado = IndexarAntena(grafo, antena);
+    bool indexada = estado == 0;
+    if (estado == 0 || estado == -3) estado = AdicionarAoBalde(grafo, antena);
+    if (estado == 0) {
+        if (!indexada) grafo->antenasForaDoIndice++;
+        return 0;
     }
-    
-    return grafo;
+
+    if (indexada) DesindexarAntena(grafo, antena->coluna, antena->linha);
+    LibertarId(grafo, antena);
+    LibertarNo(grafo->arena, NO_ANTENA, antena);
+    return -2;
 }
 #pragma endregion
 
-#pragma region TravessiaEmProfundidade
+#pragma region RemoverDoBalde
 /**
- * Funo para realizar uma travessia em profundidade no grafo de antenas..
+ * Funo para retirar uma antena do balde da sua frequncia, mantendo a ordem das restantes.
+ * Custa O(tamanho do balde).
  * 
- * @param grafo --> Apontador para o grafo cujas antenas sero limpas.
- * @param atual --> Apontador para a antena atual.
- * @param saida --> Apontador para o ficheiro onde os resultados sero escritos.
- * @param visitada --> Indicador se a antena foi visitada.
- * @param adj --> Apontador para a lista de adjacncias da antena atual.
- * @param ligacoes --> Apontador para a lista de ligaes da antena atual.
- * @param proxima --> Apontador para a prxima antena na lista do grafo.
- * @param destino --> Apontador para a antena de destino na adjacncia.
- * @param return --> Verdadeiro se a travessia foi bem sucedida, falso caso contrrio.
+ * @param grafo --> Apontador para o grafo que contm os baldes.
+ * @param antena --> Apontador para a antena a retirar.
+ * @param balde --> Apontador para o balde da frequncia da antena.
+ * @param posicao --> Posio da antena no balde.
+ * @param return --> 0 se a antena foi retirada, -1 se os argumentos forem nulos, -3 se a antena no estiver no balde.
  */
-int TravessiaEmProfundidade(Grafo* grafo, Antena* atual, FILE* saida) {
-	if (!grafo || !atual || !saida) return -3; //se o grafo, antena atual e o arquivo de saida forem nulos, retorna falso
-	if (atual->visitada) return 0; //se a antena atual j tiver sido visitada, retorna verdadeiro
-
-	atual->visitada = true; //marca a antena atual como visitada
+int RemoverDoBalde(Grafo* grafo, Antena* antena) {
+    if (!grafo || !antena) return -1;
+    if (!grafo->baldes) return -3;
+
+    BaldeFrequencia* balde = &grafo->baldes[(unsigned char)antena->frequencia];
+    int posicao = 0;
+    while (posicao < balde->total && balde->antenas[posicao] != antena) posicao++;
+    CONTAR(CONTADOR_PASSOS_REMOVER, posicao);
+    if (posicao == balde->total) return -3;
+
+    memmove(&balde->antenas[posicao], &balde->antenas[posicao + 1], (balde->total - posicao - 1) * sizeof(Antena*));
+    balde->total--;
+    RetirarDaArvore(grafo, antena);
+    return AtualizarComponentesAntena(grafo, antena, -1);
+}
 
-    //Imprime no arquivo (ou onde for passado como saida) a frequncia e a posio (coluna e linha) da antena atual.
-    fprintf(saida, "Antena %c @ (%d,%d)\n", atual->frequencia, atual->coluna, atual->linha); 
+/**
+ * Funo para retirar muitas antenas dos baldes de uma s vez, mantendo a ordem das restantes.
+ * As antenas tm de j ter sado da tabela de ids (porId deixou de apontar para elas) e s
+ * podem ser devolvidas  arena depois desta chamada. Cada balde tocado  compactado numa s
+ * passagem, por isso custa O(removidas + tamanho dos baldes tocados) em vez de
+ * O(removidas * tamanho do balde) de chamar RemoverDoBalde para cada uma.
+ *
+ * @param grafo --> Apontador para o grafo que contm os baldes.
+ * @param removidas --> Antenas a retirar.
+ * @param total --> Nmero de antenas em removidas.
+ * @param tocados --> Frequncias com pelo menos uma antena a retirar.
+ * @param destino --> Prxima posio livre do balde compactado.
+ * @param return --> 0 se as antenas foram retiradas, -1 se os argumentos forem invlidos.
+ */
+int RemoverDosBaldes(Grafo* grafo, Antena* const* removidas, int total) {
+    if (!grafo || total < 0 || (total > 0 && !removidas)) return -1;
+    if (total == 0 || !grafo->baldes) return 0;
+
+    bool tocados[NUM_FREQUENCIAS] = { false };
+    for (int i = 0; i < total; i++) {
+        tocados[(unsigned char)removidas[i]->frequencia] = true;
+        RetirarDaArvore(grafo, removidas[i]);
+        AtualizarComponentesAntena(grafo, removidas[i], -1);
+    }
 
-	//Percorre todas as ligaes da antena atual
-    for (Adjacencia* adj = atual->ligacoes; adj != NULL; adj = adj->proxima) {
-		//para cada antena ligada a antena atual, chama recursivamente para visitar a proxima antena
-        TravessiaEmProfundidade(grafo, adj->destino, saida);
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) {
+        if (!tocados[f]) continue;
+        BaldeFrequencia* balde = &grafo->baldes[f];
+        int destino = 0;
+        for (int posicao = 0; posicao < balde->total; posicao++) {
+            Antena* antena = balde->antenas[posicao];
+            if (grafo->porId[antena->id] == antena) balde->antenas[destino++] = antena;
+        }
+        CONTAR(CONTADOR_PASSOS_REMOVER, balde->total);
+        balde->total = destino;
     }
     return 0;
 }
 #pragma endregion
 
-#pragma region TravessiaEmLargura
+#pragma region RegistarId
 /**
- * Funo para realizar uma travessia em largura no grafo de antenas.
+ * Funo para dar a uma antena um id livre do grafo e regist-la na tabela de ids.
+ * Os ids so densos (0..totalIds-1), o que permite guardar estado por antena em vetores;
+ * os ids das antenas removidas so reutilizados primeiro, por isso totalIds no passa do
+ * maior nmero de antenas que o grafo j teve ao mesmo tempo, por muitas alteraes que haja.
  * 
- * @param grafo --> Apontador para o grafo onde a travessia ser realizada.
- * @param inicio --> Apontador para a antena de incio da travessia.
- * @param saida --> Apontador para o ficheiro onde os resultados sero escritos.
- * @param FilaNo --> Estrutura para representar um n na fila de travessia.
- * @param frente --> Apontador para o incio da fila.
- * @param tras --> Apontador para o final da fila.
- * @param novo --> Apontador para um novo n a ser adicionado  fila.
- * @param visitada --> Indicador se a antena foi visitada.
- * @param Antena --> Estrutura que representa uma antena no grafo.
- * @param temp --> Apontador temporrio para armazenar o n atual da fila.
- * @param Adjacencia --> Estrutura que representa uma ligao entre antenas.
- * @param adj --> Apontador para a lista de adjacncias da antena atual.
- * @param atual --> Apontador para a antena atual sendo processada na travessia.
- * @param novoNo --> Apontador para um novo n a ser adicionado  fila.
- * @param return --> Verdadeiro se a travessia foi bem sucedida, falso caso contrrio.
+ * @param grafo --> Apontador para o grafo.
+ * @param antena --> Apontador para a antena a registar.
+ * @param novaTabela --> Tabela realocada quando fica cheia.
+ * @param novosLivres --> Pilha de ids livres realocada com a tabela (tem sempre a mesma capacidade).
+ * @param return --> 0 se a antena foi registada, -1 se os argumentos forem nulos, -2 se falhar a alocao.
  */
-int TravessiaEmLargura(Grafo* grafo, Antena* inicio, FILE* saida) {
-    //se o grafo, antena atual e o arquivo de saida forem nulos, retorna falso
-    if (!grafo || !inicio || !saida) return -4;
-
-    //Declara duas variveis para controlar a fila: frente (incio da fila) e tras (final da fila)
-    FilaNo* frente = NULL;
-    FilaNo* tras = NULL;
-
-	//Aloca memria para um novo n da fila e verifica se a alocao foi bem sucedida
-    FilaNo* novo = malloc(sizeof(FilaNo));
-    if (!novo) return -5;
-    novo->antena = inicio;
-    novo->proxima = NULL;
-
-    frente = tras = novo;//Define que o primeiro e ltimo elemento da fila  esse n
-    inicio->visitada = true;//Marca a antena de incio como visitada para no visit-la novamente
+int RegistarId(Grafo* grafo, Antena* antena) {
+    if (!grafo || !antena) return -1;
+
+    //Reutiliza o id da ltima antena removida
+    if (grafo->totalIdsLivres > 0) {
+        antena->id = grafo->idsLivres[--grafo->totalIdsLivres];
+        grafo->porId[antena->id] = antena;
+        return 0;
+    }
 
-	//Enquanto houver elementos na fila, processa cada antena
-    while (frente) {
+    //Se a tabela estiver cheia duplica a capacidade (e a da pilha, para LibertarId nunca alocar)
+    if (grafo->totalIds == grafo->capacidadeIds) {
+        int novaCapacidade = grafo->capacidadeIds ? grafo->capacidadeIds * 2 : 64;
+        int* novosLivres = realloc(grafo->idsLivres, novaCapacidade * sizeof(int));
+        if (!novosLivres) return -2;
+        grafo->idsLivres = novosLivres;
+        Antena** novaTabela = realloc(grafo->porId, novaCapacidade * sizeof(Antena*));
+        if (!novaTabela) return -2;
+        grafo->porId = novaTabela;
+        grafo->capacidadeIds = novaCapacidade;
+    }
 
-		Antena* atual = frente->antena; //Pega a antena atual do incio da fila
-		FilaNo* temp = frente; //Armazena o n atual da fila para liberar memria depois
-		frente = frente->proxima; //Move o incio da fila para o prximo n
-        free(temp);
+    antena->id = grafo->totalIds;
+    grafo->porId[grafo->totalIds++] = antena;
+    return 0;
+}
 
-        //Imprime no arquivo as informaes da antena atual
-        fprintf(saida, "Antena %c @ (%d,%d)\n", atual->frequencia, atual->coluna, atual->linha);
+/**
+ * Funo para tirar uma antena da tabela de ids e guardar o seu id para ser reutilizado.
+ * No aloca memria (a pilha tem a capacidade da tabela), por isso no falha a meio de uma remoo.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param antena --> Antena que sai do grafo.
+ * @param return --> 0 se o id foi libertado, -1 se os argumentos forem invlidos.
+ */
+int LibertarId(Grafo* grafo, Antena* antena) {
+    if (!grafo || !antena || antena->id < 0 || antena->id >= grafo->totalIds || grafo->porId[antena->id] != antena) return -1;
 
-		//Percorre todas as ligaes da antena atual
-        for (Adjacencia* adj = atual->ligacoes; adj != NULL; adj = adj->proxima) {
+    grafo->porId[antena->id] = NULL;
+    grafo->idsLivres[grafo->totalIdsLivres++] = antena->id;
+    return 0;
+}
+#pragma endregion
 
-			//Se a antena de destino ainda no foi visitada, marca como visitada e adiciona  fila
-            if (!adj->destino->visitada) {
-                adj->destino->visitada = true;
+#pragma region IniciarVizinhos
+/**
+ * Funo para preparar um iterador sobre os vizinhos de uma antena.
+ * A ordem  a mesma da antiga lista de ligaes: primeiro as arestas explcitas
+ * e depois as antenas da mesma frequncia, pela ordem de insero.
+ * 
+ * @param grafo --> Apontador para o grafo onde a antena est.
+ * @param antena --> Apontador para a antena cujos vizinhos vo ser percorridos.
+ * @param it --> Apontador para o iterador a inicializar.
+ * @param return --> 0 se o iterador foi inicializado, -1 se os argumentos forem nulos.
+ */
+int IniciarVizinhos(const Grafo* grafo, Antena* antena, IteradorVizinhos* it) {
+    if (!grafo || !antena || !it) return -1;
 
-				//Aloca memria para um novo n da fila
-                FilaNo* novoNo = malloc(sizeof(FilaNo));
-                if (!novoNo) continue;
+    it->origem = antena;
+    it->adj = antena->ligacoes;
+    it->balde = grafo->baldes ? &grafo->baldes[(unsigned char)antena->frequencia] : NULL;
+    it->indice = 0;
+    return 0;
+}
+#pragma endregion
 
-                //Adiciona esse novo n no final
-                novoNo->antena = adj->destino;
-                novoNo->proxima = NULL;
+#pragma region ProximoVizinho
+/**
+ * Funo para obter o prximo vizinho de um iterador.
+ * 
+ * @param it --> Apontador para o iterador.
+ * @param vizinho --> Apontador para a antena devolvida.
+ * @param return --> Apontador para o prximo vizinho ou NULL quando no houver mais.
+ */
+Antena* ProximoVizinho(IteradorVizinhos* it) {
+    if (!it) return NULL;
+
+    //Primeiro esgota as ligaes explcitas
+    if (it->adj) {
+        Antena* vizinho = it->adj->destino;
+        it->adj = it->adj->proxima;
+        CONTAR(CONTADOR_ARESTAS_PERCORRIDAS, 1);
+        return vizinho;
+    }
 
-                if (!frente) frente = novoNo;
-                else tras->proxima = novoNo;
-                tras = novoNo;
-            }
+    //Depois percorre o balde, saltando a prpria antena
+    while (it->balde && it->indice < it->balde->total) {
+        Antena* vizinho = it->balde->antenas[it->indice++];
+        if (vizinho != it->origem) {
+            CONTAR(CONTADOR_ARESTAS_PERCORRIDAS, 1);
+            return vizinho;
         }
     }
-    return 0;
+    return NULL;
 }
 #pragma endregion
 
-#pragma region ImprimirCaminho
+#pragma region CarregarAntenasDoFicheiro
 /**
- * Funo para imprimir o caminho de antenas.
+ * Funo para carregar antenas de um ficheiro e construir o grafo.
+ * A leitura  feita sobre o ficheiro mapeado em memria (CarregarAntenasParalelo),
+ * por isso as linhas podem ter qualquer largura; ficheiros grandes so lidos por todos
+ * os processadores e o grafo fica igual ao da leitura sequencial.
  * 
- * @param caminho --> Apontador para o n atual do caminho.
- * @param saida --> Apontador para o ficheiro onde o caminho ser impresso.
- * @param return --> Verdadeiro se o caminho foi impresso com sucesso, falso caso contrrio.
+ * @param nomeFicheiro --> Nome do ficheiro contendo as antenas.
+ * @param grafo --> Apontador para o grafo onde as antenas sero carregadas.
+ * @param CarregarAntenasParalelo --> Funo que l o ficheiro e adiciona as antenas ao grafo.
+ * @return Grafo contendo as antenas carregadas.
  */
-int ImprimirCaminho(CaminhoNo* caminho, FILE* saida) {
-	// Se o caminho for nulo, no h nada a imprimir
-    if (!caminho) return -6;
-
-    //Chama a funo recursivamente para imprimir o prximo elemento da lista antes de imprimir o atual
-    ImprimirCaminho(caminho->proxima, saida);
+Grafo CarregarAntenasDoFicheiro(const char* nomeFicheiro) {
+	//Inicializa o grafo vazio
+    Grafo grafo = { 0 };
 
-    //Imprime no arquivo 
-    fprintf(saida, "%c(%d,%d)", caminho->antena->frequencia,
-        caminho->antena->coluna,
-        caminho->antena->linha);
-    if (caminho->proxima)
-        fprintf(saida, " -> ");
+	//Se o nome do ficheiro for nulo, retorna o grafo vazio
+    if (!nomeFicheiro) return grafo;
 
-    return 0;
+    //L o cabealho e todas as linhas da grelha, adicionando cada antena com AdicionarAntena.
+    //As ligaes entre antenas da mesma frequncia ficam disponveis pelos baldes,
+    //preenchidos em AdicionarAntena, por isso no  preciso criar nenhuma Adjacencia aqui
+    CarregarAntenasParalelo(&grafo, nomeFicheiro, 0, NULL);
+    return grafo;
 }
 #pragma endregion
 
-#pragma region EncontrarCaminhosRec
+#pragma region TravessiaEmProfundidade
 /**
- * Funo recursiva para encontrar todos os caminhos entre duas antenas.
+ * Funo para realizar uma travessia em profundidade no grafo de antenas.
+ * As marcas de visita ficam num Visitados local (PercorrerEmProfundidade), por isso
+ * o grafo no  alterado e no  preciso chamar LimparVisitados depois.
  * 
- * @param grafo --> Apontador para o grafo onde as antenas esto localizadas.
- * @param atual --> Apontador para a antena atual no caminho.
- * @param destino --> Apontador para a antena de destino.
- * @param caminho --> Apontador para o n atual do caminho.
- * @param saida --> Apontador para o ficheiro onde os caminhos sero impressos.
- * @param novo --> Apontador para um novo n a ser adicionado ao caminho.
- * @param CaminhoNo --> Estrutura que representa um n em um caminho de antenas.
- * @param ImprimirCaminho --> Funo para imprimir o caminho encontrado.
- * @param Adjacencia --> Estrutura que representa uma ligao entre antenas.
- * @param adj --> Apontador para a lista de adjacncias da antena atual.
- * @param EncontrarCaminhosRec --> Funo recursiva para encontrar caminhos.
- * @param return --> Verdadeiro se os caminhos foram encontrados com sucesso, falso caso contrrio.
+ * @param grafo --> Apontador para o grafo a percorrer.
+ * @param atual --> Apontador para a antena onde a travessia comea.
+ * @param saida --> Apontador para o ficheiro onde os resultados sero escritos.
+ * @param visitados --> Marcas de visita desta travessia, indexadas pelo id das antenas.
+ * @param return --> 0 se a travessia foi feita, -3 se os argumentos forem nulos, -2 se falhar a alocao.
  */
-int EncontrarCaminhosRec(Grafo* grafo, Antena* atual, Antena* destino, CaminhoNo* caminho, FILE* saida) {
+int TravessiaEmProfundidade(Grafo* grafo, Antena* atual, FILE* saida) {
+	if (!grafo || !atual || !saida) return -3; //se o grafo, antena atual e o arquivo de saida forem nulos, retorna falso
 
-	//Cria um novo n para guardar a antena atual no caminho e se no conseguir alocar memria, retorna falso
-    CaminhoNo* novo = malloc(sizeof(CaminhoNo));
-    if (!novo) return -7;
+    Visitados visitados;
+    if (CriarVisitados(&visitados, grafo->totalIds) != 0) return -2;
+    int resultado = PercorrerEmProfundidade(grafo, atual, &visitados, saida);
+    LibertarVisitados(&visitados);
+    return resultado;
+}
+#pragma endregion
 
-    novo->antena = atual; //Guarda a antena atual no novo n
-	novo->proxima = caminho; //Coloca o novo n no incio do caminho
-    caminho = novo;
+#pragma region TravessiaEmLargura
+/**
+ * Funo para realizar uma travessia em largura no grafo de antenas.
+ * As marcas de visita ficam num Visitados local (PercorrerEmLargura), por isso
+ * o grafo no  alterado e no  preciso chamar LimparVisitados depois.
+ * 
+ * @param grafo --> Apontador para o grafo onde a travessia ser realizada.
+ * @param inicio --> Apontador para a antena de incio da travessia.
+ * @param saida --> Apontador para o ficheiro onde os resultados sero escritos.
+ * @param visitados --> Marcas de visita desta travessia, indexadas pelo id das antenas.
+ * @param return --> 0 se a travessia foi feita, -4 se os argumentos forem nulos, -5 se falhar a alocao.
+ */
+int TravessiaEmLargura(Grafo* grafo, Antena* inicio, FILE* saida) {
+    //se o grafo, antena atual e o arquivo de saida forem nulos, retorna falso
+    if (!grafo || !inicio || !saida) return -4;
 
-    atual->visitada = true; //Marca como visitada 
+    Visitados visitados;
+    if (CriarVisitados(&visitados, grafo->totalIds) != 0) return -5;
+    int resultado = PercorrerEmLargura(grafo, inicio, &visitados, saida);
+    LibertarVisitados(&visitados);
+    return resultado;
+}
+#pragma endregion
 
-	//Se a antena atual for a antena de destino, imprime o caminho encontrado
-    if (atual == destino) {
-        ImprimirCaminho(caminho, saida);
-        fprintf(saida, "\n");
-    }
-    else {
-		//Caso contrrio, percorre todas as ligaes da antena atual recursivamente
-        for (Adjacencia* adj = atual->ligacoes; adj != NULL; adj = adj->proxima) {
-            if (!adj->destino->visitada) {
-                EncontrarCaminhosRec(grafo, adj->destino, destino, caminho, saida);
-            }
-        }
+#pragma region ImprimirCaminho
+static void EscreverCaminho(Antena** caminho, int comprimento, EscritorTexto* escritor) {
+    for (int i = 0; i < comprimento; i++) {
+        EscreverCaracter(escritor, caminho[i]->frequencia);
+        EscreverCoordenada(escritor, caminho[i]->coluna, caminho[i]->linha);
+        if (i + 1 < comprimento)
+            EscreverBytes(escritor, " -> ", 4);
     }
+    EscreverCaracter(escritor, '\n');
+}
 
-	atual->visitada = false; //Quando acaba de procurar ,desmarca a antena atual para permitir verificar outros caminhos
-    free(caminho);
-    return 0;
+/**
+ * Funo para imprimir um caminho de antenas, da origem ao destino, seguido de uma mudana de linha.
+ * 
+ * @param caminho --> Vetor com as antenas do caminho.
+ * @param comprimento --> Nmero de antenas do caminho.
+ * @param saida --> Apontador para o ficheiro onde o caminho ser impresso.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param return --> 0 se o caminho foi impresso, -6 se o caminho for nulo ou vazio, -3 se a escrita falhar.
+ */
+int ImprimirCaminho(Antena** caminho, int comprimento, FILE* saida) {
+	// Se o caminho for nulo, no h nada a imprimir
+    if (!caminho || comprimento <= 0 || !saida) return -6;
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    EscreverCaminho(caminho, comprimento, &escritor);
+    return DescarregarEscritor(&escritor);
 }
 #pragma endregion
 
 #pragma region EncontrarCaminhos
+static int ImprimirCaminhoEncontrado(Antena** caminho, int comprimento, void* contexto) {
+    EscreverCaminho(caminho, comprimento, (EscritorTexto*)contexto);
+    return ((EscritorTexto*)contexto)->erro;
+}
+
 /**
- * Funo para encontrar todos os caminhos entre duas antenas no grafo.
+ * Escreve em escritor os caminhos simples de origem a destino, dentro dos limites, e uma
+ * linha a dizer que a procura foi interrompida se algum limite for atingido.
+ */
+static int EscreverCaminhosEncontrados(Grafo* grafo, Antena* origem, Antena* destino, const LimitesCaminhos* limites,
+    EscritorTexto* escritor) {
+    ConsultaCaminhos consulta = { CAMINHOS_TODOS, 0, *limites, ImprimirCaminhoEncontrado, escritor };
+    ResultadoCaminhos resultado;
+    int estado = ProcurarCaminhos(grafo, origem, destino, &consulta, &resultado);
+    if (estado == 0 && resultado.truncado && escritor->erro == 0) {
+        EscreverTexto(escritor, "... procura interrompida (");
+        EscreverTexto(escritor, resultado.esgotouTempo ? "tempo esgotado" : "limite de caminhos");
+        EscreverTexto(escritor, ") depois de ");
+        EscreverInteiro(escritor, resultado.caminhos);
+        EscreverTexto(escritor, " caminhos\n");
+    }
+    return escritor->erro != 0 ? escritor->erro : estado;
+}
+
+/**
+ * Funo para encontrar os caminhos simples entre duas antenas no grafo.
+ * Usa ProcurarCaminhos (modo CAMINHOS_TODOS) com limites de caminhos e de tempo, para que
+ * um par de antenas com muitos caminhos no bloqueie o relatrio; se a procura for
+ * interrompida,  escrita uma linha a diz-lo depois dos caminhos.
  *
  * @param grafo --> Apontador para o grafo onde as antenas esto localizadas.
  * @param origem --> Apontador para a antena de origem.
  * @param destino --> Apontador para a antena de destino.
  * @param saida --> Apontador para o ficheiro onde os caminhos sero impressos.
- * @param EncontrarCaminhosRec --> Funo recursiva para encontrar caminhos.
- * @param LimparVisitados --> Funo para limpar os visitados das antenas.
- * @return Verdadeiro se os caminhos foram encontrados com sucesso, falso caso contrrio.
+ * @param escritor --> Escritor com buffer para saida, partilhado por todos os caminhos.
+ * @param limites --> Limites do relatrio (MAX_CAMINHOS_RELATORIO caminhos, MAX_SEGUNDOS_CAMINHOS segundos).
+ * @return 0 se a procura foi feita, valor negativo caso contrrio.
  */
 int EncontrarCaminhos(Grafo* grafo, Antena* origem, Antena* destino, FILE* saida) {
 	// Se o grafo, origem, destino ou saida forem nulos, no  possvel encontrar caminhos
-    if (!grafo || !origem || !destino || !saida) return false;
-
-    //Reseta o estado de todas as antenas para no visitadas
-    LimparVisitados(grafo);
-    //Chama a funo recursiva que vai procurar todos os caminhos da antena origem at a destino
-    //Passa NULL como caminho inicial (porque ainda no tem antenas no caminho)
-    //Passa o arquivo saida para onde os caminhos encontrados sero impressos
-    return EncontrarCaminhosRec(grafo, origem, destino, NULL, saida);
+    if (!grafo || !origem || !destino || !saida) return -7;
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    LimitesCaminhos limites = { MAX_CAMINHOS_RELATORIO, 0, MAX_SEGUNDOS_CAMINHOS };
+    int estado = EscreverCaminhosEncontrados(grafo, origem, destino, &limites, &escritor);
+    int escrita = DescarregarEscritor(&escritor);
+    return estado != 0 ? estado : escrita;
 }
 #pragma endregion
 
 #pragma region MostrarIntersecoes
 /**
  * Mostra as intersees entre antenas de diferentes frequncias.
+ * Para cada antena de freqA, pela ordem da lista, escreve as antenas de freqB na mesma linha
+ * ou coluna, tambm pela ordem da lista. A procura  feita no ndice de intersees,
+ * sem comparar todas as antenas com todas.
  * 
  * @param grafo --> Apontador para o grafo onde as antenas esto localizadas.
  * @param freqA --> Frequncia da primeira antena.
  * @param freqB --> Frequncia da segunda antena.
- * @param saida --> Apontador para o ficheiro onde as intersees sero escritas.q
- * @param Antena --> Estrutura que representa uma antena no grafo.
- * @param proxima --> Apontador para a prxima antena na lista do grafo.
- * @param return --> Verdadeiro se as intersees foram mostradas com sucesso, falso caso contrrio.
+ * @param saida --> Apontador para o ficheiro onde as intersees sero escritas.
+ * @param indice --> ndice de intersees do grafo (antenas ordenadas por linha e por coluna).
+ * @param return --> 0 se as intersees foram mostradas, -8 se os argumentos forem nulos,
+ *                   -2 se falhar a alocao.
  */
 int MostrarIntersecoes(Grafo* grafo, char freqA, char freqB, FILE* saida) {
     //Se o grafo ou o arquivo de sada forem nulos, retorna falso 
     if (!grafo || !saida) return -8;
 
-    //Percorre todas as antenas do grafo (cada antena  apontada por a)
-    for (Antena* a = grafo->antenas; a != NULL; a = a->proxima) {
+    //Ordena as antenas por linha e por coluna (e, dentro delas, por frequncia)
+    IndiceIntersecoes indice;
+    if (ConstruirIndiceIntersecoes(grafo, &indice) != 0) return -2;
 
-		//Se a antena atual tiver a frequncia freqA
-        if (a->frequencia == freqA) {
-			//Procura por antenas com a frequncia freqB que estejam na mesma linha ou coluna
-            for (Antena* b = grafo->antenas; b != NULL; b = b->proxima) {
-				//Se a antena b tiver a frequncia freqB e estiver na mesma linha ou coluna que A
-                if (b->frequencia == freqB && (a->linha == b->linha || a->coluna == b->coluna)) {
-					//Escreve no arquivo de sada a interseo entre as antenas A e B
-                    fprintf(saida, "%c(%d,%d) - %c(%d,%d)\n",
-                        freqA, a->coluna, a->linha,
-                        freqB, b->coluna, b->linha);
-                }
-            }
-        }
-    }
+    //Escreve as antenas de freqB que esto na mesma linha ou coluna de cada antena de freqA
+    EscreverIntersecoesPar(&indice, freqA, freqB, saida);
+
+    LibertarIndiceIntersecoes(&indice);
     return 0;
 }
 #pragma endregion
@@ -382,154 +522,395 @@ int MostrarIntersecoes(Grafo* grafo, char freqA, char freqB, FILE* saida) {
 #pragma region MostrarInterferencias
 /**
  * Funo para mostrar os pontos de interferncia entre antenas.
+ * S antenas com a mesma frequncia interferem, por isso o clculo  feito frequncia
+ * a frequncia, em paralelo (EscreverPontosInterferencia). A sada  igual  do antigo
+ * duplo ciclo sobre a lista, incluindo os pontos repetidos.
  * 
  * @param grafo --> Apontador para o grafo onde as antenas esto localizadas.
  * @param saida --> Apontador para o ficheiro onde os pontos de interferncia sero escritos.
- * @param Antena --> Estrutura que representa uma antena no grafo.
- * @param proxima --> Apontador para a prxima antena na lista do grafo.
- * @param dx --> Diferena entre as colunas das antenas.
- * @param dy --> Diferena entre as linhas das antenas.
- * @param k --> Contador para calcular os pontos de interferncia.
- * @param return --> Verdadeiro se os pontos de interferncia foram mostrados com sucesso, falso caso contrrio.
+ * @param opcoes --> Opes do clculo: todos os processadores, com os pontos repetidos.
+ * @param return --> 0 se os pontos de interferncia foram mostrados, valor negativo caso contrrio.
  */
 int MostrarInterferencias(Grafo* grafo, FILE* saida) {
     //Se o grafo ou o arquivo de sada forem nulos, retorna falso
     if (!grafo || !saida) return -9;
 
-    fprintf(saida, "=== PONTOS DE INTERFERENCIA ===\n");
-
-    //Faz um duplo loop para comparar todas as antenas com todas as outras
-    for (Antena* a1 = grafo->antenas; a1 != NULL; a1 = a1->proxima) {
-        for (Antena* a2 = grafo->antenas; a2 != NULL; a2 = a2->proxima) {
-            //Considera s antenas que tenham a mesma frequncia
-            if (a1->frequencia == a2->frequencia) {
-                //Calcula a diferena nas colunas (x) e nas linhas (y) entre as duas antenas
-                int dx = a2->coluna - a1->coluna;
-                int dy = a2->linha - a1->linha;
-
-                //Verifica se as antenas esto alinhadas:Na mesma coluna(dx == 0),Na mesma linha(dy == 0),Ou numa diagonal perfeita
-                if (dx == 0 || dy == 0 || abs(dx) == abs(dy)) {
-                    for (int k = 1; k < 3; k++) {
-                        int x = a1->coluna + (k * dx) / 3;
-                        int y = a1->linha + (k * dy) / 3;
-
-						//Escreve no arquivo de sada o ponto de interferncia calculado
-                        fprintf(saida, "(%d,%d)\n", x, y);
-                    }
-                }
-            }
-        }
-    }
-    return 0;
+    OpcoesInterferencias opcoes = { 0, false };
+    return MostrarInterferenciasOpcoes(grafo, &opcoes, saida);
 }
 #pragma endregion
 
 #pragma region Resultados
+//Nome de cada seco nos intervalos da instrumentao, pela posio do seu bit em AnaliseRelatorio
+static const char* const NOMES_SECCOES_RELATORIO[NUM_ANALISES] = {
+    "antenas", "profundidade", "largura", "componentes", "caminhos", "intersecoes", "interferencias"
+};
+
+/**
+ * Relatrio em preparao: as opes com os valores predefinidos j resolvidos e as
+ * seces que tm alguma coisa a escrever, pela ordem do relatrio.
+ * @param grafo --> Grafo analisado.
+ * @param opcoes --> Opes resolvidas (inicio, origem, destino e limites preenchidos).
+ * @param seccoes --> Anlises a escrever (uma AnaliseRelatorio por seco).
+ * @param posicoes --> Posio do bit de cada seco em AnaliseRelatorio.
+ * @param custos --> Custo de cada seco.
+ * @param totalSeccoes --> Nmero de seces.
+ * @param textos --> Texto de cada seco, quando as seces so feitas em paralelo.
+ */
+typedef struct PlanoRelatorio {
+    Grafo* grafo;
+    OpcoesRelatorio opcoes;
+    AnaliseRelatorio seccoes[NUM_ANALISES];
+    int posicoes[NUM_ANALISES];
+    Medicao custos[NUM_ANALISES];
+    int totalSeccoes;
+    BufferTexto* textos;
+} PlanoRelatorio;
+
 /**
- * Funo para gerar os resultados das anlises e escrever em um ficheiro.
+ * Cdigo de uma seco depois de a percorrer: o erro do escritor se alguma escrita falhou
+ * (foi o visitante que parou a procura, por isso o cdigo da procura no diz porqu),
+ * -2 se a procura falhou por outra razo e 0 caso contrrio (como EstadoSeccao na exportao).
+ *
+ * @param escritor --> Escritor da seco.
+ * @param resultado --> Cdigo (ou nmero de elementos) devolvido pela procura.
+ * @param return --> 0, -2 se falhar a alocao, ou o erro do escritor.
+ */
+static int EstadoEscrita(const EscritorTexto* escritor, long long resultado) {
+    if (escritor->erro != 0) return escritor->erro;
+    return resultado < 0 ? -2 : 0;
+}
+
+/**
+ * Escreve uma seco do relatrio (ttulo e contedo) em escritor.
+ * S l o grafo (as componentes j esto rotuladas), por isso vrias seces podem
+ * ser escritas ao mesmo tempo, cada uma no seu escritor.
+ *
+ * @param plano --> Relatrio em preparao.
+ * @param analise --> Seco a escrever.
+ * @param escritor --> Destino do texto.
+ * @param visitados --> Marcas de visita das travessias.
+ * @param indice --> ndice de intersees do grafo.
+ * @param return --> 0 se a seco foi escrita, -2 se falhar a alocao, ou o erro do escritor.
+ */
+static int EscreverSeccao(const PlanoRelatorio* plano, AnaliseRelatorio analise, EscritorTexto* escritor) {
+    Grafo* grafo = plano->grafo;
+    const OpcoesRelatorio* opcoes = &plano->opcoes;
+    int resultado = 0;
+
+    switch (analise) {
+    case ANALISE_ANTENAS:
+        //escreve o numero total de antenas e as posies e frequncias de cada uma
+        EscreverTexto(escritor, "=== ANTENAS (");
+        EscreverInteiro(escritor, grafo->totalAntenas);
+        EscreverTexto(escritor, ") ===\n");
+        for (Antena* a = grafo->antenas; a != NULL; a = a->proxima) {
+            EscreverCaracter(escritor, a->frequencia);
+            EscreverBytes(escritor, " @ ", 3);
+            EscreverCoordenada(escritor, a->coluna, a->linha);
+            EscreverCaracter(escritor, '\n');
+        }
+        break;
+
+    case ANALISE_PROFUNDIDADE:
+    case ANALISE_LARGURA: {
+        Visitados visitados;
+        if (CriarVisitados(&visitados, grafo->totalIds) != 0) return -2;
+        if (analise == ANALISE_PROFUNDIDADE) {
+            EscreverTexto(escritor, "=== PROCURA EM PROFUNDIDADE ===\n");
+            resultado = PercorrerEmProfundidadeVisitante(grafo, opcoes->inicio, &visitados, EscreverAntenaVisitada, escritor);
+        }
+        else {
+            EscreverTexto(escritor, "=== PROCURA EM LARGURA ===\n");
+            resultado = PercorrerEmLarguraVisitante(grafo, opcoes->inicio, &visitados, EscreverAntenaVisitada, escritor);
+        }
+        LibertarVisitados(&visitados);
+        resultado = EstadoEscrita(escritor, resultado);
+        if (resultado != 0) return resultado;
+        break;
+    }
+
+    case ANALISE_COMPONENTES:
+        //componentes fracamente ligadas de toda a rede (no s as alcanveis a partir da primeira antena)
+        EscreverTexto(escritor, "=== COMPONENTES (");
+        EscreverInteiro(escritor, TotalComponentes(grafo));
+        EscreverTexto(escritor, ") ===\n");
+        for (int c = 0; c < TotalComponentes(grafo); c++) {
+            EscreverTexto(escritor, "Componente ");
+            EscreverInteiro(escritor, c);
+            EscreverTexto(escritor, ": ");
+            EscreverInteiro(escritor, TamanhoComponente(grafo, c));
+            EscreverTexto(escritor, " antenas, ");
+            EscreverInteiro(escritor, FrequenciasComponente(grafo, c));
+            EscreverTexto(escritor, " frequencias\n");
+        }
+        break;
+
+    case ANALISE_CAMINHOS:
+        EscreverTexto(escritor, "=== CAMINHOS ENTRE ANTENAS ===\n");
+        resultado = EscreverCaminhosEncontrados(grafo, opcoes->origem, opcoes->destino, &opcoes->limitesCaminhos, escritor);
+        if (resultado != 0) return resultado;
+        break;
+
+    case ANALISE_INTERSECOES: {
+        //sem pares de frequncias, todas as intersees (cada par de frequncias uma s vez)
+        IndiceIntersecoes indice;
+        if (ConstruirIndiceIntersecoes(grafo, &indice) != 0) return -2;
+        EscreverTexto(escritor, "=== INTERSECOES ===\n");
+        if (!opcoes->paresFrequencias) {
+            resultado = PercorrerTodasIntersecoes(&indice, EscreverIntersecao, escritor);
+        }
+        for (const char* par = opcoes->paresFrequencias; par && par[0] && resultado >= 0; par += 2) {
+            resultado = PercorrerIntersecoesPar(&indice, par[0], par[1], EscreverIntersecao, escritor);
+        }
+        LibertarIndiceIntersecoes(&indice);
+        resultado = EstadoEscrita(escritor, resultado);
+        if (resultado != 0) return resultado;
+        break;
+    }
+
+    case ANALISE_INTERFERENCIAS: {
+        EscreverTexto(escritor, "=== INTERFERENCIAS ===\n=== PONTOS DE INTERFERENCIA ===\n");
+        long long pontos = EscreverPontosInterferenciaEscritor(grafo, &opcoes->interferencias, escritor);
+        if (escritor->erro != 0) return escritor->erro;
+        if (pontos < 0) return (int)pontos;
+        break;
+    }
+
+    default:
+        break;
+    }
+    return escritor->erro;
+}
+
+/**
+ * Tarefa de ExecutarEmParalelo: escreve uma seco no seu buffer. As tarefas so entregues
+ * da ltima seco para a primeira, porque as ltimas (intersees, interferncias) so
+ * normalmente as mais demoradas e assim comeam primeiro. O tempo de CPU do processo
+ * inclui o das outras seces, por isso s o tempo de relgio fica registado.
+ */
+static int EscreverSeccaoEmMemoria(int indiceTarefa, void* contexto) {
+    PlanoRelatorio* plano = contexto;
+    int s = plano->totalSeccoes - 1 - indiceTarefa;
+    Medicao inicio;
+    IniciarMedicao(&inicio);
+    ABRIR_SPAN(span, NOMES_SECCOES_RELATORIO[plano->posicoes[s]]);
+    EscritorTexto escritor;
+    IniciarEscritorMemoria(&escritor, &plano->textos[s]);
+    int resultado = EscreverSeccao(plano, plano->seccoes[s], &escritor);
+    int escrita = DescarregarEscritor(&escritor);
+    FECHAR_SPAN(span);
+    TerminarMedicao(&inicio, &plano->custos[s]);
+    plano->custos[s].segundosCPU = -1;
+    return resultado != 0 ? resultado : escrita;
+}
+
+/**
+ * Funo para gerar os resultados das anlises escolhidas e escrev-los num ficheiro.
+ * As seces saem sempre pela ordem do relatrio, separadas por uma linha vazia. Com mais
+ * de uma thread e mais de uma seco, cada seco  escrita em paralelo no seu buffer em
+ * memria e os buffers so juntos no fim; com uma thread, as seces so escritas uma a
+ * uma diretamente no ficheiro. As seces que no tm nada a analisar (por exemplo, os
+ * caminhos quando no h destino) so omitidas.
  *
  * @param grafo --> Grafo contendo as antenas carregadas.
  * @param nomeFicheiro --> Nome do ficheiro onde os resultados sero escritos.
+ * @param opcoes --> Anlises e parmetros (NULL para o relatrio completo de Resultados).
+ * @param estatisticas --> Onde guardar o custo de cada fase (pode ser NULL).
+ * @param plano --> Opes resolvidas e seces a escrever.
+ * @param componentesProprias --> As componentes foram rotuladas aqui e so libertadas no fim.
+ * @param rotulagem --> Custo de rotular as componentes, somado ao da sua seco.
+ * @param inicio --> Medio no incio de cada fase.
  * @param saida --> Apontador para o ficheiro aberto para escrita.
- * @param primeira --> Apontador para a primeira antena no grafo.
- * @param terceira --> Apontador para a terceira antena no grafo (se houver).
- * @param return --> Verdadeiro se os resultados foram gerados com sucesso, falso caso contrrio.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param return --> 0 se os resultados foram escritos, -10 se o nome do ficheiro for invlido,
+ *                   -11 se o ficheiro no puder ser aberto, -12 se o grafo ou as opes forem invlidos,
+ *                   -2 se falhar a alocao, -3 se a escrita falhar.
  */
-int Resultados(Grafo grafo, const char* nomeFicheiro) {
+int ResultadosOpcoes(Grafo* grafo, const char* nomeFicheiro, const OpcoesRelatorio* opcoes, EstatisticasRelatorio* estatisticas) {
     //se o nome do ficheiro for invalido retorna falso
     if (!nomeFicheiro) return -10;
+    if (!grafo) return -12;
+
+    PlanoRelatorio plano;
+    memset(&plano, 0, sizeof(PlanoRelatorio));
+    plano.grafo = grafo;
+    if (opcoes) plano.opcoes = *opcoes;
+    else plano.opcoes.analises = ANALISE_TODAS;
+    OpcoesRelatorio* resolvidas = &plano.opcoes;
+    if (resolvidas->paresFrequencias && strlen(resolvidas->paresFrequencias) % 2 != 0) return -12;
+
+    //por omisso, as travessias comeam na primeira antena e os caminhos vo da primeira  terceira
+    Antena* primeira = grafo->antenas;
+    if (!resolvidas->inicio) resolvidas->inicio = primeira;
+    if (!resolvidas->origem) resolvidas->origem = primeira;
+    if (!resolvidas->destino && grafo->totalAntenas > 2) resolvidas->destino = primeira->proxima->proxima;
+    const LimitesCaminhos* limites = &resolvidas->limitesCaminhos;
+    if (limites->maxCaminhos == 0 && limites->maxProfundidade == 0 && limites->maxSegundos == 0) {
+        LimitesCaminhos relatorio = { MAX_CAMINHOS_RELATORIO, 0, MAX_SEGUNDOS_CAMINHOS };
+        resolvidas->limitesCaminhos = relatorio;
+    }
+
+    //sem antenas s h a lista (vazia); as outras seces precisam das antenas que lhes faltarem
+    for (int a = 0; a < NUM_ANALISES; a++) {
+        AnaliseRelatorio analise = (AnaliseRelatorio)(1 << a);
+        if (!(resolvidas->analises & analise)) continue;
+        if (analise != ANALISE_ANTENAS && grafo->totalAntenas == 0) continue;
+        if ((analise == ANALISE_PROFUNDIDADE || analise == ANALISE_LARGURA) && !resolvidas->inicio) continue;
+        if (analise == ANALISE_CAMINHOS && (!resolvidas->origem || !resolvidas->destino)) continue;
+        plano.posicoes[plano.totalSeccoes] = a;
+        plano.seccoes[plano.totalSeccoes++] = analise;
+    }
+
+    //as componentes so rotuladas antes de as seces comearem, porque as outras s leem o grafo;
+    //se o grafo recebido j as tiver, so dele e no se libertam aqui
+    bool componentesProprias = false;
+    Medicao rotulagem = { 0 }, inicio;
+    for (int s = 0; s < plano.totalSeccoes; s++) {
+        if (plano.seccoes[s] != ANALISE_COMPONENTES || grafo->componentes) continue;
+        IniciarMedicao(&inicio);
+        ABRIR_SPAN(span, "rotular componentes");
+        int rotuladas = RotularComponentes(grafo);
+        FECHAR_SPAN(span);
+        if (rotuladas < 0) return -2;
+        TerminarMedicao(&inicio, &rotulagem);
+        componentesProprias = true;
+    }
 
     //tenta abrir o ficheiro para escrita
     FILE* saida = fopen(nomeFicheiro, "w");
     if (!saida) {
+        if (componentesProprias) LibertarComponentes(grafo);
         return -11;
     }
 
-    //escreve o numero total de antenas no inicio
-    fprintf(saida, "=== ANTENAS (%d) ===\n", grafo.totalAntenas);
-
-    //percorre todas as antenas e as suas posies e frequencias 
-    for (Antena* a = grafo.antenas; a != NULL; a = a->proxima) {
-        fprintf(saida, "%c @ (%d,%d)\n", a->frequencia, a->coluna, a->linha);
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    int numThreads = resolvidas->numThreads > 0 ? resolvidas->numThreads : NumeroProcessadores();
+    bool paralelo = numThreads > 1 && plano.totalSeccoes > 1;
+    int resultado = 0;
+    if (!paralelo) {
+        for (int s = 0; s < plano.totalSeccoes && resultado == 0; s++) {
+            IniciarMedicao(&inicio);
+            ABRIR_SPAN(span, NOMES_SECCOES_RELATORIO[plano.posicoes[s]]);
+            if (s > 0) EscreverCaracter(&escritor, '\n');
+            resultado = EscreverSeccao(&plano, plano.seccoes[s], &escritor);
+            FECHAR_SPAN(span);
+            TerminarMedicao(&inicio, &plano.custos[s]);
+        }
+        IniciarMedicao(&inicio);
     }
-
-    //se houver antenas 
-    if (grafo.totalAntenas > 0) {
-        Antena* primeira = grafo.antenas;
-
-        //procura e escreve em profundidade
-        fprintf(saida, "\n=== PROCURA EM PROFUNDIDADE ===\n");
-        TravessiaEmProfundidade(&grafo, primeira, saida);
-        LimparVisitados(&grafo);
-        
-        //procura e escreve em largura
-        fprintf(saida, "\n=== PROCURA EM LARGURA ===\n");
-        TravessiaEmLargura(&grafo, primeira, saida);
-        LimparVisitados(&grafo);
-
-        //se houver mais de duas antenas ou at uma terceira 
-        if (grafo.totalAntenas > 2) {
-            //mostra os caminhos entre elas
-            Antena* terceira = primeira->proxima->proxima;
-            fprintf(saida, "\n=== CAMINHOS ENTRE ANTENAS ===\n");
-            EncontrarCaminhos(&grafo, primeira, terceira, saida);
+    else {
+        //as interferncias correm numa das threads das seces e s usam as que as outras seces deixam livres,
+        //para que o relatrio nunca tenha mais de numThreads threads a trabalhar
+        int livres = numThreads - plano.totalSeccoes + 1;
+        if (livres < 1) livres = 1;
+        if (resolvidas->interferencias.numThreads <= 0 || resolvidas->interferencias.numThreads > livres) {
+            resolvidas->interferencias.numThreads = livres;
         }
-
-        //mostra todas as intersees
-        fprintf(saida, "\n=== INTERSECOES ===\n");
-        for (Antena* a1 = grafo.antenas; a1 != NULL; a1 = a1->proxima) {
-            for (Antena* a2 = grafo.antenas; a2 != NULL; a2 = a2->proxima) {
-                if (a1->frequencia != a2->frequencia) {
-                    MostrarIntersecoes(&grafo, a1->frequencia, a2->frequencia, saida);
-                }
-            }
+        plano.textos = calloc(plano.totalSeccoes, sizeof(BufferTexto));
+        if (!plano.textos) resultado = -2;
+        ABRIR_SPAN(spanSeccoes, "seccoes em paralelo");
+        if (resultado == 0) resultado = ExecutarEmParalelo(plano.totalSeccoes, numThreads, EscreverSeccaoEmMemoria, &plano);
+        FECHAR_SPAN(spanSeccoes);
+        IniciarMedicao(&inicio);
+        ABRIR_SPAN(spanJuntar, "juntar seccoes");
+        for (int s = 0; s < plano.totalSeccoes && resultado == 0; s++) {
+            if (s > 0) EscreverCaracter(&escritor, '\n');
+            if (plano.textos[s].tamanho > 0) EscreverBytes(&escritor, plano.textos[s].dados, plano.textos[s].tamanho);
         }
+        FECHAR_SPAN(spanJuntar);
+        for (int s = 0; s < plano.totalSeccoes && plano.textos; s++) LibertarBuffer(&plano.textos[s]);
+        free(plano.textos);
+    }
 
-        //mostra as interderencias
-        fprintf(saida, "\n=== INTERFERENCIAS ===\n");
-        MostrarInterferencias(&grafo, saida);
+    //uma escrita que falha prevalece sobre os outros erros, para o ficheiro incompleto no passar despercebido
+    ABRIR_SPAN(spanEscrita, "escrita");
+    if (DescarregarEscritor(&escritor) != 0) resultado = -3;
+    long long bytes = ftell(saida);
+    if (fclose(saida) != 0) resultado = -3;
+    FECHAR_SPAN(spanEscrita);
+    if (componentesProprias) LibertarComponentes(grafo);
+
+    if (estatisticas) {
+        memset(estatisticas, 0, sizeof(EstatisticasRelatorio));
+        TerminarMedicao(&inicio, &estatisticas->escrita);
+        for (int s = 0; s < plano.totalSeccoes; s++) {
+            Medicao* custo = &estatisticas->seccoes[plano.posicoes[s]];
+            *custo = plano.custos[s];
+            if (plano.seccoes[s] != ANALISE_COMPONENTES) continue;
+            custo->segundos += rotulagem.segundos;
+            if (custo->segundosCPU >= 0) custo->segundosCPU += rotulagem.segundosCPU;
+        }
+        estatisticas->threads = paralelo ? numThreads : 1;
+        estatisticas->bytes = bytes;
     }
+    return resultado;
+}
 
-    fclose(saida);
-    return 0;
+/**
+ * Funo para gerar os resultados de todas as anlises e escrever em um ficheiro
+ * (ver ResultadosOpcoes): lista das antenas, travessias a partir da primeira antena,
+ * caminhos entre a primeira e a terceira antenas, todas as intersees e os pontos
+ * de interferncia. As componentes s saem quando pedidas em OpcoesRelatorio.
+ *
+ * @param grafo --> Grafo contendo as antenas carregadas.
+ * @param nomeFicheiro --> Nome do ficheiro onde os resultados sero escritos.
+ * @param return --> 0 se os resultados foram gerados com sucesso, valor negativo caso contrrio.
+ */
+int Resultados(Grafo grafo, const char* nomeFicheiro) {
+    return ResultadosOpcoes(&grafo, nomeFicheiro, NULL, NULL);
 }
 #pragma endregion
 
 #pragma region LibertarGrafo
 /**
  * Funo para libertar a memria alocada para o grafo e suas antenas.
+ * Antenas e adjacncias saem todas da arena do grafo,
+ * por isso basta devolver os blocos da arena, sem percorrer as listas.
  *
  * @param grafo --> Apontador para o grafo a ser libertado.
- * @param atual --> Apontador para a antena atual sendo processada.
- * @param adj --> Apontador para a lista de adjacncias da antena atual.
- * @param temp --> Apontador temporrio para armazenar a antena atual.
+ * @param DestruirArena --> Funo que liberta todos os blocos da arena.
  * @return Verdadeiro se o grafo foi libertado com sucesso, falso caso contrrio.
  */
 int LibertarGrafo(Grafo* grafo) {
     //Se o ponteiro para o grafo for nulo retorma falso
     if (!grafo) return -13;
 
-    //comea pela primeria antena da lista
-    Antena* atual = grafo->antenas;
-    
-    //vai percirrebdi todas as antenas e liberta aS Ligaes
-    while (atual) {
-        Adjacencia* adj = atual->ligacoes;
-        while (adj) {
-            Adjacencia* temp = adj;
-            adj = adj->proxima;
-            free(temp);
-        }
+    //liberta de uma s vez todas as antenas e ligaes (blocos da arena)
+    if (grafo->arena) {
+        DestruirArena(grafo->arena);
+    }
 
-        //depois liberta as anenas
-        Antena* temp = atual;
-        atual = atual->proxima;
-        free(temp);
+    //liberta os vetores dos baldes de frequncia
+    if (grafo->baldes) {
+        for (int f = 0; f < NUM_FREQUENCIAS; f++) {
+            free(grafo->baldes[f].antenas);
+        }
+        free(grafo->baldes);
     }
 
+    //liberta o ndice espacial, a tabela de ids, as componentes e a rvore espacial
+    LibertarIndice(grafo->indice);
+    free(grafo->porId);
+    free(grafo->idsLivres);
+    LibertarComponentes(grafo);
+    LibertarArvoreEspacial(grafo);
+
     //marca agora que o grafo esta vazio 
     grafo->antenas = NULL;
     grafo->totalAntenas = 0;
+    grafo->baldes = NULL;
+    grafo->arena = NULL;
+    grafo->indice = NULL;
+    grafo->porId = NULL;
+    grafo->totalIds = 0;
+    grafo->capacidadeIds = 0;
+    grafo->idsLivres = NULL;
+    grafo->totalIdsLivres = 0;
+    grafo->antenasForaDoIndice = 0;
+    grafo->largura = 0;
+    grafo->altura = 0;
     return 0;
 }
 
@@ -537,7 +918,8 @@ int LibertarGrafo(Grafo* grafo) {
 
 #pragma region LimparVisitados
 /**
- * Funo para limpar os visitados de todas as antenas no grafo
+ * Funo para limpar os visitados de todas as antenas no grafo.
+ * As travessias j no usam Antena::visitada (ver travessias.c); fica para quem ainda a use.
  *
  * @param grafo --> Apontador para o grafo cujas antenas sero limpas.
  * @param Antena --> Estrutura que representa uma antena no grafo.
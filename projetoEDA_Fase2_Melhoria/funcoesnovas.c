@@ -11,26 +11,34 @@
 #pragma region ProcurarAntena
  /**
   * Funo para procurar uma antena especfica no grafo.
+  * Usa o ndice espacial do grafo (tempo constante); se o grafo ainda no tiver
+  * ndice percorre a lista.
   *
   * @param grafo --> Apontador para o grafo onde as antenas esto localizadas.
   * @param coluna --> Posio horizontal da antena (coordenada X).
   * @param linha --> Posio vertical da antena (coordenada Y).
   * @param antenaAtual --> Apontador para a antena atual na lista do grafo.
   * @param proxima --> Apontador para a prxima antena na lista do grafo.
+  * @return Apontador para a antena ou NULL se no existir.
   */
 Antena* procurarAntena(Grafo* cidade, int coluna, int linha){
 	
 	if (cidade == NULL) {
-		return -1;
+		return NULL;
 	}
-	else {
-		for (Antena* antenaAtual = cidade->antenas; antenaAtual != NULL; antenaAtual->proxima) {
-			if (antenaAtual->coluna == coluna && antenaAtual->linha) {
-				return antenaAtual; // Retorna a antena se encontrar a posio exata
-			}
+	if (cidade->indice != NULL) {
+		return ProcurarNoIndice(cidade, coluna, linha);
+	}
+	int passos = 0;
+	for (Antena* antenaAtual = cidade->antenas; antenaAtual != NULL; antenaAtual = antenaAtual->proxima) {
+		passos++;
+		if (antenaAtual->coluna == coluna && antenaAtual->linha == linha) {
+			CONTAR(CONTADOR_PASSOS_PROCURAR, passos);
+			return antenaAtual; // Retorna a antena se encontrar a posio exata
 		}
-		return NULL; 
 	}
+	CONTAR(CONTADOR_PASSOS_PROCURAR, passos);
+	return NULL; 
 }
 #pragma endregion
 
@@ -38,14 +46,15 @@ Antena* procurarAntena(Grafo* cidade, int coluna, int linha){
 /**
  * Funo para popular uma nova antena com os dados fornecidos.
  *
+ * @param cidade --> Apontador para o grafo dono da arena de onde sai a antena.
  * @param freq --> Frequncia da antena (carcter nico).
  * @param coluna --> Posio horizontal da antena (coordenada X).
  * @param linha --> Posio vertical da antena (coordenada Y).
- * @param novaAntena --> Apontador para a nova antena a ser criada.
+ * @param novaAntena --> Apontador para a nova antena a ser criada (j com id atribudo).
  * @return Apontador para a nova antena ou NULL se no conseguir alocar memria.
  */
-Antena* popularAntena(char freq, int coluna, int linha) {
-	Antena* novaAntena = malloc(sizeof(Antena));
+Antena* popularAntena(Grafo* cidade, char freq, int coluna, int linha) {
+	Antena* novaAntena = AlocarNo(ArenaDoGrafo(cidade), NO_ANTENA);
 	if (novaAntena == NULL) {
 		return NULL; // Retorna NULL se no conseguir alocar memria
 	}
@@ -55,13 +64,21 @@ Antena* popularAntena(char freq, int coluna, int linha) {
 	novaAntena->ligacoes = NULL; // Inicializa sem ligaes
 	novaAntena->visitada = false; // Inicializa como no visitada
 	novaAntena->proxima = NULL; // Inicializa como o ltimo elemento da lista
+	novaAntena->anterior = NULL;
+	novaAntena->entradas = NULL; // Nenhuma ligao chega a ela
+	if (RegistarId(cidade, novaAntena) != 0) {
+		LibertarNo(cidade->arena, NO_ANTENA, novaAntena);
+		return NULL; // Sem memria para a tabela de ids
+	}
 	return novaAntena;
 }
 #pragma endregion
 
 #pragma region AdicionarAntenaOrdenado
 /**
- * Funo para adicionar uma antena ao grafo de forma ordenada.
+ * Funo para adicionar uma antena ao grafo de forma ordenada (por linha e depois por coluna).
+ * A verificao de posio repetida  feita no ndice espacial, sem percorrer a lista.
+ * A antena entra no balde da sua frequncia, o que a liga logo s antenas da mesma frequncia.
  *
  * @param cidade --> Apontador para o grafo onde a antena ser adicionada.
  * @param freq --> Frequncia da antena (carcter nico).
@@ -78,56 +95,51 @@ int adicionarAntenaOrdenado(Grafo* cidade, char freq, int coluna, int linha) {
 	if (cidade == NULL) {
 		return -1;
 	}
+	if (procurarAntena(cidade, coluna, linha) != NULL) {
+		return -2; // Antena j existe na posio
+	}
 
-	//Inserir no INICIO SEM ANTENAS
-	if (cidade->antenas == NULL) {
-		cidade->antenas = popularAntena(freq, coluna, linha);
+	Antena* novaAntena = popularAntena(cidade, freq, coluna, linha);
+	if (novaAntena == NULL) {
+		return  -3; // Falha ao alocar memria
+	}
+	if (RegistarAntena(cidade, novaAntena) != 0) {
+		return -3; // Falha ao alocar memria no ndice ou no balde (nada foi alterado)
+	}
+
+	//Procura a primeira antena que fica depois da nova (linha maior, ou mesma linha e coluna maior)
+	Antena* antenaAnterior = NULL;
+	Antena* antenaPosterior = cidade->antenas;
+	int passos = 0;
+	while (antenaPosterior != NULL &&
+		(antenaPosterior->linha < linha || (antenaPosterior->linha == linha && antenaPosterior->coluna < coluna))) {
+		antenaAnterior = antenaPosterior;
+		antenaPosterior = antenaPosterior->proxima;
+		passos++;
+	}
+	CONTAR(CONTADOR_PASSOS_ADICIONAR, passos);
+
+	//Inserir no INICIO ou entre a anterior e a posterior
+	novaAntena->proxima = antenaPosterior;
+	novaAntena->anterior = antenaAnterior;
+	if (antenaPosterior != NULL) {
+		antenaPosterior->anterior = novaAntena;
+	}
+	if (antenaAnterior == NULL) {
+		cidade->antenas = novaAntena;
 	}
 	else {
-		Antena* antenaAnterior = NULL;
-		Antena* antenaPosterior = cidade->antenas;
-		
-		//Inserir no INICIO com ANTENAS
-		if(antenaPosterior->linha > linha || (antenaPosterior->coluna >= coluna && antenaPosterior->linha == linha)){
-			if (antenaPosterior->linha == linha && antenaPosterior->coluna == coluna) {
-				return -2; // Antena j existe na posio
-			}
-			Antena* novaAntena = popularAntena(freq, coluna, linha);
-			if (novaAntena == NULL) {
-				return  -3; // Falha ao alocar memria
-			}
-			novaAntena->proxima = cidade->antenas; 
-			cidade->antenas = novaAntena; 
-			
-		}
-		else {
-			while (antenaPosterior->linha < linha || (antenaPosterior->coluna <= coluna && antenaPosterior->linha == linha)) {
-				if (antenaPosterior->proxima != NULL) {
-					antenaAnterior = antenaPosterior;
-					antenaPosterior = antenaPosterior->proxima;
-				}
-				else {
-					break; // Chegou ao final da lista
-				}
-			}
-			if (antenaAnterior->linha == linha && antenaAnterior->coluna == coluna) {
-				return -2; // Antena j existe na posio
-			}
-			Antena* novaAntena = popularAntena(freq, coluna, linha);
-			if (novaAntena == NULL) {
-				return  -3; // Falha ao alocar memria
-			}
-			antenaAnterior->proxima = novaAntena;
-			novaAntena->proxima = antenaPosterior;
-		}
-	}	
+		antenaAnterior->proxima = novaAntena;
+	}
 	cidade->totalAntenas++;
+	return 0;
 }
 #pragma endregion
 
 #pragma region AdicionarAntenaFim
 /**
  * Funo para adicionar uma antena ao final da lista de antenas do grafo.
+ * A antena entra no balde da sua frequncia, o que a liga logo s antenas da mesma frequncia.
  *
  * @param cidade --> Apontador para o grafo onde a antena ser adicionada.
  * @param freq --> Frequncia da antena (carcter nico).
@@ -142,63 +154,212 @@ int adicionarAntenaFim(Grafo* cidade, char freq, int coluna, int linha) {
 	if (cidade == NULL) {
 		return -1;
 	}
+	Antena* novaAntena = popularAntena(cidade, freq, coluna, linha);
+	if (novaAntena == NULL) {
+		return -2; // Falha ao alocar memria
+	}
+	if (RegistarAntena(cidade, novaAntena) != 0) {
+		return -2; // Falha ao alocar memria no ndice ou no balde (nada foi alterado)
+	}
+
 	if (cidade->antenas == NULL) {
-		cidade->antenas = popularAntena(freq, coluna, linha);
-		cidade->totalAntenas++;
+		cidade->antenas = novaAntena;
 	}
 	else {
-		for (Antena* antenaAtual = cidade->antenas; antenaAtual != NULL; antenaAtual = antenaAtual->proxima) {
-			if (antenaAtual->proxima == NULL) {
-				antenaAtual->proxima = popularAntena(freq, coluna, linha);
-				if (antenaAtual->proxima == NULL) {
-					return -1; // Falha ao alocar memria
-				}
-				cidade->totalAntenas++;
-				return 0;
-			}
+		Antena* antenaAtual = cidade->antenas;
+		while (antenaAtual->proxima != NULL) {
+			antenaAtual = antenaAtual->proxima;
 		}
+		antenaAtual->proxima = novaAntena;
+		novaAntena->anterior = antenaAtual;
 	}
+	cidade->totalAntenas++;
+	return 0;
 }
 #pragma endregion
 
 #pragma region AdicionarAntenaFimOtimizado
 /**
  * Funo otimizada para adicionar uma antena ao final da lista de antenas do grafo.
+ * A antena entra no balde da sua frequncia, o que a liga logo s antenas da mesma frequncia.
  *
  * @param cidade --> Apontador para o grafo onde a antena ser adicionada.
- * @param ultimaAntena --> Apontador para a ltima antena na lista do grafo.
+ * @param ultimaAntena --> Apontador para a ltima antena na lista do grafo (NULL se a lista estiver vazia).
  * @param freq --> Frequncia da antena (carcter nico).
  * @param coluna --> Posio horizontal da antena (coordenada X).
  * @param linha --> Posio vertical da antena (coordenada Y).
  * @param novaAntena --> Apontador para a nova antena a ser criada.
  * @return Apontador para a nova antena ou NULL se no conseguir alocar memria.
  */
-Grafo* adicionarAntenaFimOtimizado(Grafo* cidade, Antena* ultimaAntena, char freq, int coluna, int linha) {
-	Antena* novaAntena = popularAntena(freq, coluna, linha);
+Antena* adicionarAntenaFimOtimizado(Grafo* cidade, Antena* ultimaAntena, char freq, int coluna, int linha) {
+	if (cidade == NULL) {
+		return NULL;
+	}
+	Antena* novaAntena = popularAntena(cidade, freq, coluna, linha);
 	if (novaAntena == NULL) {
 		return NULL;
 	}
+	if (RegistarAntena(cidade, novaAntena) != 0) {
+		return NULL; // Falha ao alocar memria no ndice ou no balde (nada foi alterado)
+	}
 
 	if (ultimaAntena == NULL) {
 		cidade->antenas = novaAntena; 
 	}
-
-	ultimaAntena->proxima = novaAntena;
+	else {
+		ultimaAntena->proxima = novaAntena;
+		novaAntena->anterior = ultimaAntena;
+	}
 	cidade->totalAntenas++;
 
 	return novaAntena;
 }
 #pragma endregion
 
+#pragma region RetirarLigacao
+/**
+ * Funo para retirar de uma lista de ligaes o primeiro n que aponta para destino
+ * e devolv-lo  arena.
+ *
+ * @param cidade --> Apontador para o grafo dono da arena.
+ * @param lista --> Apontador para o incio da lista (ligacoes ou entradas de uma antena).
+ * @param destino --> Antena para onde aponta o n a retirar.
+ * @param atual --> Apontador para o campo que aponta para o n atual.
+ * @return true se encontrou e retirou o n, false caso contrrio.
+ */
+static bool retirarLigacao(Grafo* cidade, Adjacencia** lista, Antena* destino) {
+	int passos = 0;
+	for (Adjacencia** atual = lista; *atual != NULL; atual = &(*atual)->proxima) {
+		passos++;
+		if ((*atual)->destino == destino) {
+			Adjacencia* temp = *atual;
+			*atual = temp->proxima;
+			LibertarNo(cidade->arena, NO_ADJACENCIA, temp);
+			CONTAR(CONTADOR_PASSOS_REMOVER, passos);
+			return true;
+		}
+	}
+	CONTAR(CONTADOR_PASSOS_REMOVER, passos);
+	return false;
+}
+#pragma endregion
+
+#pragma region DesligarAntena
+/**
+ * Procura outra antena na coordenada de alvo (j fora da lista), para ocupar o seu lugar no ndice.
+ * S h alguma se houver antenas fora do ndice; as repetidas ficam normalmente ao lado
+ * na lista (ordenada por linha e coluna), e s se no estiverem a lista  percorrida.
+ *
+ * @param cidade --> Apontador para o grafo.
+ * @param alvo --> Antena que saiu do ndice.
+ * @param return --> Outra antena na mesma coordenada, ou NULL se no houver.
+ */
+static Antena* OutraNaCoordenada(const Grafo* cidade, const Antena* alvo) {
+	if (cidade->antenasForaDoIndice == 0) {
+		return NULL;
+	}
+	Antena* vizinhas[2] = { alvo->anterior, alvo->proxima };
+	for (int i = 0; i < 2; i++) {
+		if (vizinhas[i] && vizinhas[i]->coluna == alvo->coluna && vizinhas[i]->linha == alvo->linha) {
+			return vizinhas[i];
+		}
+	}
+	for (Antena* a = cidade->antenas; a != NULL; a = a->proxima) {
+		if (a->coluna == alvo->coluna && a->linha == alvo->linha) {
+			return a;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Funo para tirar do grafo uma antena j encontrada, sem a retirar do balde nem a devolver  arena.
+ * A antena sai da lista, do ndice e da tabela de ids, e  desligada de todas as outras:
+ * cada ligao que sai dela  retirada das entradas do destino e cada ligao que chega
+ * a ela  retirada da lista da origem, por isso nenhuma antena fica a apontar para ela.
+ * Custa O(ligaes das antenas vizinhas), sem percorrer o grafo. Depois falta retir-la
+ * do balde (RemoverDoBalde, ou RemoverDosBaldes para muitas de uma vez) e libert-la.
+ * S sai do ndice se for ela a antena indexada na sua coordenada (as repetidas no esto
+ * l); nesse caso, se houver outra antena na mesma coordenada, o ndice passa a apontar para ela.
+ *
+ * @param cidade --> Apontador para o grafo.
+ * @param alvo --> Antena a desligar.
+ * @param adjAtual --> Apontador para a ligao a libertar.
+ * @return 0 se a antena foi desligada, -1 se os argumentos forem nulos.
+ */
+int desligarAntena(Grafo* cidade, Antena* alvo) {
+	if (cidade == NULL || alvo == NULL) {
+		return -1;
+	}
+
+	//remove se for a primeira caso contrario liga a anterior  seguinte
+	if (alvo->anterior == NULL) {
+		cidade->antenas = alvo->proxima;
+	}
+	else {
+		alvo->anterior->proxima = alvo->proxima;
+	}
+	if (alvo->proxima != NULL) {
+		alvo->proxima->anterior = alvo->anterior;
+	}
+	cidade->totalAntenas--;
+	if (ProcurarNoIndice(cidade, alvo->coluna, alvo->linha) == alvo) {
+		DesindexarAntena(cidade, alvo->coluna, alvo->linha);
+		//a tabela acabou de perder uma entrada, por isso voltar a indexar no a faz crescer
+		Antena* outra = OutraNaCoordenada(cidade, alvo);
+		if (outra != NULL && IndexarAntena(cidade, outra) == 0) {
+			cidade->antenasForaDoIndice--;
+		}
+	}
+	else if (cidade->antenasForaDoIndice > 0) {
+		cidade->antenasForaDoIndice--;
+	}
+
+	//Ligaes que saem da antena: o destino deixa de as ter nas entradas
+	for (Adjacencia* adj = alvo->ligacoes; adj != NULL; adj = adj->proxima) {
+		if (adj->destino != alvo) {
+			retirarLigacao(cidade, &adj->destino->entradas, alvo);
+		}
+		AtualizarComponentesLigacao(cidade, alvo, adj->destino, -1);
+	}
+	//Ligaes que chegam  antena: a origem deixa de as ter
+	for (Adjacencia* entrada = alvo->entradas; entrada != NULL; entrada = entrada->proxima) {
+		if (entrada->destino != alvo) {
+			retirarLigacao(cidade, &entrada->destino->ligacoes, alvo);
+			AtualizarComponentesLigacao(cidade, entrada->destino, alvo, -1);
+		}
+	}
+
+	Adjacencia* adjAtual = alvo->ligacoes;
+	while (adjAtual != NULL) {
+		Adjacencia* temp = adjAtual;
+		adjAtual = adjAtual->proxima;
+		LibertarNo(cidade->arena, NO_ADJACENCIA, temp);
+	}
+	adjAtual = alvo->entradas;
+	while (adjAtual != NULL) {
+		Adjacencia* temp = adjAtual;
+		adjAtual = adjAtual->proxima;
+		LibertarNo(cidade->arena, NO_ADJACENCIA, temp);
+	}
+	alvo->ligacoes = NULL;
+	alvo->entradas = NULL;
+	LibertarId(cidade, alvo);
+	return 0;
+}
+#pragma endregion
+
 #pragma region removerAntena
 /**
  * Funo para remover uma antena especfica do grafo.
+ * O ndice espacial encontra a antena e a lista  duplamente ligada, por isso no 
+ * preciso percorrer a lista; a antena sai do ndice, do balde da sua frequncia e das
+ * ligaes das outras antenas, e as componentes so atualizadas.
  *
  * @param cidade --> Apontador para o grafo onde a antena ser removida.
  * @param coluna --> Posio horizontal da antena (coordenada X).
  * @param linha --> Posio vertical da antena (coordenada Y).
- * @param antenaAnterior --> Apontador para a antena anterior na lista do grafo.
- * @param antenaPosterior --> Apontador para a antena posterior na lista do grafo.
+ * @param alvo --> Apontador para a antena a remover, obtido do ndice.
  * @return 0 se a antena foi removida com sucesso, -1 se o grafo for nulo,
  *         -2 se a antena no for encontrada.
  */
@@ -206,30 +367,16 @@ int removerAntena(Grafo* cidade, int coluna, int linha) {
 	if (cidade == NULL) {
 		return -1;
 	}
-	Antena* antenaAnterior = NULL;
-	Antena* antenaPosterior = cidade->antenas;
-		
-	//remove se for a primeira caso contrario percorre as que for necessario
-	if (antenaPosterior != NULL && antenaPosterior->linha == linha && antenaPosterior->coluna == coluna) {
-		cidade->antenas = antenaPosterior->proxima;
-		free(antenaPosterior);
-		
-		return 0; // Antena removida com sucesso
+	Antena* alvo = procurarAntena(cidade, coluna, linha);
+	if (alvo == NULL) {
+		return -2; // Antena no encontrada
 	}
-	else {
-		while (antenaPosterior != NULL && antenaPosterior->linha <= linha) {
 
-			if (antenaPosterior->linha == linha && antenaPosterior->coluna == coluna) {
-				antenaAnterior->proxima = antenaPosterior->proxima; // Remove a antena encontrada
-				free(antenaPosterior); 
+	desligarAntena(cidade, alvo);
+	RemoverDoBalde(cidade, alvo);
+	LibertarNo(cidade->arena, NO_ANTENA, alvo);
 
-				return 0; // Antena removida com sucesso
-			}
-			antenaAnterior = antenaPosterior;
-			antenaPosterior = antenaPosterior->proxima;
-		}
-	}
-	return -2; // Antena no encontrada
+	return 0; // Antena removida com sucesso
 }
 #pragma endregion
 
@@ -239,11 +386,12 @@ int removerAntena(Grafo* cidade, int coluna, int linha) {
 /**
  * Funo para popular uma nova adjacncia entre antenas.
  *
+ * @param cidade --> Apontador para o grafo dono da arena de onde sai a adjacncia.
  * @param destino --> Apontador para a antena de destino da adjacncia.
  * @return Apontador para a nova adjacncia ou NULL se no conseguir alocar memria.
  */
-Adjacencia* popularAdjacencia(Antena* destino) {
-	Adjacencia* novaAdjacencia = malloc(sizeof(Adjacencia));
+Adjacencia* popularAdjacencia(Grafo* cidade, Antena* destino) {
+	Adjacencia* novaAdjacencia = AlocarNo(ArenaDoGrafo(cidade), NO_ADJACENCIA);
 	if(novaAdjacencia == NULL){
 		return NULL; // Retorna NULL se no conseguir alocar memria
 	}
@@ -281,6 +429,7 @@ Adjacencia* procurarAdjacencia(Antena* antenaAtual, Antena* destino) {
 /**
  * Funo para adicionar uma aresta
  *
+ * @param cidade --> Apontador para o grafo dono da arena de onde sai a aresta.
  * @param antenaAtual --> Apontador para a antena atual onde a aresta ser adicionada.
  * @param destino --> Apontador para a antena de destino da aresta.
  * @param verificarRepetidos --> Indicador se deve verificar se a aresta j existe.
@@ -289,7 +438,7 @@ Adjacencia* procurarAdjacencia(Antena* antenaAtual, Antena* destino) {
  *         -2 se o destino for nulo, -3 se ambos forem nulos, -4 se falhar ao alocar memria,
  *         -5 se a aresta j existir, -6 se no encontrar a aresta para remover.
  */
-int adicionarAresta(Antena* antenaAtual, Antena* destino, bool verificarRepetidos){
+int adicionarAresta(Grafo* cidade, Antena* antenaAtual, Antena* destino, bool verificarRepetidos){
 	if (antenaAtual == NULL) {
 		if (destino == NULL){
 			return -3;
@@ -301,17 +450,15 @@ int adicionarAresta(Antena* antenaAtual, Antena* destino, bool verificarRepetido
 	}
 	
 	if (verificarRepetidos) {
-		if (procurarAdjacencia(antenaAtual, destino) == NULL) {
+		if (procurarAdjacencia(antenaAtual, destino) != NULL) {
 			return -5; // Aresta j existe
 		}
 	}
 
-	Adjacencia* novaAdjacencia = popularAdjacencia(destino);
-	if (novaAdjacencia == NULL) {
+	//AdicionarAdj tambm regista a aresta nas entradas do destino e atualiza as componentes
+	if (AdicionarAdj(cidade, antenaAtual, destino) != 0) {
 		return -4; // Falha ao alocar memria
 	}
-	novaAdjacencia->proxima = antenaAtual->ligacoes; 
-	antenaAtual->ligacoes = novaAdjacencia;
 	 
 	return 0; 
 }
@@ -321,6 +468,7 @@ int adicionarAresta(Antena* antenaAtual, Antena* destino, bool verificarRepetido
 /**
  * Funo para remover uma aresta entre antenas.
  *
+ * @param cidade --> Apontador para o grafo dono da arena para onde volta a aresta.
  * @param antenaAtual --> Apontador para a antena atual onde a aresta ser removida.
  * @param destino --> Apontador para a antena de destino da aresta.
  * @param adjAnterior --> Apontador para a adjacncia anterior na lista de ligaes.
@@ -328,7 +476,7 @@ int adicionarAresta(Antena* antenaAtual, Antena* destino, bool verificarRepetido
  * @return 0 se a aresta foi removida com sucesso, -1 se a antena atual for nula,
  *         -2 se o destino for nulo, -3 se ambos forem nulos, -6 se no encontrar a aresta para remover.
  */
-int removerAresta(Antena* antenaAtual, Antena* destino) {
+int removerAresta(Grafo* cidade, Antena* antenaAtual, Antena* destino) {
 	if (antenaAtual == NULL) {
 		if (destino == NULL) {
 			return -3;
@@ -342,10 +490,15 @@ int removerAresta(Antena* antenaAtual, Antena* destino) {
 	Adjacencia* adjAnterior = NULL;
 	Adjacencia* adjPosterior = antenaAtual->ligacoes;
 
+	if (adjPosterior == NULL) {
+		return -6;
+	}
 
 	if (adjPosterior->destino == destino) {
 		antenaAtual->ligacoes = adjPosterior->proxima;
-		free(adjPosterior);
+		LibertarNo(cidade->arena, NO_ADJACENCIA, adjPosterior);
+		retirarLigacao(cidade, &destino->entradas, antenaAtual);
+		AtualizarComponentesLigacao(cidade, antenaAtual, destino, -1);
 		return 0;
 	}
 	else { 
@@ -355,7 +508,9 @@ int removerAresta(Antena* antenaAtual, Antena* destino) {
 		while (adjPosterior != NULL) {
 			if (adjPosterior->destino == destino) {
 				adjAnterior->proxima = adjPosterior->proxima; // Remove a adjacncia encontrada
-				free(adjPosterior);
+				LibertarNo(cidade->arena, NO_ADJACENCIA, adjPosterior);
+				retirarLigacao(cidade, &destino->entradas, antenaAtual);
+				AtualizarComponentesLigacao(cidade, antenaAtual, destino, -1);
 				return 0; // Aresta removida com sucesso
 			}
 
@@ -369,35 +524,67 @@ int removerAresta(Antena* antenaAtual, Antena* destino) {
 
 #pragma region CarregarAntenasDoFicheiro
 /**
- * Funo para carregar antenas de um ficheiro e adicion-las ao grafo.
+ * Funo para carregar antenas de um ficheiro e adicion-las ao fim da lista do grafo.
+ * O ficheiro tem o mesmo formato que o de CarregarAntenasDoFicheiro (cabealho com
+ * linhas e colunas, seguido da grelha) e  lido mapeado em memria, sem threads.
  *
  * @param cidade --> Apontador para o grafo onde as antenas sero carregadas.
  * @param nomeFicheiro --> Nome do ficheiro de onde as antenas sero lidas.
- * @param ultimaAntena --> Apontador para a ltima antena adicionada, usado para otimizao.
- * @param bufferLinha --> Buffer para ler cada linha do ficheiro.
- * @param MAX_X --> Tamanho mximo do buffer para leitura de linhas.
- * @return 0 se as antenas foram carregadas com sucesso, -1 se no conseguir abrir o ficheiro.
+ * @return 0 se as antenas foram carregadas com sucesso, -1 se no conseguir abrir o ficheiro,
+ *         -2 se o cabealho for invlido, -3 se falhar ao alocar memria.
  */
 int carregarAntenasDoFicheiro(Grafo* cidade, const char* nomeFicheiro) {
-	FILE* ficheiro = fopen(nomeFicheiro, "r");
+	return carregarAntenasDoFicheiroParalelo(cidade, nomeFicheiro, 1);
+}
 
-	if (nomeFicheiro == NULL) {
-		return -1; // Se no conseguir abrir o ficheiro, retorna o grafo vazioo
+/**
+ * Funo para carregar antenas de um ficheiro para o fim da lista, lendo a grelha com vrias threads.
+ * Cada thread l um troo de linhas para o seu lote (LerGrelhaAntenas) e os lotes so juntos
+ * por ordem de linha e coluna antes da insero, por isso a lista fica igual  da leitura sequencial.
+ * A grelha do grafo passa a ser a maior entre a que j tinha e a do ficheiro (AlargarGrelha).
+ *
+ * @param cidade --> Apontador para o grafo.
+ * @param nomeFicheiro --> Nome do ficheiro.
+ * @param numThreads --> Nmero de threads (0 ou negativo para usar todos os processadores).
+ * @param estatisticas --> Estatsticas da leitura, de onde vm a largura e a altura da grelha.
+ * @param lote --> Antenas lidas do ficheiro.
+ * @param ultimaAntena --> Apontador para a ltima antena da lista.
+ * @param return --> 0 se as antenas forem carregadas com sucesso, -1 se houver erro ao abrir o ficheiro,
+ *                   -2 se o cabealho for invlido, -3 se falhar a alocao.
+ */
+int carregarAntenasDoFicheiroParalelo(Grafo* cidade, const char* nomeFicheiro, int numThreads) {
+	if (cidade == NULL || nomeFicheiro == NULL) {
+		return -1;
 	}
 
-	Antena* ultimaAntena = NULL;
+	EstatisticasCarregamento estatisticas;
+	LoteAntenas lote = { NULL, 0, 0 };
+	int leitura = LerGrelhaAntenas(nomeFicheiro, numThreads, &lote, &estatisticas);
+	if (leitura == -1 || leitura == -2) {
+		return -1; // Se no conseguir abrir o ficheiro
+	}
+	if (leitura == -3) {
+		return -2;
+	}
+	int resultado = leitura == 0 ? 0 : -3;
+	AlargarGrelha(cidade, estatisticas.largura, estatisticas.altura);
 
-	char bufferLinha[MAX_X];  // Buffer para ler cada linha do ficheiro
-	for (int y = 0; fgets(bufferLinha, sizeof(bufferLinha), ficheiro); y++) {
-		for (int x = 0; bufferLinha[x] != '\n' && bufferLinha[x] != '\0'; x++) {
-			if (bufferLinha[x] != ".") {
-				//adicionarAntenaOrdenado(cidade, bufferLinha[x], x, y); INSERIR NORMALMENTE
+	//Comea na ltima antena que j exista no grafo
+	Antena* ultimaAntena = cidade->antenas;
+	while (ultimaAntena != NULL && ultimaAntena->proxima != NULL) {
+		ultimaAntena = ultimaAntena->proxima;
+	}
 
-				//INSERIR OTIMIZADO
-				ultimaAntena = adicionarAntenaFimOtimizado(cidade, ultimaAntena, bufferLinha[x], x, y);
-			}
+	//INSERIR OTIMIZADO
+	for (int i = 0; i < lote.total && resultado == 0; i++) {
+		Antena* novaAntena = adicionarAntenaFimOtimizado(cidade, ultimaAntena, lote.registos[i].frequencia, lote.registos[i].coluna, lote.registos[i].linha);
+		if (novaAntena == NULL) {
+			resultado = -3;
 		}
+		ultimaAntena = novaAntena;
 	}
-	return 0;
+
+	LibertarLote(&lote);
+	return resultado;
 }
 #pragma endregion
@@ -0,0 +1,336 @@
+/*****************************************************************//**
+ * \file   grafobinario.c
+ * \brief  Formato binrio do grafo de antenas (gravao e abertura por mapeamento).
+ *
+ * O ficheiro  um cabealho seguido dos vetores da cpia compacta (GrafoCSR),
+ * cada um alinhado a 8 bytes. Ao abrir, o ficheiro  mapeado em memria e a
+ * cpia compacta aponta diretamente para os vetores mapeados, sem converter
+ * antena a antena. Os inteiros so de 32 bits, em little-endian.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdint.h>
+#include "antenas.h"
+
+#define ASSINATURA_BINARIO "EDAGRAFO"
+#define VERSAO_BINARIO 2u
+#define ORDEM_BYTES_BINARIO 0x01020304u
+#define NUM_SECOES_BINARIO 7
+
+//Os vetores so usados diretamente como int, por isso int tem de ter 32 bits
+typedef char VerificarTamanhoInt[sizeof(int) == sizeof(int32_t) ? 1 : -1];
+
+/**
+ * Seces do ficheiro, pela ordem em que aparecem.
+ */
+enum SecaoBinario {
+    SECAO_FREQUENCIAS,
+    SECAO_COLUNAS,
+    SECAO_LINHAS,
+    SECAO_INICIO_ARESTAS,
+    SECAO_DESTINOS,
+    SECAO_INICIO_BALDES,
+    SECAO_MEMBROS_BALDES
+};
+
+/**
+ * Cabealho do ficheiro binrio (112 bytes).
+ * A verso 2 acrescentou a largura e a altura da grelha; os ficheiros da verso 1 so recusados.
+ * @param assinatura --> "EDAGRAFO", para reconhecer o ficheiro.
+ * @param versao --> Verso do formato (VERSAO_BINARIO).
+ * @param ordemBytes --> ORDEM_BYTES_BINARIO escrito pela mquina que gravou o ficheiro.
+ * @param tamanhoCabecalho --> sizeof(CabecalhoBinario).
+ * @param totalAntenas --> Nmero de antenas.
+ * @param totalArestas --> Nmero de ligaes explcitas.
+ * @param numFrequencias --> Nmero de baldes de frequncia (NUM_FREQUENCIAS).
+ * @param largura --> Nmero de colunas da grelha (0 se no for conhecido).
+ * @param altura --> Nmero de linhas da grelha (0 se no for conhecido).
+ * @param tamanhoFicheiro --> Tamanho total do ficheiro em bytes.
+ * @param soma --> Soma de verificao FNV-1a de tudo o que vem depois do cabealho.
+ * @param secoes --> Deslocamento de cada seco desde o incio do ficheiro.
+ */
+typedef struct CabecalhoBinario {
+    char assinatura[8];
+    uint32_t versao;
+    uint32_t ordemBytes;
+    uint32_t tamanhoCabecalho;
+    int32_t totalAntenas;
+    int32_t totalArestas;
+    int32_t numFrequencias;
+    int32_t largura;
+    int32_t altura;
+    uint64_t tamanhoFicheiro;
+    uint64_t soma;
+    uint64_t secoes[NUM_SECOES_BINARIO];
+} CabecalhoBinario;
+
+#pragma region Disposicao
+static uint64_t Alinhar8(uint64_t tamanho) {
+    return (tamanho + 7) & ~(uint64_t)7;
+}
+
+/**
+ * Calcula o tamanho de cada seco e o seu deslocamento, a partir dos totais.
+ * Devolve o tamanho total do ficheiro.
+ */
+static uint64_t CalcularDisposicao(int32_t totalAntenas, int32_t totalArestas,
+    uint64_t tamanhos[NUM_SECOES_BINARIO], uint64_t secoes[NUM_SECOES_BINARIO]) {
+    uint64_t n = (uint64_t)totalAntenas, m = (uint64_t)totalArestas;
+    tamanhos[SECAO_FREQUENCIAS] = n;
+    tamanhos[SECAO_COLUNAS] = n * sizeof(int32_t);
+    tamanhos[SECAO_LINHAS] = n * sizeof(int32_t);
+    tamanhos[SECAO_INICIO_ARESTAS] = (n + 1) * sizeof(int32_t);
+    tamanhos[SECAO_DESTINOS] = m * sizeof(int32_t);
+    tamanhos[SECAO_INICIO_BALDES] = (NUM_FREQUENCIAS + 1) * sizeof(int32_t);
+    tamanhos[SECAO_MEMBROS_BALDES] = n * sizeof(int32_t);
+
+    uint64_t deslocamento = sizeof(CabecalhoBinario);
+    for (int s = 0; s < NUM_SECOES_BINARIO; s++) {
+        secoes[s] = deslocamento;
+        deslocamento += Alinhar8(tamanhos[s]);
+    }
+    return deslocamento;
+}
+#pragma endregion
+
+#pragma region SomaVerificacao
+#define FNV_BASE 0xCBF29CE484222325ULL
+#define FNV_PRIMO 0x100000001B3ULL
+
+/**
+ * Acumula na soma FNV-1a (em palavras de 64 bits) um bloco de bytes.
+ * O bloco  tratado como se tivesse sido completado com zeros at mltiplo de 8,
+ * que  exatamente o que  gravado no ficheiro.
+ */
+static uint64_t AcumularSoma(uint64_t soma, const void* dados, uint64_t tamanho) {
+    const unsigned char* p = dados;
+    uint64_t palavras = tamanho / 8;
+    for (uint64_t i = 0; i < palavras; i++, p += 8) {
+        uint64_t palavra;
+        memcpy(&palavra, p, 8);
+        soma = (soma ^ palavra) * FNV_PRIMO;
+    }
+    if (tamanho % 8) {
+        uint64_t palavra = 0;
+        memcpy(&palavra, p, (size_t)(tamanho % 8));
+        soma = (soma ^ palavra) * FNV_PRIMO;
+    }
+    return soma;
+}
+#pragma endregion
+
+#pragma region GuardarGrafoBinario
+/**
+ * Vetores da cpia compacta, pela ordem das seces.
+ */
+static void VetoresCSR(const GrafoCSR* csr, const void* vetores[NUM_SECOES_BINARIO]) {
+    vetores[SECAO_FREQUENCIAS] = csr->frequencias;
+    vetores[SECAO_COLUNAS] = csr->colunas;
+    vetores[SECAO_LINHAS] = csr->linhas;
+    vetores[SECAO_INICIO_ARESTAS] = csr->inicioArestas;
+    vetores[SECAO_DESTINOS] = csr->destinos;
+    vetores[SECAO_INICIO_BALDES] = csr->inicioBaldes;
+    vetores[SECAO_MEMBROS_BALDES] = csr->membrosBaldes;
+}
+
+/**
+ * Funo para gravar uma cpia compacta no formato binrio.
+ *
+ * @param csr --> Apontador para a cpia compacta.
+ * @param nomeFicheiro --> Nome do ficheiro a criar.
+ * @param cabecalho --> Cabealho gravado no incio do ficheiro.
+ * @param vetores --> Vetor de cada seco.
+ * @param tamanhos --> Nmero de bytes teis de cada seco.
+ * @param return --> 0 se o ficheiro foi gravado, -1 se os argumentos forem nulos,
+ *                   -3 se no for possvel escrever o ficheiro.
+ */
+int GuardarGrafoCSRBinario(const GrafoCSR* csr, const char* nomeFicheiro) {
+    if (!csr || !nomeFicheiro) return -1;
+
+    CabecalhoBinario cabecalho;
+    memset(&cabecalho, 0, sizeof(CabecalhoBinario));
+    memcpy(cabecalho.assinatura, ASSINATURA_BINARIO, 8);
+    cabecalho.versao = VERSAO_BINARIO;
+    cabecalho.ordemBytes = ORDEM_BYTES_BINARIO;
+    cabecalho.tamanhoCabecalho = sizeof(CabecalhoBinario);
+    cabecalho.totalAntenas = csr->totalAntenas;
+    cabecalho.totalArestas = csr->totalArestas;
+    cabecalho.numFrequencias = NUM_FREQUENCIAS;
+    cabecalho.largura = csr->largura;
+    cabecalho.altura = csr->altura;
+
+    uint64_t tamanhos[NUM_SECOES_BINARIO];
+    const void* vetores[NUM_SECOES_BINARIO];
+    cabecalho.tamanhoFicheiro = CalcularDisposicao(csr->totalAntenas, csr->totalArestas, tamanhos, cabecalho.secoes);
+    VetoresCSR(csr, vetores);
+
+    //A soma  calculada antes de escrever, para o cabealho ser escrito uma s vez
+    cabecalho.soma = FNV_BASE;
+    for (int s = 0; s < NUM_SECOES_BINARIO; s++) {
+        cabecalho.soma = AcumularSoma(cabecalho.soma, vetores[s], tamanhos[s]);
+    }
+
+    FILE* ficheiro = fopen(nomeFicheiro, "wb");
+    if (!ficheiro) return -3;
+
+    static const char zeros[8] = { 0 };
+    bool ok = fwrite(&cabecalho, sizeof(CabecalhoBinario), 1, ficheiro) == 1;
+    for (int s = 0; s < NUM_SECOES_BINARIO && ok; s++) {
+        size_t enchimento = (size_t)(Alinhar8(tamanhos[s]) - tamanhos[s]);
+        if (tamanhos[s] > 0) ok = fwrite(vetores[s], 1, (size_t)tamanhos[s], ficheiro) == tamanhos[s];
+        if (ok && enchimento > 0) ok = fwrite(zeros, 1, enchimento, ficheiro) == enchimento;
+    }
+    if (fclose(ficheiro) != 0) ok = false;
+    if (!ok) {
+        remove(nomeFicheiro);
+        return -3;
+    }
+    return 0;
+}
+
+/**
+ * Funo para gravar um grafo no formato binrio (antenas, frequncias, coordenadas,
+ * ligaes explcitas e baldes, pela ordem da lista do grafo).
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param nomeFicheiro --> Nome do ficheiro a criar.
+ * @param csr --> Cpia compacta do grafo, que  o que fica gravado.
+ * @param return --> 0 se o ficheiro foi gravado, -1 se os argumentos forem nulos,
+ *                   -2 se falhar a alocao, -3 se no for possvel escrever o ficheiro.
+ */
+int GuardarGrafoBinario(Grafo* grafo, const char* nomeFicheiro) {
+    if (!grafo || !nomeFicheiro) return -1;
+
+    GrafoCSR csr;
+    if (ConstruirGrafoCSR(grafo, &csr) != 0) return -2;
+    int resultado = GuardarGrafoCSRBinario(&csr, nomeFicheiro);
+    LibertarGrafoCSR(&csr);
+    return resultado;
+}
+#pragma endregion
+
+#pragma region AbrirGrafoBinario
+/**
+ * Confirma que os vetores de deslocamentos so crescentes e que todos os ndices
+ * apontam para antenas que existem (para um ficheiro vlido nunca se ler fora dos vetores).
+ */
+static bool IndicesValidos(const GrafoCSR* csr) {
+    int n = csr->totalAntenas;
+    if (csr->inicioArestas[0] != 0 || csr->inicioArestas[n] != csr->totalArestas) return false;
+    for (int i = 0; i < n; i++) {
+        if (csr->inicioArestas[i] > csr->inicioArestas[i + 1]) return false;
+    }
+    for (int k = 0; k < csr->totalArestas; k++) {
+        if (csr->destinos[k] < 0 || csr->destinos[k] >= n) return false;
+    }
+    if (csr->inicioBaldes[0] != 0 || csr->inicioBaldes[NUM_FREQUENCIAS] > n) return false;
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) {
+        if (csr->inicioBaldes[f] > csr->inicioBaldes[f + 1]) return false;
+    }
+    for (int k = 0; k < csr->inicioBaldes[NUM_FREQUENCIAS]; k++) {
+        int membro = csr->membrosBaldes[k];
+        if (membro < 0 || membro >= n) return false;
+    }
+    return true;
+}
+
+/**
+ * Funo para abrir um grafo gravado no formato binrio.
+ * O ficheiro  mapeado em memria e binario->csr fica a apontar para os vetores do
+ * mapeamento, por isso pode ser usado logo pelas funes ...CSR. A cpia  s de leitura
+ * e deixa de ser vlida depois de FecharGrafoBinario.
+ *
+ * @param nomeFicheiro --> Nome do ficheiro.
+ * @param binario --> Apontador para a estrutura a preencher.
+ * @param validar --> Se verdadeiro, confirma a soma de verificao e os ndices (l o ficheiro todo);
+ *                     se falso, s o cabealho  confirmado e a abertura  imediata.
+ * @param cabecalho --> Cabealho no incio do ficheiro.
+ * @param secoes --> Deslocamentos esperados para os totais do cabealho.
+ * @param return --> 0 se o grafo foi aberto, -1 se os argumentos forem nulos,
+ *                   -2 se o ficheiro no puder ser lido, -3 se no for um grafo binrio vlido,
+ *                   -4 se a verso no for suportada, -5 se a soma de verificao ou os ndices falharem.
+ */
+int AbrirGrafoBinario(const char* nomeFicheiro, GrafoBinario* binario, bool validar) {
+    if (!nomeFicheiro || !binario) return -1;
+    memset(binario, 0, sizeof(GrafoBinario));
+
+    FicheiroMapeado mapa;
+    if (MapearFicheiro(nomeFicheiro, &mapa) != 0) return -2;
+
+    CabecalhoBinario cabecalho;
+    int resultado = 0;
+    if (mapa.tamanho < sizeof(CabecalhoBinario)) {
+        resultado = -3;
+    }
+    else {
+        memcpy(&cabecalho, mapa.dados, sizeof(CabecalhoBinario));
+        if (memcmp(cabecalho.assinatura, ASSINATURA_BINARIO, 8) != 0) resultado = -3;
+        else if (cabecalho.versao != VERSAO_BINARIO) resultado = -4;
+        else if (cabecalho.ordemBytes != ORDEM_BYTES_BINARIO ||
+                 cabecalho.tamanhoCabecalho != sizeof(CabecalhoBinario) ||
+                 cabecalho.numFrequencias != NUM_FREQUENCIAS ||
+                 cabecalho.totalAntenas < 0 || cabecalho.totalArestas < 0 ||
+                 cabecalho.largura < 0 || cabecalho.altura < 0) resultado = -3;
+    }
+
+    //As seces tm de estar exatamente onde os totais dizem
+    if (resultado == 0) {
+        uint64_t tamanhos[NUM_SECOES_BINARIO], secoes[NUM_SECOES_BINARIO];
+        uint64_t tamanho = CalcularDisposicao(cabecalho.totalAntenas, cabecalho.totalArestas, tamanhos, secoes);
+        if (tamanho != cabecalho.tamanhoFicheiro || tamanho != mapa.tamanho ||
+            memcmp(secoes, cabecalho.secoes, sizeof(secoes)) != 0) {
+            resultado = -3;
+        }
+    }
+
+    if (resultado == 0 && validar) {
+        uint64_t soma = AcumularSoma(FNV_BASE, mapa.dados + sizeof(CabecalhoBinario),
+            mapa.tamanho - sizeof(CabecalhoBinario));
+        if (soma != cabecalho.soma) resultado = -5;
+    }
+
+    if (resultado != 0) {
+        DesmapearFicheiro(&mapa);
+        return resultado;
+    }
+
+    const char* base = mapa.dados;
+    GrafoCSR* csr = &binario->csr;
+    csr->totalAntenas = cabecalho.totalAntenas;
+    csr->totalArestas = cabecalho.totalArestas;
+    csr->largura = cabecalho.largura;
+    csr->altura = cabecalho.altura;
+    csr->frequencias = (char*)(base + cabecalho.secoes[SECAO_FREQUENCIAS]);
+    csr->colunas = (int*)(base + cabecalho.secoes[SECAO_COLUNAS]);
+    csr->linhas = (int*)(base + cabecalho.secoes[SECAO_LINHAS]);
+    csr->inicioArestas = (int*)(base + cabecalho.secoes[SECAO_INICIO_ARESTAS]);
+    csr->destinos = (int*)(base + cabecalho.secoes[SECAO_DESTINOS]);
+    csr->inicioBaldes = (int*)(base + cabecalho.secoes[SECAO_INICIO_BALDES]);
+    csr->membrosBaldes = (int*)(base + cabecalho.secoes[SECAO_MEMBROS_BALDES]);
+
+    if (validar && !IndicesValidos(csr)) {
+        DesmapearFicheiro(&mapa);
+        memset(binario, 0, sizeof(GrafoBinario));
+        return -5;
+    }
+    binario->mapa = mapa;
+    return 0;
+}
+#pragma endregion
+
+#pragma region FecharGrafoBinario
+/**
+ * Funo para fechar um grafo binrio aberto com AbrirGrafoBinario.
+ *
+ * @param binario --> Apontador para o grafo binrio.
+ * @param return --> 0 se foi fechado, -1 se o argumento for nulo.
+ */
+int FecharGrafoBinario(GrafoBinario* binario) {
+    if (!binario) return -1;
+    DesmapearFicheiro(&binario->mapa);
+    memset(binario, 0, sizeof(GrafoBinario));
+    return 0;
+}
+#pragma endregion
@@ -0,0 +1,598 @@
+/*****************************************************************//**
+ * \file   grafocsr.c
+ * \brief  Cpia compacta (CSR) de um grafo de antenas e as anlises sobre ela.
+ *
+ * As travessias e os caminhos seguem os mesmos algoritmos e limites que as funes do
+ * grafo em listas. MostrarIntersecoesCSR e MostrarInterferenciasCSR so s a referncia
+ * do benchmark: comparam todos os pares de antenas, em O(n^2), como as verses originais,
+ * e no usam o ndice de intersees nem os limites das interferncias. O programa usa
+ * MostrarIntersecoes e MostrarInterferencias.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdint.h>
+#include "antenas.h"
+
+#pragma region ParAntenaIndice
+/**
+ * Estrutura auxiliar para converter apontadores de antenas em ndices.
+ * @param antena --> Apontador para a antena no grafo original.
+ * @param indice --> Posio da antena na lista do grafo.
+ */
+typedef struct ParAntenaIndice {
+    Antena* antena;
+    int indice;
+} ParAntenaIndice;
+
+static int CompararPares(const void* a, const void* b) {
+    uintptr_t pa = (uintptr_t)((const ParAntenaIndice*)a)->antena;
+    uintptr_t pb = (uintptr_t)((const ParAntenaIndice*)b)->antena;
+    return (pa > pb) - (pa < pb);
+}
+
+static int IndiceDaAntena(const ParAntenaIndice* pares, int total, Antena* antena) {
+    ParAntenaIndice chave = { antena, -1 };
+    const ParAntenaIndice* par = bsearch(&chave, pares, total, sizeof(ParAntenaIndice), CompararPares);
+    return par ? par->indice : -1;
+}
+#pragma endregion
+
+#pragma region ConstruirGrafoCSR
+/**
+ * Funo para construir a cpia compacta de um grafo.
+ * As antenas ficam em vetores contguos, as ligaes explcitas num nico vetor de destinos
+ * e os baldes de frequncia num vetor de ndices, todos acedidos por deslocamentos.
+ *
+ * @param grafo --> Apontador para o grafo original.
+ * @param csr --> Apontador para a estrutura a preencher.
+ * @param pares --> Vetor auxiliar (antena, ndice) ordenado pelo apontador.
+ * @param return --> 0 se a cpia foi construda, -1 se os argumentos forem nulos, -2 se falhar a alocao.
+ */
+int ConstruirGrafoCSR(Grafo* grafo, GrafoCSR* csr) {
+    if (!grafo || !csr) return -1;
+    memset(csr, 0, sizeof(GrafoCSR));
+
+    //Conta as antenas e as ligaes explcitas
+    int n = 0, m = 0;
+    for (Antena* a = grafo->antenas; a != NULL; a = a->proxima) {
+        n++;
+        for (Adjacencia* adj = a->ligacoes; adj != NULL; adj = adj->proxima) m++;
+    }
+
+    csr->frequencias = malloc(n > 0 ? n : 1);
+    csr->colunas = malloc((n > 0 ? n : 1) * sizeof(int));
+    csr->linhas = malloc((n > 0 ? n : 1) * sizeof(int));
+    csr->inicioArestas = malloc((n + 1) * sizeof(int));
+    csr->destinos = malloc((m > 0 ? m : 1) * sizeof(int));
+    csr->inicioBaldes = calloc(NUM_FREQUENCIAS + 1, sizeof(int));
+    csr->membrosBaldes = malloc((n > 0 ? n : 1) * sizeof(int));
+    ParAntenaIndice* pares = malloc((n > 0 ? n : 1) * sizeof(ParAntenaIndice));
+    if (!csr->frequencias || !csr->colunas || !csr->linhas || !csr->inicioArestas ||
+        !csr->destinos || !csr->inicioBaldes || !csr->membrosBaldes || !pares) {
+        free(pares);
+        LibertarGrafoCSR(csr);
+        return -2;
+    }
+    csr->totalAntenas = n;
+    csr->largura = grafo->largura;
+    csr->altura = grafo->altura;
+
+    //Copia os dados das antenas, pela ordem da lista
+    int i = 0;
+    for (Antena* a = grafo->antenas; a != NULL; a = a->proxima, i++) {
+        csr->frequencias[i] = a->frequencia;
+        csr->colunas[i] = a->coluna;
+        csr->linhas[i] = a->linha;
+        pares[i].antena = a;
+        pares[i].indice = i;
+    }
+    qsort(pares, n, sizeof(ParAntenaIndice), CompararPares);
+
+    //Copia as ligaes explcitas, mantendo a ordem de cada lista
+    i = 0;
+    int k = 0;
+    for (Antena* a = grafo->antenas; a != NULL; a = a->proxima, i++) {
+        csr->inicioArestas[i] = k;
+        for (Adjacencia* adj = a->ligacoes; adj != NULL; adj = adj->proxima) {
+            int destino = IndiceDaAntena(pares, n, adj->destino);
+            if (destino >= 0) csr->destinos[k++] = destino;
+        }
+    }
+    csr->inicioArestas[n] = k;
+    csr->totalArestas = k;
+
+    //Copia os baldes de frequncia, pela ordem de insero
+    k = 0;
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) {
+        csr->inicioBaldes[f] = k;
+        if (!grafo->baldes) continue;
+        BaldeFrequencia* balde = &grafo->baldes[f];
+        for (int j = 0; j < balde->total; j++) {
+            int membro = IndiceDaAntena(pares, n, balde->antenas[j]);
+            if (membro >= 0) csr->membrosBaldes[k++] = membro;
+        }
+    }
+    csr->inicioBaldes[NUM_FREQUENCIAS] = k;
+
+    free(pares);
+    return 0;
+}
+#pragma endregion
+
+#pragma region LibertarGrafoCSR
+/**
+ * Funo para libertar a memria de uma cpia compacta.
+ *
+ * @param csr --> Apontador para a cpia a libertar.
+ * @param return --> 0 se a memria foi libertada, -1 se o argumento for nulo.
+ */
+int LibertarGrafoCSR(GrafoCSR* csr) {
+    if (!csr) return -1;
+    free(csr->frequencias);
+    free(csr->colunas);
+    free(csr->linhas);
+    free(csr->inicioArestas);
+    free(csr->destinos);
+    free(csr->inicioBaldes);
+    free(csr->membrosBaldes);
+    memset(csr, 0, sizeof(GrafoCSR));
+    return 0;
+}
+#pragma endregion
+
+#pragma region ReconstruirGrafo
+/**
+ * Funo para voltar a construir um Grafo (listas) a partir de uma cpia compacta.
+ * A lista de antenas, as listas de ligaes e os baldes ficam exatamente pela ordem da cpia,
+ * e a largura e a altura da grelha so as da cpia (para o mapa de interferncias),
+ * por isso todas as anlises do grafo reconstrudo do o mesmo resultado que as do original.
+ *
+ * @param csr --> Apontador para a cpia compacta.
+ * @param grafo --> Apontador para o grafo a preencher (tem de estar vazio).
+ * @param antenas --> Apontador de cada antena criada, pelo ndice da cpia.
+ * @param ultima --> ltima antena da lista, para acrescentar no fim.
+ * @param return --> 0 se o grafo foi reconstrudo, -1 se os argumentos forem invlidos,
+ *                   -2 se falhar a alocao.
+ */
+int ReconstruirGrafo(const GrafoCSR* csr, Grafo* grafo) {
+    if (!csr || !grafo || grafo->antenas) return -1;
+
+    int n = csr->totalAntenas;
+    Antena** antenas = malloc((n > 0 ? n : 1) * sizeof(Antena*));
+    if (!antenas) return -2;
+
+    //Antenas pela ordem da cpia, acrescentadas no fim da lista
+    Antena* ultima = NULL;
+    for (int i = 0; i < n; i++) {
+        Antena* nova = popularAntena(grafo, csr->frequencias[i], csr->colunas[i], csr->linhas[i]);
+        if (!nova) {
+            free(antenas);
+            return -2;
+        }
+        nova->anterior = ultima;
+        if (ultima) ultima->proxima = nova;
+        else grafo->antenas = nova;
+        ultima = nova;
+        grafo->totalAntenas++;
+        if (IndexarAntena(grafo, nova) == -3) grafo->antenasForaDoIndice++;
+        antenas[i] = nova;
+    }
+
+    grafo->largura = csr->largura;
+    grafo->altura = csr->altura;
+
+    //AdicionarAdj insere no incio, por isso as ligaes so percorridas do fim para o incio
+    for (int i = 0; i < n; i++) {
+        for (int k = csr->inicioArestas[i + 1] - 1; k >= csr->inicioArestas[i]; k--) {
+            if (AdicionarAdj(grafo, antenas[i], antenas[csr->destinos[k]]) != 0) {
+                free(antenas);
+                return -2;
+            }
+        }
+    }
+
+    //Baldes pela ordem guardada na cpia (que pode no ser a ordem da lista)
+    for (int k = 0; k < csr->inicioBaldes[NUM_FREQUENCIAS]; k++) {
+        if (AdicionarAoBalde(grafo, antenas[csr->membrosBaldes[k]]) != 0) {
+            free(antenas);
+            return -2;
+        }
+    }
+
+    free(antenas);
+    return 0;
+}
+#pragma endregion
+
+#pragma region VizinhosCSR
+/**
+ * Nmero de posies de vizinhana de uma antena: ligaes explcitas mais o balde da sua frequncia.
+ */
+static int TotalVizinhosCSR(const GrafoCSR* csr, int v) {
+    int f = (unsigned char)csr->frequencias[v];
+    return (csr->inicioArestas[v + 1] - csr->inicioArestas[v]) +
+           (csr->inicioBaldes[f + 1] - csr->inicioBaldes[f]);
+}
+
+/**
+ * Vizinho na posio pos de uma antena, na mesma ordem que o IteradorVizinhos.
+ * Devolve -1 quando a posio corresponde  prpria antena dentro do balde.
+ */
+static int VizinhoCSR(const GrafoCSR* csr, int v, int pos) {
+    int explicitas = csr->inicioArestas[v + 1] - csr->inicioArestas[v];
+    if (pos < explicitas) return csr->destinos[csr->inicioArestas[v] + pos];
+
+    int f = (unsigned char)csr->frequencias[v];
+    int w = csr->membrosBaldes[csr->inicioBaldes[f] + pos - explicitas];
+    return w == v ? -1 : w;
+}
+
+static void EscreverAntenaCSR(const GrafoCSR* csr, int v, EscritorTexto* escritor) {
+    EscreverBytes(escritor, "Antena ", 7);
+    EscreverCaracter(escritor, csr->frequencias[v]);
+    EscreverBytes(escritor, " @ ", 3);
+    EscreverCoordenada(escritor, csr->colunas[v], csr->linhas[v]);
+    EscreverCaracter(escritor, '\n');
+}
+#pragma endregion
+
+#pragma region TravessiaEmProfundidadeCSR
+/**
+ * Funo para realizar uma travessia em profundidade sobre a cpia compacta.
+ * Usa uma pilha explcita e produz a mesma ordem que TravessiaEmProfundidade.
+ *
+ * @param csr --> Apontador para a cpia compacta.
+ * @param inicio --> ndice da antena de incio.
+ * @param saida --> Apontador para o ficheiro onde os resultados sero escritos.
+ * @param visitadas --> Vetor que marca as antenas j visitadas.
+ * @param pilhaAntenas --> Antenas na pilha da travessia.
+ * @param pilhaPosicoes --> Prxima posio de vizinhana a explorar de cada antena da pilha.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param return --> 0 se a travessia foi bem sucedida, valor negativo caso contrrio.
+ */
+int TravessiaEmProfundidadeCSR(const GrafoCSR* csr, int inicio, FILE* saida) {
+    if (!csr || !saida || inicio < 0 || inicio >= csr->totalAntenas) return -3;
+
+    int n = csr->totalAntenas;
+    bool* visitadas = calloc(n, sizeof(bool));
+    int* pilhaAntenas = malloc(n * sizeof(int));
+    int* pilhaPosicoes = malloc(n * sizeof(int));
+    if (!visitadas || !pilhaAntenas || !pilhaPosicoes) {
+        free(visitadas); free(pilhaAntenas); free(pilhaPosicoes);
+        return -2;
+    }
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    int topo = 0;
+    visitadas[inicio] = true;
+    EscreverAntenaCSR(csr, inicio, &escritor);
+    pilhaAntenas[0] = inicio;
+    pilhaPosicoes[0] = 0;
+
+    while (topo >= 0) {
+        int v = pilhaAntenas[topo];
+        //Se ainda houver vizinhos por explorar, desce para o primeiro no visitado
+        if (pilhaPosicoes[topo] < TotalVizinhosCSR(csr, v)) {
+            int w = VizinhoCSR(csr, v, pilhaPosicoes[topo]++);
+            if (w >= 0 && !visitadas[w]) {
+                visitadas[w] = true;
+                EscreverAntenaCSR(csr, w, &escritor);
+                topo++;
+                pilhaAntenas[topo] = w;
+                pilhaPosicoes[topo] = 0;
+            }
+        }
+        else {
+            topo--;
+        }
+    }
+
+    free(visitadas); free(pilhaAntenas); free(pilhaPosicoes);
+    return DescarregarEscritor(&escritor);
+}
+#pragma endregion
+
+#pragma region TravessiaEmLarguraCSR
+/**
+ * Funo para realizar uma travessia em largura sobre a cpia compacta.
+ *
+ * @param csr --> Apontador para a cpia compacta.
+ * @param inicio --> ndice da antena de incio.
+ * @param saida --> Apontador para o ficheiro onde os resultados sero escritos.
+ * @param fila --> Vetor usado como fila (cada antena entra no mximo uma vez).
+ * @param escritor --> Escritor com buffer para saida.
+ * @param return --> 0 se a travessia foi bem sucedida, valor negativo caso contrrio.
+ */
+int TravessiaEmLarguraCSR(const GrafoCSR* csr, int inicio, FILE* saida) {
+    if (!csr || !saida || inicio < 0 || inicio >= csr->totalAntenas) return -4;
+
+    int n = csr->totalAntenas;
+    bool* visitadas = calloc(n, sizeof(bool));
+    int* fila = malloc(n * sizeof(int));
+    if (!visitadas || !fila) {
+        free(visitadas); free(fila);
+        return -5;
+    }
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    int frente = 0, tras = 0;
+    fila[tras++] = inicio;
+    visitadas[inicio] = true;
+
+    while (frente < tras) {
+        int v = fila[frente++];
+        EscreverAntenaCSR(csr, v, &escritor);
+
+        int total = TotalVizinhosCSR(csr, v);
+        for (int pos = 0; pos < total; pos++) {
+            int w = VizinhoCSR(csr, v, pos);
+            if (w >= 0 && !visitadas[w]) {
+                visitadas[w] = true;
+                fila[tras++] = w;
+            }
+        }
+    }
+
+    free(visitadas); free(fila);
+    return DescarregarEscritor(&escritor);
+}
+#pragma endregion
+
+#pragma region EncontrarCaminhosCSR
+static void EscreverCaminhoCSR(const GrafoCSR* csr, const int* caminho, int comprimento, EscritorTexto* escritor) {
+    for (int i = 0; i < comprimento; i++) {
+        int v = caminho[i];
+        EscreverCaracter(escritor, csr->frequencias[v]);
+        EscreverCoordenada(escritor, csr->colunas[v], csr->linhas[v]);
+        if (i + 1 < comprimento) EscreverBytes(escritor, " -> ", 4);
+    }
+    EscreverCaracter(escritor, '\n');
+}
+
+//O relgio s  consultado a cada PASSOS_ENTRE_RELOGIO_CSR passos (como em ProcurarCaminhos)
+#define PASSOS_ENTRE_RELOGIO_CSR 1024
+
+/**
+ * Calcula o menor nmero de ligaes de cada antena at destino (-1 se no chegar), como
+ * DistanciasAteDestino em caminhos.c: procura em largura a partir do destino pelas ligaes
+ * invertidas e, quando chega a uma antena de um balde, por todas as antenas dessa frequncia
+ * (que a tm como vizinha), percorrendo cada frequncia uma s vez.
+ *
+ * @param csr --> Apontador para a cpia compacta.
+ * @param destino --> ndice da antena de destino.
+ * @param distancia --> Vetor com csr->totalAntenas posies a preencher.
+ * @param inicioEntradas --> As antenas com ligao para w esto em entradas[inicioEntradas[w]..inicioEntradas[w+1]-1].
+ * @param porFrequencia --> ndices agrupados por frequncia, com o incio de cada uma em inicioFrequencia.
+ * @param noBalde --> Se a antena est no balde da sua frequncia.
+ * @param return --> 0 se as distncias foram calculadas, -2 se falhar a alocao.
+ */
+static int DistanciasAteDestinoCSR(const GrafoCSR* csr, int destino, int* distancia) {
+    int n = csr->totalAntenas;
+    int* inicioEntradas = calloc(n + 1, sizeof(int));
+    int* entradas = malloc((csr->totalArestas > 0 ? csr->totalArestas : 1) * sizeof(int));
+    int* porFrequencia = malloc(n * sizeof(int));
+    bool* noBalde = calloc(n, sizeof(bool));
+    int* fila = malloc(n * sizeof(int));
+    if (!inicioEntradas || !entradas || !porFrequencia || !noBalde || !fila) {
+        free(inicioEntradas); free(entradas); free(porFrequencia); free(noBalde); free(fila);
+        return -2;
+    }
+
+    int inicioFrequencia[NUM_FREQUENCIAS + 1] = { 0 };
+    for (int v = 0; v < n; v++) inicioFrequencia[(unsigned char)csr->frequencias[v] + 1]++;
+    for (int k = 0; k < csr->totalArestas; k++) inicioEntradas[csr->destinos[k] + 1]++;
+    for (int v = 0; v < n; v++) inicioEntradas[v + 1] += inicioEntradas[v];
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) inicioFrequencia[f + 1] += inicioFrequencia[f];
+
+    //Preenche os vetores avanando uma cpia dos incios
+    int* posicaoEntradas = distancia;
+    memcpy(posicaoEntradas, inicioEntradas, n * sizeof(int));
+    int posicaoFrequencia[NUM_FREQUENCIAS];
+    memcpy(posicaoFrequencia, inicioFrequencia, sizeof(posicaoFrequencia));
+    for (int v = 0; v < n; v++) {
+        porFrequencia[posicaoFrequencia[(unsigned char)csr->frequencias[v]]++] = v;
+        for (int k = csr->inicioArestas[v]; k < csr->inicioArestas[v + 1]; k++) {
+            entradas[posicaoEntradas[csr->destinos[k]]++] = v;
+        }
+    }
+    for (int k = 0; k < csr->inicioBaldes[NUM_FREQUENCIAS]; k++) noBalde[csr->membrosBaldes[k]] = true;
+
+    bool frequenciaExpandida[NUM_FREQUENCIAS] = { false };
+    for (int v = 0; v < n; v++) distancia[v] = -1;
+    distancia[destino] = 0;
+    int frente = 0, tras = 0;
+    fila[tras++] = destino;
+    while (frente < tras) {
+        int w = fila[frente++];
+        for (int k = inicioEntradas[w]; k < inicioEntradas[w + 1]; k++) {
+            int v = entradas[k];
+            if (distancia[v] != -1) continue;
+            distancia[v] = distancia[w] + 1;
+            fila[tras++] = v;
+        }
+
+        int f = (unsigned char)csr->frequencias[w];
+        if (!noBalde[w] || frequenciaExpandida[f]) continue;
+        frequenciaExpandida[f] = true;
+        for (int k = inicioFrequencia[f]; k < inicioFrequencia[f + 1]; k++) {
+            int v = porFrequencia[k];
+            if (distancia[v] != -1) continue;
+            distancia[v] = distancia[w] + 1;
+            fila[tras++] = v;
+        }
+    }
+
+    free(inicioEntradas); free(entradas); free(porFrequencia); free(noBalde); free(fila);
+    return 0;
+}
+
+/**
+ * Funo para encontrar os caminhos simples entre duas antenas da cpia compacta.
+ * Segue a procura de EncontrarCaminhos (ProcurarCaminhos, modo CAMINHOS_TODOS): no entra
+ * em antenas que j no chegam ao destino e tem os mesmos limites (MAX_CAMINHOS_RELATORIO
+ * caminhos e MAX_SEGUNDOS_CAMINHOS segundos), por isso produz os mesmos caminhos, pela
+ * mesma ordem, com a mesma linha final quando a procura  interrompida.
+ *
+ * @param csr --> Apontador para a cpia compacta.
+ * @param origem --> ndice da antena de origem.
+ * @param destino --> ndice da antena de destino.
+ * @param saida --> Apontador para o ficheiro onde os caminhos sero escritos.
+ * @param caminho --> Antenas do caminho atual (funciona tambm como pilha).
+ * @param posicoes --> Prxima posio de vizinhana a explorar de cada antena do caminho.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param distancia --> Menor nmero de ligaes de cada antena ao destino.
+ * @param fimTempo --> Instante (TempoAtual) em que a procura tem de parar.
+ * @param esgotouTempo --> A procura parou por ter passado MAX_SEGUNDOS_CAMINHOS.
+ * @param return --> 0 se a procura foi bem sucedida, valor negativo caso contrrio.
+ */
+int EncontrarCaminhosCSR(const GrafoCSR* csr, int origem, int destino, FILE* saida) {
+    if (!csr || !saida || origem < 0 || destino < 0 ||
+        origem >= csr->totalAntenas || destino >= csr->totalAntenas) return -7;
+
+    int n = csr->totalAntenas;
+    bool* visitadas = calloc(n, sizeof(bool));
+    int* caminho = malloc((n + 1) * sizeof(int));
+    int* posicoes = malloc((n + 1) * sizeof(int));
+    int* distancia = malloc(n * sizeof(int));
+    if (!visitadas || !caminho || !posicoes || !distancia || DistanciasAteDestinoCSR(csr, destino, distancia) != 0) {
+        free(visitadas); free(caminho); free(posicoes); free(distancia);
+        return -7;
+    }
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    caminho[0] = origem;
+    if (origem == destino || distancia[origem] < 0) {
+        if (origem == destino) EscreverCaminhoCSR(csr, caminho, 1, &escritor);
+        free(visitadas); free(caminho); free(posicoes); free(distancia);
+        return DescarregarEscritor(&escritor);
+    }
+
+    int topo = 0;
+    posicoes[0] = 0;
+    visitadas[origem] = true;
+    long long totalCaminhos = 0;
+    unsigned int passos = 0;
+    double fimTempo = TempoAtual() + MAX_SEGUNDOS_CAMINHOS;
+    bool truncado = false, esgotouTempo = false;
+
+    while (topo >= 0 && !truncado) {
+        if ((++passos % PASSOS_ENTRE_RELOGIO_CSR) == 0 && TempoAtual() >= fimTempo) {
+            truncado = esgotouTempo = true;
+            break;
+        }
+        int v = caminho[topo];
+        if (posicoes[topo] < TotalVizinhosCSR(csr, v)) {
+            int w = VizinhoCSR(csr, v, posicoes[topo]++);
+            if (w < 0 || visitadas[w] || distancia[w] < 0 || topo + 1 + distancia[w] > n) continue;
+
+            caminho[topo + 1] = w;
+            //Chegou ao destino: escreve o caminho e no continua a partir dele
+            if (w == destino) {
+                EscreverCaminhoCSR(csr, caminho, topo + 2, &escritor);
+                truncado = ++totalCaminhos >= MAX_CAMINHOS_RELATORIO;
+            }
+            else {
+                topo++;
+                posicoes[topo] = 0;
+                visitadas[w] = true;
+            }
+        }
+        else {
+            //Desmarca ao recuar, para permitir outros caminhos por esta antena
+            visitadas[v] = false;
+            topo--;
+        }
+    }
+    if (truncado) {
+        EscreverTexto(&escritor, "... procura interrompida (");
+        EscreverTexto(&escritor, esgotouTempo ? "tempo esgotado" : "limite de caminhos");
+        EscreverTexto(&escritor, ") depois de ");
+        EscreverInteiro(&escritor, totalCaminhos);
+        EscreverTexto(&escritor, " caminhos\n");
+    }
+
+    free(visitadas); free(caminho); free(posicoes); free(distancia);
+    return DescarregarEscritor(&escritor);
+}
+#pragma endregion
+
+#pragma region MostrarIntersecoesCSR
+/**
+ * Mostra as intersees entre antenas de duas frequncias na cpia compacta.
+ * S para o benchmark: compara todos os pares de antenas (O(n^2)), para servir de
+ * referncia a MostrarIntersecoes, que d o mesmo resultado a partir do ndice de intersees.
+ *
+ * @param csr --> Apontador para a cpia compacta.
+ * @param freqA --> Frequncia da primeira antena.
+ * @param freqB --> Frequncia da segunda antena.
+ * @param saida --> Apontador para o ficheiro onde as intersees sero escritas.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param return --> 0 se as intersees foram mostradas, valor negativo caso contrrio.
+ */
+int MostrarIntersecoesCSR(const GrafoCSR* csr, char freqA, char freqB, FILE* saida) {
+    if (!csr || !saida) return -8;
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    int n = csr->totalAntenas;
+    for (int a = 0; a < n; a++) {
+        if (csr->frequencias[a] != freqA) continue;
+        for (int b = 0; b < n; b++) {
+            if (csr->frequencias[b] == freqB &&
+                (csr->linhas[a] == csr->linhas[b] || csr->colunas[a] == csr->colunas[b])) {
+                EscreverCaracter(&escritor, freqA);
+                EscreverCoordenada(&escritor, csr->colunas[a], csr->linhas[a]);
+                EscreverBytes(&escritor, " - ", 3);
+                EscreverCaracter(&escritor, freqB);
+                EscreverCoordenada(&escritor, csr->colunas[b], csr->linhas[b]);
+                EscreverCaracter(&escritor, '\n');
+            }
+        }
+    }
+    return DescarregarEscritor(&escritor);
+}
+#pragma endregion
+
+#pragma region MostrarInterferenciasCSR
+/**
+ * Funo para mostrar os pontos de interferncia a partir da cpia compacta.
+ * S para o benchmark: compara todos os pares de antenas da mesma frequncia (O(n^2)),
+ * para servir de referncia a MostrarInterferencias, que d o mesmo resultado.
+ *
+ * @param csr --> Apontador para a cpia compacta.
+ * @param saida --> Apontador para o ficheiro onde os pontos sero escritos.
+ * @param dx --> Diferena entre as colunas das antenas.
+ * @param dy --> Diferena entre as linhas das antenas.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param return --> 0 se os pontos foram mostrados, valor negativo caso contrrio.
+ */
+int MostrarInterferenciasCSR(const GrafoCSR* csr, FILE* saida) {
+    if (!csr || !saida) return -9;
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    EscreverTexto(&escritor, "=== PONTOS DE INTERFERENCIA ===\n");
+
+    int n = csr->totalAntenas;
+    for (int a1 = 0; a1 < n; a1++) {
+        for (int a2 = 0; a2 < n; a2++) {
+            if (csr->frequencias[a1] != csr->frequencias[a2]) continue;
+
+            int dx = csr->colunas[a2] - csr->colunas[a1];
+            int dy = csr->linhas[a2] - csr->linhas[a1];
+            if (dx == 0 || dy == 0 || abs(dx) == abs(dy)) {
+                for (int k = 1; k < 3; k++) {
+                    EscreverCoordenada(&escritor, csr->colunas[a1] + (k * dx) / 3, csr->linhas[a1] + (k * dy) / 3);
+                    EscreverCaracter(&escritor, '\n');
+                }
+            }
+        }
+    }
+    return DescarregarEscritor(&escritor);
+}
+#pragma endregion
@@ -0,0 +1,186 @@
+/*****************************************************************//**
+ * \file   indiceespacial.c
+ * \brief  ndice espacial (tabela de disperso por coluna e linha) das antenas de um grafo.
+ *
+ * Tabela de endereamento aberto com sondagem linear. As remoes deslocam
+ * as entradas seguintes para trs, por isso no so precisas marcas de apagado.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdint.h>
+#include "antenas.h"
+
+#define CAPACIDADE_INDICE_INICIAL 64
+
+#pragma region Dispersao
+/**
+ * Posio inicial de uma coordenada na tabela (capacidade  sempre uma potncia de 2).
+ */
+static int PosicaoInicial(int coluna, int linha, int capacidade) {
+    uint64_t chave = ((uint64_t)(uint32_t)coluna << 32) | (uint32_t)linha;
+    chave *= 0x9E3779B97F4A7C15ULL;
+    return (int)((chave ^ (chave >> 29)) & (uint64_t)(capacidade - 1));
+}
+#pragma endregion
+
+#pragma region CriarIndice
+static IndiceEspacial* CriarIndice(int capacidade) {
+    IndiceEspacial* indice = malloc(sizeof(IndiceEspacial));
+    if (!indice) return NULL;
+
+    indice->entradas = calloc(capacidade, sizeof(EntradaIndice));
+    if (!indice->entradas) {
+        free(indice);
+        return NULL;
+    }
+    indice->capacidade = capacidade;
+    indice->total = 0;
+    return indice;
+}
+#pragma endregion
+
+#pragma region CrescerIndice
+/**
+ * Duplica a capacidade da tabela e volta a inserir todas as entradas.
+ */
+static int CrescerIndice(IndiceEspacial* indice) {
+    int novaCapacidade = indice->capacidade * 2;
+    EntradaIndice* novas = calloc(novaCapacidade, sizeof(EntradaIndice));
+    if (!novas) return -2;
+
+    for (int i = 0; i < indice->capacidade; i++) {
+        EntradaIndice* e = &indice->entradas[i];
+        if (!e->antena) continue;
+        int pos = PosicaoInicial(e->coluna, e->linha, novaCapacidade);
+        while (novas[pos].antena) pos = (pos + 1) & (novaCapacidade - 1);
+        novas[pos] = *e;
+    }
+
+    free(indice->entradas);
+    indice->entradas = novas;
+    indice->capacidade = novaCapacidade;
+    return 0;
+}
+#pragma endregion
+
+#pragma region IndexarAntena
+/**
+ * Funo para registar uma antena no ndice espacial do grafo.
+ * O ndice  criado na primeira utilizao e cresce quando passa de 50% de ocupao.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param antena --> Apontador para a antena a registar.
+ * @param pos --> Posio da tabela a testar.
+ * @param return --> 0 se a antena foi registada, -1 se os argumentos forem nulos,
+ *                   -2 se falhar a alocao, -3 se j existir uma antena nessa posio.
+ */
+int IndexarAntena(Grafo* grafo, Antena* antena) {
+    if (!grafo || !antena) return -1;
+
+    if (!grafo->indice) {
+        grafo->indice = CriarIndice(CAPACIDADE_INDICE_INICIAL);
+        if (!grafo->indice) return -2;
+    }
+    IndiceEspacial* indice = grafo->indice;
+    if ((indice->total + 1) * 2 > indice->capacidade && CrescerIndice(indice) != 0) return -2;
+
+    int pos = PosicaoInicial(antena->coluna, antena->linha, indice->capacidade);
+    while (indice->entradas[pos].antena) {
+        if (indice->entradas[pos].coluna == antena->coluna && indice->entradas[pos].linha == antena->linha) {
+            return -3;
+        }
+        pos = (pos + 1) & (indice->capacidade - 1);
+    }
+
+    indice->entradas[pos].coluna = antena->coluna;
+    indice->entradas[pos].linha = antena->linha;
+    indice->entradas[pos].antena = antena;
+    indice->total++;
+    return 0;
+}
+#pragma endregion
+
+#pragma region ProcurarNoIndice
+/**
+ * Funo para procurar a antena que est numa coordenada, em tempo constante.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param coluna --> Posio horizontal (coordenada X).
+ * @param linha --> Posio vertical (coordenada Y).
+ * @return Apontador para a antena ou NULL se no existir nenhuma nessa posio.
+ */
+Antena* ProcurarNoIndice(const Grafo* grafo, int coluna, int linha) {
+    if (!grafo || !grafo->indice) return NULL;
+
+    const IndiceEspacial* indice = grafo->indice;
+    int pos = PosicaoInicial(coluna, linha, indice->capacidade);
+    int passos = 1;
+    while (indice->entradas[pos].antena) {
+        if (indice->entradas[pos].coluna == coluna && indice->entradas[pos].linha == linha) {
+            CONTAR(CONTADOR_PASSOS_PROCURAR, passos);
+            return indice->entradas[pos].antena;
+        }
+        pos = (pos + 1) & (indice->capacidade - 1);
+        passos++;
+    }
+    CONTAR(CONTADOR_PASSOS_PROCURAR, passos);
+    return NULL;
+}
+#pragma endregion
+
+#pragma region DesindexarAntena
+/**
+ * Funo para retirar do ndice a antena de uma coordenada.
+ * Depois de esvaziar a posio, puxa para trs as entradas seguintes do mesmo grupo
+ * para que as procuras continuem a encontr-las.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param coluna --> Posio horizontal (coordenada X).
+ * @param linha --> Posio vertical (coordenada Y).
+ * @param return --> 0 se a entrada foi retirada, -1 se o grafo no tiver ndice, -2 se no existir.
+ */
+int DesindexarAntena(Grafo* grafo, int coluna, int linha) {
+    if (!grafo || !grafo->indice) return -1;
+
+    IndiceEspacial* indice = grafo->indice;
+    int mascara = indice->capacidade - 1;
+    int pos = PosicaoInicial(coluna, linha, indice->capacidade);
+    while (indice->entradas[pos].antena) {
+        if (indice->entradas[pos].coluna == coluna && indice->entradas[pos].linha == linha) break;
+        pos = (pos + 1) & mascara;
+    }
+    if (!indice->entradas[pos].antena) return -2;
+
+    //Deslocamento para trs: cada entrada seguinte que possa ocupar o buraco passa para l
+    int buraco = pos;
+    for (int seguinte = (pos + 1) & mascara; indice->entradas[seguinte].antena; seguinte = (seguinte + 1) & mascara) {
+        EntradaIndice* e = &indice->entradas[seguinte];
+        int inicial = PosicaoInicial(e->coluna, e->linha, indice->capacidade);
+        //A entrada s pode recuar se a sua posio inicial no estiver entre o buraco e ela prpria
+        if (((seguinte - inicial) & mascara) >= ((seguinte - buraco) & mascara)) {
+            indice->entradas[buraco] = *e;
+            buraco = seguinte;
+        }
+    }
+    memset(&indice->entradas[buraco], 0, sizeof(EntradaIndice));
+    indice->total--;
+    return 0;
+}
+#pragma endregion
+
+#pragma region LibertarIndice
+/**
+ * Funo para libertar a memria do ndice espacial.
+ *
+ * @param indice --> Apontador para o ndice.
+ * @param return --> 0 se o ndice foi libertado, -1 se for nulo.
+ */
+int LibertarIndice(IndiceEspacial* indice) {
+    if (!indice) return -1;
+    free(indice->entradas);
+    free(indice);
+    return 0;
+}
+#pragma endregion
@@ -0,0 +1,254 @@
+/*****************************************************************//**
+ * \file   instrumentacao.c
+ * \brief  Contadores dos caminhos quentes e intervalos de tempo exportados como trace do Chrome.
+ *
+ * S  ativa quando o programa  compilado com INSTRUMENTACAO definido (make INSTRUMENTACAO=1,
+ * ou em Propriedades > C/C++ > Pr-processador no Visual Studio). Sem isso as macros CONTAR,
+ * ABRIR_SPAN e FECHAR_SPAN no geram cdigo e estas funes no registam nada.
+ *
+ * Os contadores so somas atmicas, porque as seces do relatrio e as interferncias
+ * correm em vrias threads. Cada intervalo (span) ocupa uma posio de um vetor fixo,
+ * reservada tambm com uma soma atmica; os que no cabem so contados e ignorados.
+ * O ficheiro exportado abre-se em chrome://tracing ou em https://ui.perfetto.dev.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "antenas.h"
+
+#define MAX_SPANS 4096
+
+//Nomes dos contadores, indexados por ContadorInstrumentacao
+static const char* const NOMES_CONTADORES[NUM_CONTADORES] = {
+    "alocacoes_antena", "alocacoes_adjacencia", "arestas_percorridas", "antenas_visitadas",
+    "passos_procurar", "passos_remover", "passos_adicionar", "bytes_escritos"
+};
+
+#pragma region NomeContador
+/**
+ * Funo para obter o nome de um contador (o usado no trace).
+ *
+ * @param contador --> Contador.
+ * @param return --> Nome do contador, ou "?" se no existir.
+ */
+const char* NomeContador(ContadorInstrumentacao contador) {
+    if ((int)contador < 0 || contador >= NUM_CONTADORES) return "?";
+    return NOMES_CONTADORES[contador];
+}
+#pragma endregion
+
+#ifdef INSTRUMENTACAO
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define SomarAtomico(destino, valor) InterlockedExchangeAdd64((volatile LONG64*)(destino), (valor))
+#define LOCAL_THREAD __declspec(thread)
+#else
+#define SomarAtomico(destino, valor) __atomic_fetch_add((destino), (valor), __ATOMIC_RELAXED)
+#define LOCAL_THREAD __thread
+#endif
+
+/**
+ * Intervalo de tempo registado.
+ * @param nome --> Nome do intervalo (texto constante do chamador).
+ * @param inicio --> Instante de incio (TempoAtual).
+ * @param fim --> Instante de fim (0 enquanto est aberto).
+ * @param thread --> Nmero da thread que o abriu (1 para a primeira thread que abriu um intervalo).
+ */
+typedef struct Span {
+    const char* nome;
+    double inicio;
+    double fim;
+    long long thread;
+} Span;
+
+static long long contadores[NUM_CONTADORES];
+static Span spans[MAX_SPANS];
+static long long totalSpans;
+static long long proximaThread;
+static LOCAL_THREAD long long threadAtual;
+
+#pragma region InstrumentacaoAtiva
+/**
+ * Funo para saber se o programa foi compilado com a instrumentao.
+ *
+ * @param return --> Verdadeiro com INSTRUMENTACAO, falso caso contrrio.
+ */
+bool InstrumentacaoAtiva(void) {
+    return true;
+}
+#pragma endregion
+
+#pragma region ContarInstrumentacao
+/**
+ * Funo para somar uma quantidade a um contador (usada pela macro CONTAR).
+ *
+ * @param contador --> Contador a incrementar.
+ * @param quantidade --> Quantidade a somar.
+ */
+void ContarInstrumentacao(ContadorInstrumentacao contador, long long quantidade) {
+    if ((int)contador < 0 || contador >= NUM_CONTADORES) return;
+    SomarAtomico(&contadores[contador], quantidade);
+}
+#pragma endregion
+
+#pragma region Spans
+/**
+ * Funo para abrir um intervalo de tempo na thread atual (usada pela macro ABRIR_SPAN).
+ *
+ * @param nome --> Nome do intervalo; tem de continuar vlido at ExportarTrace.
+ * @param indice --> Posio reservada no vetor de intervalos.
+ * @param return --> Identificador do intervalo para FecharSpan, ou -1 se o vetor estiver cheio.
+ */
+int AbrirSpan(const char* nome) {
+    long long indice = SomarAtomico(&totalSpans, 1);
+    if (indice >= MAX_SPANS) return -1;
+    if (threadAtual == 0) threadAtual = SomarAtomico(&proximaThread, 1) + 1;
+
+    spans[indice].nome = nome;
+    spans[indice].thread = threadAtual;
+    spans[indice].fim = 0;
+    spans[indice].inicio = TempoAtual();
+    return (int)indice;
+}
+
+/**
+ * Funo para fechar um intervalo aberto com AbrirSpan (usada pela macro FECHAR_SPAN).
+ *
+ * @param span --> Identificador devolvido por AbrirSpan (-1  ignorado).
+ */
+void FecharSpan(int span) {
+    if (span < 0 || span >= MAX_SPANS) return;
+    spans[span].fim = TempoAtual();
+}
+#pragma endregion
+
+#pragma region LerContadores
+/**
+ * Funo para copiar o valor atual de todos os contadores.
+ *
+ * @param valores --> Vetor com NUM_CONTADORES posies.
+ * @param return --> 0, ou -1 se o vetor for nulo.
+ */
+int LerContadores(long long* valores) {
+    if (!valores) return -1;
+    for (int c = 0; c < NUM_CONTADORES; c++) valores[c] = SomarAtomico(&contadores[c], 0);
+    return 0;
+}
+#pragma endregion
+
+#pragma region ReiniciarInstrumentacao
+/**
+ * Funo para pr os contadores a zero e esquecer os intervalos registados.
+ * No pode ser chamada enquanto outras threads esto a registar.
+ *
+ * @param return --> 0.
+ */
+int ReiniciarInstrumentacao(void) {
+    memset(contadores, 0, sizeof(contadores));
+    totalSpans = 0;
+    return 0;
+}
+#pragma endregion
+
+#pragma region ExportarTrace
+/**
+ * Escreve o nome de um intervalo como string JSON (s as aspas e a barra precisam de escape,
+ * os restantes carateres de controlo passam a espao).
+ */
+static void EscreverNomeJson(FILE* ficheiro, const char* nome) {
+    fputc('"', ficheiro);
+    for (const char* c = nome ? nome : "?"; *c; c++) {
+        if (*c == '"' || *c == '\\') fputc('\\', ficheiro);
+        fputc((unsigned char)*c < 0x20 ? ' ' : *c, ficheiro);
+    }
+    fputc('"', ficheiro);
+}
+
+/**
+ * Funo para exportar os intervalos e os contadores no formato de trace do Chrome (JSON).
+ * Cada intervalo fechado  um evento completo ("ph":"X") com o incio e a durao em
+ * microssegundos, contados a partir do primeiro intervalo; os contadores vo num evento
+ * de contador ("ph":"C") no fim do ltimo intervalo. Deve ser chamada depois de as
+ * threads terminarem.
+ *
+ * @param nomeFicheiro --> Ficheiro a criar.
+ * @param total --> Nmero de intervalos registados (no mximo MAX_SPANS).
+ * @param origem, fim --> Primeiro incio e ltimo fim dos intervalos.
+ * @param valores --> Valores dos contadores.
+ * @param return --> 0 se o ficheiro foi escrito, -1 se o nome for nulo, -2 se no foi possvel escrev-lo.
+ */
+int ExportarTrace(const char* nomeFicheiro) {
+    if (!nomeFicheiro) return -1;
+    FILE* ficheiro = fopen(nomeFicheiro, "w");
+    if (!ficheiro) return -2;
+
+    int total = totalSpans < MAX_SPANS ? (int)totalSpans : MAX_SPANS;
+    double origem = 0, fim = 0;
+    for (int i = 0; i < total; i++) {
+        if (i == 0 || spans[i].inicio < origem) origem = spans[i].inicio;
+        if (spans[i].fim > fim) fim = spans[i].fim;
+    }
+    if (fim < origem) fim = origem;
+
+    fprintf(ficheiro, "{\"traceEvents\":[\n");
+    for (int i = 0; i < total; i++) {
+        if (spans[i].fim == 0) continue;
+        fprintf(ficheiro, "{\"name\":");
+        EscreverNomeJson(ficheiro, spans[i].nome);
+        fprintf(ficheiro, ",\"ph\":\"X\",\"pid\":1,\"tid\":%lld,\"ts\":%.3f,\"dur\":%.3f},\n",
+            spans[i].thread, (spans[i].inicio - origem) * 1e6, (spans[i].fim - spans[i].inicio) * 1e6);
+    }
+
+    long long valores[NUM_CONTADORES];
+    LerContadores(valores);
+    fprintf(ficheiro, "{\"name\":\"contadores\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"args\":{", (fim - origem) * 1e6);
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        fprintf(ficheiro, "%s\"%s\":%lld", c ? "," : "", NOMES_CONTADORES[c], valores[c]);
+    }
+    fprintf(ficheiro, "}}\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"spansIgnorados\":%lld}}\n",
+        totalSpans > MAX_SPANS ? totalSpans - MAX_SPANS : 0);
+
+    bool erro = ferror(ficheiro) != 0;
+    if (fclose(ficheiro) != 0) erro = true;
+    return erro ? -2 : 0;
+}
+#pragma endregion
+
+#else
+
+bool InstrumentacaoAtiva(void) {
+    return false;
+}
+
+void ContarInstrumentacao(ContadorInstrumentacao contador, long long quantidade) {
+    (void)contador;
+    (void)quantidade;
+}
+
+int AbrirSpan(const char* nome) {
+    (void)nome;
+    return -1;
+}
+
+void FecharSpan(int span) {
+    (void)span;
+}
+
+int LerContadores(long long* valores) {
+    (void)valores;
+    return -1;
+}
+
+int ReiniciarInstrumentacao(void) {
+    return -1;
+}
+
+int ExportarTrace(const char* nomeFicheiro) {
+    (void)nomeFicheiro;
+    return -1;
+}
+
+#endif
@@ -0,0 +1,658 @@
+/*****************************************************************//**
+ * \file   interferencias.c
+ * \brief  Clculo dos pontos de interferncia, por frequncia e em paralelo.
+ *
+ * S antenas da mesma frequncia interferem, por isso cada frequncia 
+ * tratada  parte, com as coordenadas em vetores (VetoresAntenas) comparadas
+ * em blocos por AntenasAlinhadas. As antenas de cada frequncia so divididas em tarefas
+ * de trabalho parecido; cada tarefa escreve para o seu prprio buffer e,
+ * no fim, os pedaos so juntos pela ordem da lista do grafo, o que d
+ * exatamente a mesma sada que o ciclo sequencial.
+ *
+ * No modo de mapa (CalcularMapaInterferencias) os pontos no so guardados: cada
+ * tarefa acende diretamente o bit da clula num mapa de bits partilhado, com um OU
+ * atmico, e as clulas repetidas ou fora da grelha ficam de fora sem ordenar nada.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdint.h>
+#include "antenas.h"
+
+#define TAREFAS_POR_THREAD 4
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define LerPalavra(palavra) (*(volatile const uint64_t*)(palavra))
+#define AcenderBits(palavra, bits) InterlockedOr64((volatile LONG64*)(palavra), (LONG64)(bits))
+#else
+#define LerPalavra(palavra) __atomic_load_n((palavra), __ATOMIC_RELAXED)
+#define AcenderBits(palavra, bits) __atomic_fetch_or((palavra), (bits), __ATOMIC_RELAXED)
+#endif
+
+/**
+ * Tarefa: antenas [inicio, fim) de uma frequncia (posies nos vetores das antenas).
+ * @param frequencia --> Frequncia das antenas da tarefa.
+ * @param inicio --> Primeira posio da tarefa.
+ * @param fim --> Posio a seguir  ltima.
+ * @param texto --> Pontos formatados (modo normal).
+ * @param pontos --> Pontos por formatar, em pares (x,y) (modo sem duplicados).
+ * @param totalPontos --> Nmero de pontos calculados pela tarefa.
+ * @param capacidadePontos --> Nmero de pontos que cabem em pontos.
+ * @param alinhadas --> Posies das antenas alinhadas com a antena atual (uma por antena da frequncia).
+ * @param pontosFora --> Pontos fora do mapa (modo de mapa).
+ */
+typedef struct TarefaInterferencia {
+    int frequencia;
+    int inicio;
+    int fim;
+    BufferTexto texto;
+    int* pontos;
+    size_t totalPontos;
+    size_t capacidadePontos;
+    int* alinhadas;
+    size_t pontosFora;
+} TarefaInterferencia;
+
+/**
+ * Dados partilhados pelas tarefas.
+ * @param vetores --> Coordenadas das antenas, agrupadas por frequncia (e a sua posio na lista).
+ * @param inicioPedaco --> Para cada posio, incio do seu pedao no buffer/pontos da tarefa.
+ * @param fimPedaco --> Para cada posio, fim do seu pedao.
+ * @param tarefas --> Tarefas.
+ * @param semDuplicados --> Se verdadeiro, ignora a prpria antena e os pontos repetidos.
+ * @param guardarPontos --> Se verdadeiro, guarda os pontos em vez de os formatar (sem duplicados ou com visitante).
+ * @param mapa --> Mapa de bits onde as tarefas marcam as clulas (NULL fora do modo de mapa).
+ * @param larguraMapa, alturaMapa --> Limites do mapa.
+ */
+typedef struct CalculoInterferencias {
+    VetoresAntenas vetores;
+    size_t* inicioPedaco;
+    size_t* fimPedaco;
+    TarefaInterferencia* tarefas;
+    bool semDuplicados;
+    bool guardarPontos;
+    uint64_t* mapa;
+    int larguraMapa;
+    int alturaMapa;
+} CalculoInterferencias;
+
+#pragma region CalcularTarefa
+static int GuardarPonto(TarefaInterferencia* tarefa, int x, int y) {
+    if (tarefa->totalPontos == tarefa->capacidadePontos) {
+        size_t novaCapacidade = tarefa->capacidadePontos ? tarefa->capacidadePontos * 2 : 1024;
+        int* novos = realloc(tarefa->pontos, novaCapacidade * 2 * sizeof(int));
+        if (!novos) return -2;
+        tarefa->pontos = novos;
+        tarefa->capacidadePontos = novaCapacidade;
+    }
+    tarefa->pontos[tarefa->totalPontos * 2] = x;
+    tarefa->pontos[tarefa->totalPontos * 2 + 1] = y;
+    tarefa->totalPontos++;
+    return 0;
+}
+
+static int FormatarPonto(BufferTexto* texto, int x, int y) {
+    char ponto[TAMANHO_COORDENADA + 1];
+    char* fim = ponto + sizeof(ponto);
+    *--fim = '\n';
+    char* inicio = FormatarCoordenada(fim, x, y);
+    return AcrescentarTexto(texto, inicio, ponto + sizeof(ponto) - inicio);
+}
+
+/**
+ * Marca no mapa os pontos da antena i da tarefa, sem a comparar consigo prpria.
+ * S acende o bit (OU atmico) quando ainda est apagado, para no disputar as
+ * palavras do mapa que as outras tarefas j marcaram.
+ */
+static void MarcarPontos(const CalculoInterferencias* calculo, TarefaInterferencia* tarefa, int i, int inicioGrupo, int totalAlinhadas) {
+    const Coordenada* colunas = calculo->vetores.colunas;
+    const Coordenada* linhas = calculo->vetores.linhas;
+    int x1 = colunas[i], y1 = linhas[i];
+
+    for (int a = 0; a < totalAlinhadas; a++) {
+        int j = inicioGrupo + tarefa->alinhadas[a];
+        if (j == i) continue;
+        int dx = colunas[j] - x1;
+        int dy = linhas[j] - y1;
+
+        for (int k = 1; k < 3; k++) {
+            int x = x1 + (k * dx) / 3;
+            int y = y1 + (k * dy) / 3;
+            tarefa->totalPontos++;
+            if (x < 0 || x >= calculo->larguraMapa || y < 0 || y >= calculo->alturaMapa) {
+                tarefa->pontosFora++;
+                continue;
+            }
+
+            size_t celula = (size_t)y * (size_t)calculo->larguraMapa + (size_t)x;
+            uint64_t* palavra = &calculo->mapa[celula / 64];
+            uint64_t bit = (uint64_t)1 << (celula % 64);
+            if (!(LerPalavra(palavra) & bit)) AcenderBits(palavra, bit);
+        }
+    }
+}
+
+/**
+ * Executa uma tarefa: para cada antena a1 da tarefa, procura as antenas a2 da mesma frequncia
+ * alinhadas com ela (AntenasAlinhadas, em blocos, pela ordem da lista) e regista os dois pontos
+ * de cada par (ou marca-os no mapa, no modo de mapa).
+ */
+static int CalcularTarefa(int indiceTarefa, void* contexto) {
+    CalculoInterferencias* calculo = contexto;
+    TarefaInterferencia* tarefa = &calculo->tarefas[indiceTarefa];
+    int inicioGrupo = calculo->vetores.inicioFrequencia[tarefa->frequencia];
+    int fimGrupo = calculo->vetores.inicioFrequencia[tarefa->frequencia + 1];
+    const Coordenada* colunas = calculo->vetores.colunas;
+    const Coordenada* linhas = calculo->vetores.linhas;
+
+    tarefa->alinhadas = malloc((fimGrupo - inicioGrupo) * sizeof(int));
+    if (!tarefa->alinhadas) return -2;
+
+    if (calculo->mapa) {
+        for (int i = tarefa->inicio; i < tarefa->fim; i++) {
+            int totalAlinhadas = AntenasAlinhadas(colunas[i], linhas[i], colunas + inicioGrupo, linhas + inicioGrupo,
+                fimGrupo - inicioGrupo, ALINHAMENTO_DIAGONAL, tarefa->alinhadas);
+            MarcarPontos(calculo, tarefa, i, inicioGrupo, totalAlinhadas);
+        }
+        return 0;
+    }
+
+    for (int i = tarefa->inicio; i < tarefa->fim; i++) {
+        calculo->inicioPedaco[i] = calculo->guardarPontos ? tarefa->totalPontos : tarefa->texto.tamanho;
+        int x1 = colunas[i], y1 = linhas[i];
+        int totalAlinhadas = AntenasAlinhadas(colunas[i], linhas[i], colunas + inicioGrupo, linhas + inicioGrupo,
+            fimGrupo - inicioGrupo, ALINHAMENTO_DIAGONAL, tarefa->alinhadas);
+
+        for (int a = 0; a < totalAlinhadas; a++) {
+            int j = inicioGrupo + tarefa->alinhadas[a];
+            if (calculo->semDuplicados && j == i) continue;
+            int dx = colunas[j] - x1;
+            int dy = linhas[j] - y1;
+
+            for (int k = 1; k < 3; k++) {
+                int x = x1 + (k * dx) / 3;
+                int y = y1 + (k * dy) / 3;
+                if (calculo->guardarPontos) {
+                    if (GuardarPonto(tarefa, x, y) != 0) return -2;
+                }
+                else {
+                    if (FormatarPonto(&tarefa->texto, x, y) != 0) return -2;
+                    tarefa->totalPontos++;
+                }
+            }
+        }
+        calculo->fimPedaco[i] = calculo->guardarPontos ? tarefa->totalPontos : tarefa->texto.tamanho;
+    }
+    return 0;
+}
+#pragma endregion
+
+#pragma region DividirTarefas
+/**
+ * Divide as antenas de cada frequncia em tarefas com trabalho parecido.
+ * O trabalho de uma antena  o nmero de antenas da sua frequncia, por isso uma
+ * frequncia com muitas antenas d origem a vrias tarefas.
+ * Devolve o nmero de tarefas (com tarefas == NULL s conta).
+ */
+static int DividirTarefas(const CalculoInterferencias* calculo, int numThreads, TarefaInterferencia* tarefas) {
+    long long trabalhoTotal = 0;
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) {
+        long long n = calculo->vetores.inicioFrequencia[f + 1] - calculo->vetores.inicioFrequencia[f];
+        trabalhoTotal += n * n;
+    }
+    long long alvo = trabalhoTotal / ((long long)numThreads * TAREFAS_POR_THREAD) + 1;
+
+    int total = 0;
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) {
+        int inicio = calculo->vetores.inicioFrequencia[f], fim = calculo->vetores.inicioFrequencia[f + 1];
+        if (inicio == fim) continue;
+        long long porTarefa = alvo / (fim - inicio);
+        if (porTarefa < 1) porTarefa = 1;
+
+        for (long long i = inicio; i < fim; i += porTarefa) {
+            if (tarefas) {
+                memset(&tarefas[total], 0, sizeof(TarefaInterferencia));
+                tarefas[total].frequencia = f;
+                tarefas[total].inicio = (int)i;
+                tarefas[total].fim = (int)(i + porTarefa < fim ? i + porTarefa : fim);
+            }
+            total++;
+        }
+    }
+    return total;
+}
+#pragma endregion
+
+#pragma region JuntarResultados
+/**
+ * Junta os pedaos pela ordem da lista do grafo e escreve-os (os pedaos pequenos juntam-se no buffer do escritor).
+ */
+static int JuntarTexto(const CalculoInterferencias* calculo, const int* tarefaDaPosicao, const int* posicaoNaLista, int n, EscritorTexto* escritor) {
+    for (int a = 0; a < n; a++) {
+        int i = posicaoNaLista[a];
+        const BufferTexto* texto = &calculo->tarefas[tarefaDaPosicao[i]].texto;
+        size_t tamanho = calculo->fimPedaco[i] - calculo->inicioPedaco[i];
+        if (tamanho > 0 && EscreverBytes(escritor, texto->dados + calculo->inicioPedaco[i], tamanho) != 0) return escritor->erro;
+    }
+    return 0;
+}
+
+static int EscreverPonto(int coluna, int linha, void* contexto) {
+    EscritorTexto* escritor = contexto;
+    EscreverCoordenada(escritor, coluna, linha);
+    return EscreverCaracter(escritor, '\n');
+}
+
+/**
+ * Junta os pontos guardados pela ordem da lista do grafo e passa-os ao visitante.
+ * Sem duplicados, s a primeira ocorrncia de cada ponto  passada; os pontos j vistos
+ * ficam numa tabela de disperso (endereamento aberto). Para quando o visitante devolve
+ * outro valor que no 0.
+ */
+static long long JuntarPontos(const CalculoInterferencias* calculo, int numTarefas, const int* tarefaDaPosicao,
+    const int* posicaoNaLista, int n, VisitantePonto visitante, void* contexto) {
+    size_t capacidade = 0;
+    uint64_t* chaves = NULL;
+    bool* ocupadas = NULL;
+    if (calculo->semDuplicados) {
+        size_t totalPontos = 0;
+        for (int t = 0; t < numTarefas; t++) totalPontos += calculo->tarefas[t].totalPontos;
+
+        capacidade = 16;
+        while (capacidade < totalPontos * 2) capacidade *= 2;
+        chaves = malloc(capacidade * sizeof(uint64_t));
+        ocupadas = calloc(capacidade, sizeof(bool));
+        if (!chaves || !ocupadas) {
+            free(chaves);
+            free(ocupadas);
+            return -2;
+        }
+    }
+
+    long long escritos = 0;
+    int resultado = 0;
+    for (int a = 0; a < n && resultado == 0; a++) {
+        int i = posicaoNaLista[a];
+        const int* pontos = calculo->tarefas[tarefaDaPosicao[i]].pontos;
+        for (size_t p = calculo->inicioPedaco[i]; p < calculo->fimPedaco[i] && resultado == 0; p++) {
+            int x = pontos[p * 2], y = pontos[p * 2 + 1];
+            escritos++;
+            if (!calculo->semDuplicados) {
+                resultado = visitante(x, y, contexto);
+                continue;
+            }
+
+            uint64_t chave = ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+            uint64_t h = chave * 0x9E3779B97F4A7C15ULL;
+            size_t pos = (size_t)(h ^ (h >> 32)) & (capacidade - 1);
+            while (ocupadas[pos] && chaves[pos] != chave) pos = (pos + 1) & (capacidade - 1);
+            if (ocupadas[pos]) {
+                escritos--;
+                continue;
+            }
+
+            ocupadas[pos] = true;
+            chaves[pos] = chave;
+            resultado = visitante(x, y, contexto);
+        }
+    }
+
+    free(chaves);
+    free(ocupadas);
+    return escritos;
+}
+#pragma endregion
+
+#pragma region EscreverPontosInterferencia
+/**
+ * Calcula os pontos de interferncia e junta-os pela ordem da lista: com visitante, os pontos
+ * so guardados e passados ao visitante; sem visitante, so escritos como texto no escritor.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param opcoes --> Nmero de threads e se os pontos repetidos devem ser omitidos (NULL para as predefinies).
+ * @param visitante --> Funo chamada para cada ponto, ou NULL para escrever no escritor.
+ * @param contexto --> Dados do chamador, passados ao visitante.
+ * @param escritor --> Escritor onde o texto  escrito quando no h visitante.
+ * @param calculo --> Dados partilhados pelas tarefas.
+ * @param posicaoNaLista --> Para cada antena da lista, a sua posio nos vetores das antenas.
+ * @param tarefaDaPosicao --> Tarefa responsvel por cada posio dos vetores.
+ * @param return --> Nmero de pontos, -2 se falhar a alocao, -4 se uma coordenada no couber em
+ *                   Coordenada, ou o erro do escritor se a escrita falhar.
+ */
+static long long CalcularPontosInterferencia(Grafo* grafo, const OpcoesInterferencias* opcoes, VisitantePonto visitante,
+    void* contexto, EscritorTexto* escritor) {
+    int numThreads = opcoes ? opcoes->numThreads : 0;
+    if (numThreads <= 0) numThreads = NumeroProcessadores();
+
+    CalculoInterferencias calculo;
+    memset(&calculo, 0, sizeof(CalculoInterferencias));
+    calculo.semDuplicados = opcoes ? opcoes->semDuplicados : false;
+    calculo.guardarPontos = calculo.semDuplicados || visitante != NULL;
+    if (!visitante && calculo.semDuplicados) {
+        visitante = EscreverPonto;
+        contexto = escritor;
+    }
+
+    //Agrupa as antenas por frequncia, mantendo a ordem da lista dentro de cada frequncia
+    int construidos = ConstruirVetoresAntenas(grafo, &calculo.vetores);
+    if (construidos != 0) return construidos;
+    int n = calculo.vetores.total;
+    if (n == 0) return 0;
+
+    calculo.inicioPedaco = malloc(n * sizeof(size_t));
+    calculo.fimPedaco = malloc(n * sizeof(size_t));
+    int* posicaoNaLista = malloc(n * sizeof(int));
+    int* tarefaDaPosicao = malloc(n * sizeof(int));
+    long long resultado = 0;
+    if (!calculo.inicioPedaco || !calculo.fimPedaco || !posicaoNaLista || !tarefaDaPosicao) {
+        resultado = -2;
+    }
+
+    int numTarefas = 0;
+    if (resultado == 0) {
+        for (int pos = 0; pos < n; pos++) posicaoNaLista[calculo.vetores.posicoes[pos]] = pos;
+
+        numTarefas = DividirTarefas(&calculo, numThreads, NULL);
+        calculo.tarefas = malloc(numTarefas * sizeof(TarefaInterferencia));
+        if (!calculo.tarefas) resultado = -2;
+    }
+
+    if (resultado == 0) {
+        DividirTarefas(&calculo, numThreads, calculo.tarefas);
+        for (int t = 0; t < numTarefas; t++) {
+            for (int i = calculo.tarefas[t].inicio; i < calculo.tarefas[t].fim; i++) tarefaDaPosicao[i] = t;
+        }
+
+        if (ExecutarEmParalelo(numTarefas, numThreads, CalcularTarefa, &calculo) != 0) resultado = -2;
+    }
+
+    long long escritos = 0;
+    if (resultado == 0) {
+        if (calculo.guardarPontos) {
+            escritos = JuntarPontos(&calculo, numTarefas, tarefaDaPosicao, posicaoNaLista, n, visitante, contexto);
+            if (escritos < 0) resultado = escritos;
+        }
+        else {
+            resultado = JuntarTexto(&calculo, tarefaDaPosicao, posicaoNaLista, n, escritor);
+            for (int t = 0; t < numTarefas && resultado == 0; t++) escritos += (long long)calculo.tarefas[t].totalPontos;
+        }
+    }
+
+    for (int t = 0; t < numTarefas && calculo.tarefas; t++) {
+        LibertarBuffer(&calculo.tarefas[t].texto);
+        free(calculo.tarefas[t].pontos);
+        free(calculo.tarefas[t].alinhadas);
+    }
+    free(calculo.tarefas);
+    LibertarVetoresAntenas(&calculo.vetores);
+    free(calculo.inicioPedaco);
+    free(calculo.fimPedaco);
+    free(posicaoNaLista);
+    free(tarefaDaPosicao);
+    return resultado < 0 ? resultado : escritos;
+}
+
+/**
+ * Funo para escrever os pontos de interferncia de um grafo.
+ * Para cada antena a1 (pela ordem da lista) e cada antena a2 da mesma frequncia (tambm pela
+ * ordem da lista) que esteja na mesma linha, coluna ou diagonal, escreve os pontos a 1/3 e 2/3
+ * do caminho de a1 para a2. As frequncias (e as frequncias grandes divididas em partes) so
+ * calculadas em paralelo, cada tarefa para o seu buffer; os buffers so depois juntos pela
+ * ordem da lista, por isso a sada no depende do nmero de threads.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param opcoes --> Nmero de threads e se os pontos repetidos devem ser omitidos (NULL para as predefinies).
+ * @param saida --> Apontador para o ficheiro onde os pontos sero escritos.
+ * @param escritor --> Escritor com buffer para saida, onde os resultados das tarefas so juntos.
+ * @param return --> Nmero de pontos escritos, -9 se os argumentos forem nulos, -2 se falhar a alocao,
+ *                   -3 se a escrita falhar, -4 se uma coordenada no couber em Coordenada (COORDENADAS_16_BITS).
+ */
+long long EscreverPontosInterferencia(Grafo* grafo, const OpcoesInterferencias* opcoes, FILE* saida) {
+    if (!grafo || !saida) return -9;
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    long long resultado = CalcularPontosInterferencia(grafo, opcoes, NULL, NULL, &escritor);
+    if (DescarregarEscritor(&escritor) != 0 && resultado >= 0) resultado = -3;
+    return resultado;
+}
+
+/**
+ * Funo para escrever os pontos de interferncia, como EscreverPontosInterferencia, num
+ * escritor j aberto (que pode ter o destino em memria). O escritor no  descarregado.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param opcoes --> Nmero de threads e se os pontos repetidos devem ser omitidos (NULL para as predefinies).
+ * @param escritor --> Escritor onde os pontos so escritos.
+ * @param return --> Nmero de pontos escritos, -9 se os argumentos forem nulos, -2 se falhar a alocao,
+ *                   ou o erro do escritor se a escrita falhar.
+ */
+long long EscreverPontosInterferenciaEscritor(Grafo* grafo, const OpcoesInterferencias* opcoes, EscritorTexto* escritor) {
+    if (!grafo || !escritor) return -9;
+    long long resultado = CalcularPontosInterferencia(grafo, opcoes, NULL, NULL, escritor);
+    return resultado >= 0 && escritor->erro != 0 ? escritor->erro : resultado;
+}
+
+/**
+ * Funo para percorrer os pontos de interferncia de um grafo, pela mesma ordem em que
+ * EscreverPontosInterferencia os escreve, sem os formatar.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param opcoes --> Nmero de threads e se os pontos repetidos devem ser omitidos (NULL para as predefinies).
+ * @param visitante --> Funo chamada para cada ponto; se devolver outro valor que no 0 a juno para.
+ * @param contexto --> Dados do chamador, passados ao visitante.
+ * @param return --> Nmero de pontos visitados, -9 se os argumentos forem nulos, -2 se falhar a alocao.
+ */
+long long PercorrerPontosInterferencia(Grafo* grafo, const OpcoesInterferencias* opcoes, VisitantePonto visitante, void* contexto) {
+    if (!grafo || !visitante) return -9;
+    return CalcularPontosInterferencia(grafo, opcoes, visitante, contexto, NULL);
+}
+#pragma endregion
+
+#pragma region MostrarInterferenciasOpcoes
+/**
+ * Funo para mostrar os pontos de interferncia com opes (threads e pontos repetidos).
+ *
+ * @param grafo --> Apontador para o grafo onde as antenas esto localizadas.
+ * @param opcoes --> Opes do clculo (NULL para as predefinies).
+ * @param saida --> Apontador para o ficheiro onde os pontos de interferncia sero escritos.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param return --> 0 se os pontos foram mostrados, -9 se os argumentos forem nulos,
+ *                   -2 se falhar a alocao, -3 se a escrita falhar.
+ */
+int MostrarInterferenciasOpcoes(Grafo* grafo, const OpcoesInterferencias* opcoes, FILE* saida) {
+    if (!grafo || !saida) return -9;
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    EscreverTexto(&escritor, "=== PONTOS DE INTERFERENCIA ===\n");
+    if (DescarregarEscritor(&escritor) != 0) return -3;
+    long long resultado = EscreverPontosInterferencia(grafo, opcoes, saida);
+    return resultado < 0 ? (int)resultado : 0;
+}
+#pragma endregion
+
+#pragma region CalcularMapaInterferencias
+/**
+ * Conta os bits acesos de uma palavra do mapa.
+ */
+static int ContarBits(uint64_t palavra) {
+    int total = 0;
+    for (; palavra; palavra &= palavra - 1) total++;
+    return total;
+}
+
+/**
+ * Funo para calcular o mapa das clulas afetadas por interferncias.
+ * Os pontos so os de EscreverPontosInterferencia sem os de cada antena consigo prpria; cada
+ * ponto acende o bit da sua clula, por isso uma clula repetida s conta uma vez e os pontos
+ * fora da grelha (largura x altura do grafo ou, se o grafo no as conhecer, a menor grelha com
+ * todas as antenas) so ignorados. As clulas so lidas do mapa por linha e coluna, por isso o
+ * resultado no depende do nmero de threads.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param opcoes --> Nmero de threads (NULL para as predefinies); semDuplicados no  usado,
+ *                   porque o mapa nunca tem clulas repetidas.
+ * @param guardarCelulas --> Se verdadeiro, preenche tambm a lista mapa->celulas.
+ * @param mapa --> Mapa a preencher (libertado com LibertarMapaInterferencias).
+ * @param calculo --> Dados partilhados pelas tarefas.
+ * @param celulasGrelha --> Nmero de clulas da grelha (bits do mapa).
+ * @param palavras --> Nmero de palavras de 64 bits do mapa.
+ * @param return --> Nmero de clulas afetadas, -9 se os argumentos forem nulos, -2 se falhar a alocao,
+ *                   -4 se uma coordenada no couber em Coordenada (COORDENADAS_16_BITS).
+ */
+long long CalcularMapaInterferencias(Grafo* grafo, const OpcoesInterferencias* opcoes, bool guardarCelulas, MapaInterferencias* mapa) {
+    if (!grafo || !mapa) return -9;
+    memset(mapa, 0, sizeof(MapaInterferencias));
+    int numThreads = opcoes ? opcoes->numThreads : 0;
+    if (numThreads <= 0) numThreads = NumeroProcessadores();
+
+    CalculoInterferencias calculo;
+    memset(&calculo, 0, sizeof(CalculoInterferencias));
+    int construidos = ConstruirVetoresAntenas(grafo, &calculo.vetores);
+    if (construidos != 0) return construidos;
+
+    //Sem as dimenses do ficheiro, o mapa  a menor grelha que contm todas as antenas
+    mapa->largura = grafo->largura;
+    mapa->altura = grafo->altura;
+    if (mapa->largura <= 0 || mapa->altura <= 0) {
+        mapa->largura = 0;
+        mapa->altura = 0;
+        for (int i = 0; i < calculo.vetores.total; i++) {
+            if (calculo.vetores.colunas[i] >= mapa->largura) mapa->largura = calculo.vetores.colunas[i] + 1;
+            if (calculo.vetores.linhas[i] >= mapa->altura) mapa->altura = calculo.vetores.linhas[i] + 1;
+        }
+    }
+
+    unsigned long long celulasGrelha = (unsigned long long)mapa->largura * (unsigned long long)mapa->altura;
+    unsigned long long palavras = (celulasGrelha + 63) / 64;
+    if (calculo.vetores.total == 0 || palavras == 0) {
+        LibertarVetoresAntenas(&calculo.vetores);
+        return 0;
+    }
+
+    long long resultado = 0;
+    if (palavras > SIZE_MAX / sizeof(uint64_t)) resultado = -2;
+    else {
+        mapa->bits = calloc((size_t)palavras, sizeof(uint64_t));
+        if (!mapa->bits) resultado = -2;
+    }
+    calculo.mapa = mapa->bits;
+    calculo.larguraMapa = mapa->largura;
+    calculo.alturaMapa = mapa->altura;
+
+    int numTarefas = 0;
+    if (resultado == 0) {
+        numTarefas = DividirTarefas(&calculo, numThreads, NULL);
+        calculo.tarefas = malloc(numTarefas * sizeof(TarefaInterferencia));
+        if (!calculo.tarefas) resultado = -2;
+    }
+    if (resultado == 0) {
+        DividirTarefas(&calculo, numThreads, calculo.tarefas);
+        if (ExecutarEmParalelo(numTarefas, numThreads, CalcularTarefa, &calculo) != 0) resultado = -2;
+    }
+
+    if (resultado == 0) {
+        for (int t = 0; t < numTarefas; t++) {
+            mapa->pontosCalculados += (long long)calculo.tarefas[t].totalPontos;
+            mapa->pontosFora += (long long)calculo.tarefas[t].pontosFora;
+        }
+        for (size_t w = 0; w < (size_t)palavras; w++) mapa->totalCelulas += ContarBits(mapa->bits[w]);
+    }
+
+    //A lista sai do mapa por ordem de bit, que  a ordem por linha e depois por coluna
+    if (resultado == 0 && guardarCelulas && mapa->totalCelulas > 0) {
+        if ((unsigned long long)mapa->totalCelulas > SIZE_MAX / (2 * sizeof(int))) resultado = -2;
+        else mapa->celulas = malloc((size_t)mapa->totalCelulas * 2 * sizeof(int));
+        if (!mapa->celulas) resultado = -2;
+
+        long long total = 0;
+        for (size_t w = 0; w < (size_t)palavras && resultado == 0; w++) {
+            for (int b = 0; b < 64 && (mapa->bits[w] >> b); b++) {
+                if (!((mapa->bits[w] >> b) & 1)) continue;
+                unsigned long long celula = (unsigned long long)w * 64 + (unsigned long long)b;
+                mapa->celulas[total * 2] = (int)(celula % (unsigned long long)mapa->largura);
+                mapa->celulas[total * 2 + 1] = (int)(celula / (unsigned long long)mapa->largura);
+                total++;
+            }
+        }
+    }
+
+    for (int t = 0; t < numTarefas && calculo.tarefas; t++) free(calculo.tarefas[t].alinhadas);
+    free(calculo.tarefas);
+    LibertarVetoresAntenas(&calculo.vetores);
+    if (resultado < 0) {
+        LibertarMapaInterferencias(mapa);
+        return resultado;
+    }
+    return mapa->totalCelulas;
+}
+
+/**
+ * Funo para saber se uma clula foi marcada por CalcularMapaInterferencias.
+ *
+ * @param mapa --> Mapa calculado.
+ * @param coluna, linha --> Clula a consultar.
+ * @param celula --> Posio do bit da clula no mapa.
+ * @param return --> Verdadeiro se a clula  afetada, falso se no , se estiver fora do mapa ou se o mapa for nulo.
+ */
+bool CelulaAfetada(const MapaInterferencias* mapa, int coluna, int linha) {
+    if (!mapa || !mapa->bits) return false;
+    if (coluna < 0 || coluna >= mapa->largura || linha < 0 || linha >= mapa->altura) return false;
+    size_t celula = (size_t)linha * (size_t)mapa->largura + (size_t)coluna;
+    return (mapa->bits[celula / 64] >> (celula % 64)) & 1;
+}
+
+/**
+ * Funo para escrever um mapa de interferncias: uma linha "largura altura clulas" seguida
+ * das clulas afetadas, uma "(x,y)" por linha, por linha e depois por coluna.
+ *
+ * @param mapa --> Mapa calculado.
+ * @param saida --> Ficheiro onde o mapa  escrito.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param celulasGrelha --> Nmero de clulas da grelha (bits do mapa).
+ * @param return --> 0 se o mapa foi escrito, -9 se os argumentos forem nulos, -3 se a escrita falhar.
+ */
+int EscreverMapaInterferencias(const MapaInterferencias* mapa, FILE* saida) {
+    if (!mapa || !saida) return -9;
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    EscreverInteiro(&escritor, mapa->largura);
+    EscreverCaracter(&escritor, ' ');
+    EscreverInteiro(&escritor, mapa->altura);
+    EscreverCaracter(&escritor, ' ');
+    EscreverInteiro(&escritor, mapa->totalCelulas);
+    EscreverCaracter(&escritor, '\n');
+
+    size_t celulasGrelha = mapa->bits ? (size_t)mapa->largura * (size_t)mapa->altura : 0;
+    for (size_t celula = 0; celula < celulasGrelha && escritor.erro == 0; celula++) {
+        uint64_t palavra = mapa->bits[celula / 64];
+        if (celula % 64 == 0 && palavra == 0) {
+            celula += 63;
+            continue;
+        }
+        if (!((palavra >> (celula % 64)) & 1)) continue;
+        EscreverCoordenada(&escritor, (int)(celula % (size_t)mapa->largura), (int)(celula / (size_t)mapa->largura));
+        EscreverCaracter(&escritor, '\n');
+    }
+    return DescarregarEscritor(&escritor) != 0 ? -3 : 0;
+}
+
+/**
+ * Funo para libertar um mapa calculado por CalcularMapaInterferencias.
+ *
+ * @param mapa --> Mapa a libertar (fica vazio).
+ * @param return --> 0, ou -9 se o apontador for nulo.
+ */
+int LibertarMapaInterferencias(MapaInterferencias* mapa) {
+    if (!mapa) return -9;
+    free(mapa->bits);
+    free(mapa->celulas);
+    memset(mapa, 0, sizeof(MapaInterferencias));
+    return 0;
+}
+#pragma endregion
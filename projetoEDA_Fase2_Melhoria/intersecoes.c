@@ -0,0 +1,420 @@
+/*****************************************************************//**
+ * \file   intersecoes.c
+ * \brief  Intersees (mesma linha ou coluna) entre antenas de frequncias diferentes.
+ *
+ * As antenas so ordenadas por (linha, frequncia, posio na lista) e por
+ * (coluna, frequncia, posio na lista). Assim, as antenas de uma frequncia
+ * numa linha ficam numa srie contgua e as de frequncia maior vm logo a
+ * seguir, o que permite enumerar cada interseo sem comparar pares que no
+ * se intersetam.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "antenas.h"
+
+#define FREQ(indice, i) ((unsigned char)(indice)->antenas[i]->frequencia)
+
+#pragma region OrdenarEixo
+/**
+ * Chave de ordenao de uma antena num eixo.
+ * @param grupo --> Linha ou coluna da antena.
+ * @param frequencia --> Frequncia da antena (sem sinal).
+ * @param indice --> Posio da antena na lista do grafo.
+ */
+typedef struct ChaveEixo {
+    int grupo;
+    int frequencia;
+    int indice;
+} ChaveEixo;
+
+static int CompararChaves(const void* a, const void* b) {
+    const ChaveEixo* ca = a;
+    const ChaveEixo* cb = b;
+    if (ca->grupo != cb->grupo) return (ca->grupo > cb->grupo) - (ca->grupo < cb->grupo);
+    if (ca->frequencia != cb->frequencia) return ca->frequencia - cb->frequencia;
+    return ca->indice - cb->indice;
+}
+
+/**
+ * Ordena as antenas por (grupo, frequncia, ndice) e preenche as sries e grupos do eixo.
+ */
+static int OrdenarEixo(const IndiceIntersecoes* indice, bool porLinha, EixoIntersecoes* eixo) {
+    int n = indice->totalAntenas;
+    int tamanho = n > 0 ? n : 1;
+    ChaveEixo* chaves = malloc(tamanho * sizeof(ChaveEixo));
+    eixo->ordem = malloc(tamanho * sizeof(int));
+    eixo->posicao = malloc(tamanho * sizeof(int));
+    eixo->inicioGrupo = malloc(tamanho * sizeof(int));
+    eixo->fimGrupo = malloc(tamanho * sizeof(int));
+    eixo->fimSerie = malloc(tamanho * sizeof(int));
+    if (!chaves || !eixo->ordem || !eixo->posicao || !eixo->inicioGrupo || !eixo->fimGrupo || !eixo->fimSerie) {
+        free(chaves);
+        return -2;
+    }
+
+    for (int i = 0; i < n; i++) {
+        chaves[i].grupo = porLinha ? indice->antenas[i]->linha : indice->antenas[i]->coluna;
+        chaves[i].frequencia = FREQ(indice, i);
+        chaves[i].indice = i;
+    }
+    qsort(chaves, n, sizeof(ChaveEixo), CompararChaves);
+
+    for (int p = 0; p < n; p++) {
+        eixo->ordem[p] = chaves[p].indice;
+        eixo->posicao[chaves[p].indice] = p;
+    }
+
+    //Percorre os grupos (mesma linha/coluna) e, dentro deles, as sries (mesma frequncia)
+    for (int inicio = 0; inicio < n; ) {
+        int fim = inicio;
+        while (fim < n && chaves[fim].grupo == chaves[inicio].grupo) fim++;
+        for (int serie = inicio; serie < fim; ) {
+            int fimSerie = serie;
+            while (fimSerie < fim && chaves[fimSerie].frequencia == chaves[serie].frequencia) fimSerie++;
+            for (int p = serie; p < fimSerie; p++) {
+                eixo->inicioGrupo[p] = inicio;
+                eixo->fimGrupo[p] = fim;
+                eixo->fimSerie[p] = fimSerie;
+            }
+            serie = fimSerie;
+        }
+        inicio = fim;
+    }
+
+    free(chaves);
+    return 0;
+}
+
+static void LibertarEixo(EixoIntersecoes* eixo) {
+    free(eixo->ordem);
+    free(eixo->posicao);
+    free(eixo->inicioGrupo);
+    free(eixo->fimGrupo);
+    free(eixo->fimSerie);
+    memset(eixo, 0, sizeof(EixoIntersecoes));
+}
+#pragma endregion
+
+#pragma region ConstruirIndiceIntersecoes
+/**
+ * Funo para preparar o ndice de intersees de um grafo.
+ * Fica vlido enquanto o grafo no for alterado.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param indice --> Apontador para o ndice a preencher.
+ * @param contagem --> Nmero de antenas de cada frequncia (para agrupar por frequncia).
+ * @param return --> 0 se o ndice foi construdo, -1 se os argumentos forem nulos, -2 se falhar a alocao.
+ */
+int ConstruirIndiceIntersecoes(Grafo* grafo, IndiceIntersecoes* indice) {
+    if (!grafo || !indice) return -1;
+    memset(indice, 0, sizeof(IndiceIntersecoes));
+
+    int n = 0;
+    for (Antena* a = grafo->antenas; a != NULL; a = a->proxima) n++;
+
+    indice->totalAntenas = n;
+    indice->antenas = malloc((n > 0 ? n : 1) * sizeof(Antena*));
+    indice->porFrequencia = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!indice->antenas || !indice->porFrequencia) {
+        LibertarIndiceIntersecoes(indice);
+        return -2;
+    }
+
+    int i = 0;
+    for (Antena* a = grafo->antenas; a != NULL; a = a->proxima) indice->antenas[i++] = a;
+
+    //Agrupa os ndices por frequncia, mantendo a ordem da lista dentro de cada frequncia
+    int contagem[NUM_FREQUENCIAS + 1] = { 0 };
+    for (i = 0; i < n; i++) contagem[FREQ(indice, i) + 1]++;
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) contagem[f + 1] += contagem[f];
+    memcpy(indice->inicioFrequencia, contagem, sizeof(contagem));
+    for (i = 0; i < n; i++) indice->porFrequencia[contagem[FREQ(indice, i)]++] = i;
+
+    if (OrdenarEixo(indice, true, &indice->linhas) != 0 || OrdenarEixo(indice, false, &indice->colunas) != 0) {
+        LibertarIndiceIntersecoes(indice);
+        return -2;
+    }
+    return 0;
+}
+#pragma endregion
+
+#pragma region LibertarIndiceIntersecoes
+/**
+ * Funo para libertar a memria de um ndice de intersees.
+ *
+ * @param indice --> Apontador para o ndice.
+ * @param return --> 0 se o ndice foi libertado, -1 se for nulo.
+ */
+int LibertarIndiceIntersecoes(IndiceIntersecoes* indice) {
+    if (!indice) return -1;
+    free(indice->antenas);
+    free(indice->porFrequencia);
+    LibertarEixo(&indice->linhas);
+    LibertarEixo(&indice->colunas);
+    memset(indice, 0, sizeof(IndiceIntersecoes));
+    return 0;
+}
+#pragma endregion
+
+#pragma region EscreverIntersecoesPar
+/**
+ * Visitante das intersees que escreve "fa(x,y) - fb(x,y)" no EscritorTexto passado em contexto.
+ *
+ * @param antenaA --> Antena da primeira frequncia.
+ * @param antenaB --> Antena da segunda frequncia.
+ * @param contexto --> Apontador para o EscritorTexto.
+ * @param return --> 0, ou o erro do escritor (para parar a procura se a escrita falhar).
+ */
+int EscreverIntersecao(const Antena* antenaA, const Antena* antenaB, void* contexto) {
+    EscritorTexto* escritor = contexto;
+    EscreverCaracter(escritor, antenaA->frequencia);
+    EscreverCoordenada(escritor, antenaA->coluna, antenaA->linha);
+    EscreverBytes(escritor, " - ", 3);
+    EscreverCaracter(escritor, antenaB->frequencia);
+    EscreverCoordenada(escritor, antenaB->coluna, antenaB->linha);
+    return EscreverCaracter(escritor, '\n');
+}
+
+/**
+ * Srie da frequncia freq no grupo da antena a (posies [*inicio, *fim) do eixo).
+ */
+static void SerieNoGrupo(const IndiceIntersecoes* indice, const EixoIntersecoes* eixo, int a, int freq, int* inicio, int* fim) {
+    int p = eixo->posicao[a];
+    int baixo = eixo->inicioGrupo[p], alto = eixo->fimGrupo[p];
+    //Primeira posio do grupo com frequncia >= freq
+    while (baixo < alto) {
+        int meio = baixo + (alto - baixo) / 2;
+        if (FREQ(indice, eixo->ordem[meio]) < freq) baixo = meio + 1;
+        else alto = meio;
+    }
+    *inicio = baixo;
+    *fim = baixo < eixo->fimGrupo[p] && FREQ(indice, eixo->ordem[baixo]) == freq ? eixo->fimSerie[baixo] : baixo;
+}
+
+/**
+ * Funo para percorrer as intersees entre as antenas de freqA e as de freqB.
+ * A ordem  a da lista do grafo: para cada antena de freqA, as antenas de freqB na mesma
+ * linha ou coluna. Cada antena de freqA custa uma procura binria no seu grupo, mais
+ * as intersees que encontra.
+ *
+ * @param indice --> Apontador para o ndice de intersees.
+ * @param freqA --> Frequncia das primeiras antenas.
+ * @param freqB --> Frequncia das segundas antenas.
+ * @param visitante --> Funo chamada para cada interseo; se devolver outro valor que no 0 a procura para.
+ * @param contexto --> Dados do chamador, passados ao visitante.
+ * @param l, fl --> Srie de freqB na linha da antena atual.
+ * @param c, fc --> Srie de freqB na coluna da antena atual.
+ * @param return --> Nmero de intersees visitadas, -1 se os argumentos forem nulos.
+ */
+int PercorrerIntersecoesPar(const IndiceIntersecoes* indice, char freqA, char freqB, VisitanteIntersecao visitante, void* contexto) {
+    if (!indice || !visitante) return -1;
+
+    int fa = (unsigned char)freqA, fb = (unsigned char)freqB;
+    int total = 0;
+    for (int k = indice->inicioFrequencia[fa]; k < indice->inicioFrequencia[fa + 1]; k++) {
+        int a = indice->porFrequencia[k];
+        int l, fl, c, fc;
+        SerieNoGrupo(indice, &indice->linhas, a, fb, &l, &fl);
+        SerieNoGrupo(indice, &indice->colunas, a, fb, &c, &fc);
+
+        //As duas sries esto ordenadas pela posio na lista: junta-as por essa ordem
+        while (l < fl || c < fc) {
+            int bl = l < fl ? indice->linhas.ordem[l] : indice->totalAntenas;
+            int bc = c < fc ? indice->colunas.ordem[c] : indice->totalAntenas;
+            int b;
+            if (bl <= bc) {
+                b = bl;
+                l++;
+                if (bl == bc) c++;
+            }
+            else {
+                b = bc;
+                c++;
+            }
+            if (b == a) continue;
+            total++;
+            if (visitante(indice->antenas[a], indice->antenas[b], contexto) != 0) return total;
+        }
+    }
+    return total;
+}
+
+/**
+ * Funo para escrever as intersees entre as antenas de freqA e as de freqB,
+ * pela ordem de PercorrerIntersecoesPar.
+ *
+ * @param indice --> Apontador para o ndice de intersees.
+ * @param freqA --> Frequncia das primeiras antenas.
+ * @param freqB --> Frequncia das segundas antenas.
+ * @param saida --> Apontador para o ficheiro onde as intersees sero escritas.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param return --> Nmero de intersees escritas, -1 se os argumentos forem nulos, -3 se a escrita falhar.
+ */
+int EscreverIntersecoesPar(const IndiceIntersecoes* indice, char freqA, char freqB, FILE* saida) {
+    if (!indice || !saida) return -1;
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    int total = PercorrerIntersecoesPar(indice, freqA, freqB, EscreverIntersecao, &escritor);
+    return DescarregarEscritor(&escritor) == 0 ? total : -3;
+}
+#pragma endregion
+
+#pragma region EscreverTodasIntersecoes
+/**
+ * Interseo encontrada entre uma antena de frequncia fa e uma de frequncia maior.
+ * @param frequencia --> Frequncia da segunda antena.
+ * @param a --> ndice da primeira antena.
+ * @param b --> ndice da segunda antena.
+ */
+typedef struct ParIntersecao {
+    int frequencia;
+    int a;
+    int b;
+} ParIntersecao;
+
+static int AcrescentarPar(ParIntersecao** pares, int* total, int* capacidade, int frequencia, int a, int b) {
+    if (*total == *capacidade) {
+        int novaCapacidade = *capacidade ? *capacidade * 2 : 256;
+        ParIntersecao* novos = realloc(*pares, novaCapacidade * sizeof(ParIntersecao));
+        if (!novos) return -2;
+        *pares = novos;
+        *capacidade = novaCapacidade;
+    }
+    ParIntersecao* par = &(*pares)[(*total)++];
+    par->frequencia = frequencia;
+    par->a = a;
+    par->b = b;
+    return 0;
+}
+
+/**
+ * Funo para percorrer todas as intersees entre antenas de frequncias diferentes.
+ * Cada par de frequncias (A,B)  escrito uma nica vez, com a frequncia menor primeiro,
+ * pela ordem crescente de A e depois de B; dentro de cada par a ordem  a de EscreverIntersecoesPar.
+ * Para cada antena s so visitadas, na sua linha e na sua coluna, as antenas de frequncia
+ * maior, que so todas intersees, por isso o trabalho  proporcional ao que  encontrado.
+ *
+ * @param indice --> Apontador para o ndice de intersees.
+ * @param visitante --> Funo chamada para cada interseo; se devolver outro valor que no 0 a procura para.
+ * @param contexto --> Dados do chamador, passados ao visitante.
+ * @param pares --> Intersees da frequncia atual, antes de serem agrupadas pela segunda frequncia.
+ * @param ordenados --> As mesmas intersees agrupadas pela segunda frequncia.
+ * @param contagem --> Incio de cada segunda frequncia em ordenados.
+ * @param return --> Nmero de intersees visitadas, -1 se os argumentos forem nulos, -2 se falhar a alocao.
+ */
+int PercorrerTodasIntersecoes(const IndiceIntersecoes* indice, VisitanteIntersecao visitante, void* contexto) {
+    if (!indice || !visitante) return -1;
+
+
+    ParIntersecao* pares = NULL;
+    ParIntersecao* ordenados = NULL;
+    int capacidade = 0, capacidadeOrdenados = 0;
+    int total = 0;
+    const EixoIntersecoes* linhas = &indice->linhas;
+    const EixoIntersecoes* colunas = &indice->colunas;
+
+    for (int fa = 0; fa < NUM_FREQUENCIAS; fa++) {
+        int totalPares = 0;
+
+        for (int k = indice->inicioFrequencia[fa]; k < indice->inicioFrequencia[fa + 1]; k++) {
+            int a = indice->porFrequencia[k];
+            int pl = linhas->posicao[a], pc = colunas->posicao[a];
+            //Depois da srie de fa vm, no mesmo grupo, as frequncias maiores
+            int l = linhas->fimSerie[pl], fl = linhas->fimGrupo[pl];
+            int c = colunas->fimSerie[pc], fc = colunas->fimGrupo[pc];
+
+            //Junta as duas partes por (frequncia, posio na lista)
+            while (l < fl || c < fc) {
+                int b, usarLinha;
+                if (l >= fl) usarLinha = 0;
+                else if (c >= fc) usarLinha = 1;
+                else {
+                    int bl = linhas->ordem[l], bc = colunas->ordem[c];
+                    int freqL = FREQ(indice, bl), freqC = FREQ(indice, bc);
+                    //A mesma antena s aparece nas duas partes se houver coordenadas repetidas
+                    if (bl == bc) c++;
+                    usarLinha = freqL < freqC || (freqL == freqC && bl <= bc);
+                }
+                b = usarLinha ? linhas->ordem[l++] : colunas->ordem[c++];
+                if (AcrescentarPar(&pares, &totalPares, &capacidade, FREQ(indice, b), a, b) != 0) {
+                    free(pares);
+                    free(ordenados);
+                    return -2;
+                }
+            }
+        }
+        if (totalPares == 0) continue;
+
+        //Agrupa pela segunda frequncia sem alterar a ordem dentro de cada grupo
+        if (totalPares > capacidadeOrdenados) {
+            ParIntersecao* novos = realloc(ordenados, totalPares * sizeof(ParIntersecao));
+            if (!novos) {
+                free(pares);
+                free(ordenados);
+                return -2;
+            }
+            ordenados = novos;
+            capacidadeOrdenados = totalPares;
+        }
+        int contagem[NUM_FREQUENCIAS + 1] = { 0 };
+        for (int i = 0; i < totalPares; i++) contagem[pares[i].frequencia + 1]++;
+        for (int f = 0; f < NUM_FREQUENCIAS; f++) contagem[f + 1] += contagem[f];
+        for (int i = 0; i < totalPares; i++) ordenados[contagem[pares[i].frequencia]++] = pares[i];
+
+        bool parar = false;
+        for (int i = 0; i < totalPares && !parar; i++) {
+            total++;
+            parar = visitante(indice->antenas[ordenados[i].a], indice->antenas[ordenados[i].b], contexto) != 0;
+        }
+        if (parar) break;
+    }
+
+    free(pares);
+    free(ordenados);
+    return total;
+}
+
+/**
+ * Funo para escrever todas as intersees entre antenas de frequncias diferentes,
+ * pela ordem de PercorrerTodasIntersecoes.
+ *
+ * @param indice --> Apontador para o ndice de intersees.
+ * @param saida --> Apontador para o ficheiro onde as intersees sero escritas.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param return --> Nmero de intersees escritas, -1 se os argumentos forem nulos, -2 se falhar a alocao,
+ *                   -3 se a escrita falhar.
+ */
+int EscreverTodasIntersecoes(const IndiceIntersecoes* indice, FILE* saida) {
+    if (!indice || !saida) return -1;
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    int total = PercorrerTodasIntersecoes(indice, EscreverIntersecao, &escritor);
+    int escrita = DescarregarEscritor(&escritor);
+    return total < 0 ? total : (escrita == 0 ? total : -3);
+}
+#pragma endregion
+
+#pragma region MostrarTodasIntersecoes
+/**
+ * Funo para mostrar todas as intersees de um grafo, cada par de frequncias uma s vez.
+ *
+ * @param grafo --> Apontador para o grafo.
+ * @param saida --> Apontador para o ficheiro onde as intersees sero escritas.
+ * @param indice --> ndice de intersees construdo para esta chamada.
+ * @param return --> 0 se as intersees foram mostradas, -8 se os argumentos forem nulos,
+ *                   -2 se falhar a alocao.
+ */
+int MostrarTodasIntersecoes(Grafo* grafo, FILE* saida) {
+    if (!grafo || !saida) return -8;
+
+    IndiceIntersecoes indice;
+    if (ConstruirIndiceIntersecoes(grafo, &indice) != 0) return -2;
+    int resultado = EscreverTodasIntersecoes(&indice, saida);
+    LibertarIndiceIntersecoes(&indice);
+    return resultado < 0 ? resultado : 0;
+}
+#pragma endregion
@@ -1,37 +1,531 @@
 /*****************************************************************//**
  * \file   main.c
  * \brief  Ficheiro principal do programa de anlise de antenas em um grafo.
- * 
+ *
+ * Sem argumentos l "antenas.txt" e escreve o relatrio completo em "resultado.txt".
+ * As opes escolhem os ficheiros, o formato, as anlises, o nmero de threads e a
+ * forma de carregar o grafo; no fim  mostrado (em stderr) o custo de cada fase.
+ *
  * \author Vitor Moreira 31553
  * \date   May 2025
  *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
 #include "antenas.h"
 
+//Nomes das anlises, pela posio do seu bit em AnaliseRelatorio
+static const char* const NOMES_ANALISES[NUM_ANALISES] = {
+    "antenas", "profundidade", "largura", "componentes", "caminhos", "intersecoes", "interferencias"
+};
+
+//Seco da exportao de cada anlise (-1 se a anlise s existe no relatrio de texto)
+static const int SECCOES_ANALISES[NUM_ANALISES] = {
+    SECCAO_ANTENAS, SECCAO_PROFUNDIDADE, SECCAO_LARGURA, -1, SECCAO_CAMINHOS, SECCAO_INTERSECOES, SECCAO_INTERFERENCIAS
+};
+
+/**
+ * Formas de carregar o grafo.
+ */
+typedef enum Carregador {
+    CARREGADOR_MAPEADO,
+    CARREGADOR_PARALELO,
+    CARREGADOR_BINARIO
+} Carregador;
+
+/**
+ * Posio de uma antena indicada na linha de comandos.
+ * @param indicada --> A opo foi dada.
+ * @param coluna --> Coluna (X).
+ * @param linha --> Linha (Y).
+ */
+typedef struct PosicaoIndicada {
+    bool indicada;
+    int coluna;
+    int linha;
+} PosicaoIndicada;
+
+/**
+ * Opes do programa.
+ * @param entrada --> Ficheiro de antenas (grelha de texto, ou grafo binrio com CARREGADOR_BINARIO).
+ * @param saida --> Ficheiro do relatrio (ou base dos nomes, se houver vrias seces exportadas).
+ * @param formato --> Formato da sada.
+ * @param analises --> Anlises a fazer (combinao de AnaliseRelatorio).
+ * @param numThreads --> Threads da leitura, das seces e das interferncias (0 para todos os processadores).
+ * @param carregador --> Forma de carregar o grafo.
+ * @param inicio, origem, destino --> Antenas das travessias e dos caminhos.
+ * @param pares --> Pares de frequncias das intersees (NULL para todos).
+ * @param semTempos --> No mostrar o custo das fases.
+ * @param trace --> Ficheiro onde exportar o trace da instrumentao (NULL para nenhum).
+ * @param mapa --> Ficheiro onde escrever o mapa das clulas afetadas por interferncias (NULL para nenhum).
+ */
+typedef struct OpcoesPrograma {
+    const char* entrada;
+    const char* saida;
+    FormatoExportacao formato;
+    unsigned int analises;
+    int numThreads;
+    Carregador carregador;
+    PosicaoIndicada inicio;
+    PosicaoIndicada origem;
+    PosicaoIndicada destino;
+    const char* pares;
+    bool semTempos;
+    const char* trace;
+    const char* mapa;
+} OpcoesPrograma;
+
+/**
+ * Custo das fases do programa.
+ * @param leitura --> Ler o ficheiro (grelha ou grafo binrio).
+ * @param adjacencias --> Inserir as antenas no grafo (lista, baldes de frequncia e ndice espacial).
+ * @param analises --> Custo de cada anlise, pela posio do seu bit em AnaliseRelatorio.
+ * @param escrita --> Juntar e escrever o relatrio.
+ * @param mapa --> Calcular e escrever o mapa de interferncias.
+ * @param total --> Programa inteiro.
+ */
+typedef struct TemposPrograma {
+    Medicao leitura;
+    Medicao adjacencias;
+    Medicao analises[NUM_ANALISES];
+    Medicao escrita;
+    Medicao mapa;
+    Medicao total;
+} TemposPrograma;
+
+#pragma region LerOpcoes
+static void MostrarUtilizacao(FILE* saida, const char* programa) {
+    fprintf(saida,
+        "Utilizacao: %s [opcoes] [entrada [saida]]\n"
+        "  -e, --entrada FICHEIRO   ficheiro de antenas (antenas.txt)\n"
+        "  -s, --saida FICHEIRO     ficheiro de resultados (resultado.txt)\n"
+        "  -f, --formato NOME       texto, csv, jsonl ou binario (texto); fora do texto,\n"
+        "                           cada analise vai para SAIDA_<analise>.<formato>\n"
+        "  -a, --analises LISTA     separadas por virgulas: antenas, profundidade, largura,\n"
+        "                           componentes, caminhos, intersecoes, interferencias, todas\n"
+        "                           (todas = o relatorio predefinido, sem as componentes)\n"
+        "  -t, --threads N          threads a usar (0 = todos os processadores)\n"
+        "  -c, --carregador NOME    mapeado, paralelo ou binario (paralelo); o grafo binario\n"
+        "                           e reconstruido em listas antes das analises\n"
+        "      --inicio X,Y         antena onde comecam as travessias\n"
+        "      --origem X,Y         origem dos caminhos\n"
+        "      --destino X,Y        destino dos caminhos\n"
+        "      --pares LISTA        pares de frequencias das intersecoes (ex.: ABAC)\n"
+        "  -q, --sem-tempos         nao mostrar o custo de cada fase\n"
+        "      --trace FICHEIRO     exportar as fases e os contadores em formato trace do Chrome\n"
+        "                           (so com o programa compilado com INSTRUMENTACAO)\n"
+        "      --mapa FICHEIRO      escrever as celulas da grelha afetadas por interferencias,\n"
+        "                           sem repetidas e sem as que ficam fora da grelha\n"
+        "  -h, --ajuda              mostrar esta ajuda\n",
+        programa);
+}
+
+/**
+ * L uma lista de anlises separadas por vrgulas.
+ * @param return --> 0, ou -1 se algum nome no for conhecido.
+ */
+static int LerAnalises(const char* texto, unsigned int* analises) {
+    *analises = 0;
+    while (*texto) {
+        size_t tamanho = strcspn(texto, ",");
+        bool conhecida = false;
+        if (tamanho == 5 && strncmp(texto, "todas", 5) == 0) {
+            *analises |= ANALISE_TODAS;
+            conhecida = true;
+        }
+        for (int a = 0; a < NUM_ANALISES && !conhecida; a++) {
+            if (strlen(NOMES_ANALISES[a]) == tamanho && strncmp(texto, NOMES_ANALISES[a], tamanho) == 0) {
+                *analises |= 1u << a;
+                conhecida = true;
+            }
+        }
+        if (!conhecida) return -1;
+        texto += tamanho;
+        if (*texto == ',') texto++;
+    }
+    return *analises != 0 ? 0 : -1;
+}
+
+/**
+ * L uma posio no formato "coluna,linha".
+ * @param return --> 0, ou -1 se o texto no for uma posio.
+ */
+static int LerPosicao(const char* texto, PosicaoIndicada* posicao) {
+    char resto;
+    if (sscanf(texto, "%d,%d%c", &posicao->coluna, &posicao->linha, &resto) != 2) return -1;
+    posicao->indicada = true;
+    return 0;
+}
+
+/**
+ * L as opes da linha de comandos.
+ *
+ * @param argc, argv --> Argumentos do programa.
+ * @param opcoes --> Opes a preencher (j com os valores por omisso).
+ * @param posicionais --> Nmero de argumentos sem opo j lidos (entrada e sada).
+ * @param valor --> Valor da opo atual.
+ * @param return --> 0 se as opes so vlidas, 1 se foi pedida a ajuda, -1 se houver um erro.
+ */
+static int LerOpcoes(int argc, char** argv, OpcoesPrograma* opcoes) {
+    int posicionais = 0;
+    for (int i = 1; i < argc; i++) {
+        const char* opcao = argv[i];
+        if (strcmp(opcao, "-h") == 0 || strcmp(opcao, "--ajuda") == 0) return 1;
+        if (strcmp(opcao, "-q") == 0 || strcmp(opcao, "--sem-tempos") == 0) {
+            opcoes->semTempos = true;
+            continue;
+        }
+        if (opcao[0] != '-') {
+            if (posicionais == 0) opcoes->entrada = opcao;
+            else if (posicionais == 1) opcoes->saida = opcao;
+            else return -1;
+            posicionais++;
+            continue;
+        }
+
+        //As restantes opes tm um valor
+        if (i + 1 >= argc) return -1;
+        const char* valor = argv[++i];
+        if (strcmp(opcao, "-e") == 0 || strcmp(opcao, "--entrada") == 0) opcoes->entrada = valor;
+        else if (strcmp(opcao, "-s") == 0 || strcmp(opcao, "--saida") == 0) opcoes->saida = valor;
+        else if (strcmp(opcao, "-f") == 0 || strcmp(opcao, "--formato") == 0) {
+            if (strcmp(valor, "texto") == 0) opcoes->formato = EXPORTAR_TEXTO;
+            else if (strcmp(valor, "csv") == 0) opcoes->formato = EXPORTAR_CSV;
+            else if (strcmp(valor, "jsonl") == 0) opcoes->formato = EXPORTAR_JSONL;
+            else if (strcmp(valor, "binario") == 0) opcoes->formato = EXPORTAR_BINARIO;
+            else return -1;
+        }
+        else if (strcmp(opcao, "-a") == 0 || strcmp(opcao, "--analises") == 0) {
+            if (LerAnalises(valor, &opcoes->analises) != 0) return -1;
+        }
+        else if (strcmp(opcao, "-t") == 0 || strcmp(opcao, "--threads") == 0) {
+            char* fim;
+            long threads = strtol(valor, &fim, 10);
+            if (*fim != '\0' || threads < 0 || threads > 1024) return -1;
+            opcoes->numThreads = (int)threads;
+        }
+        else if (strcmp(opcao, "-c") == 0 || strcmp(opcao, "--carregador") == 0) {
+            if (strcmp(valor, "mapeado") == 0) opcoes->carregador = CARREGADOR_MAPEADO;
+            else if (strcmp(valor, "paralelo") == 0) opcoes->carregador = CARREGADOR_PARALELO;
+            else if (strcmp(valor, "binario") == 0) opcoes->carregador = CARREGADOR_BINARIO;
+            else return -1;
+        }
+        else if (strcmp(opcao, "--inicio") == 0) {
+            if (LerPosicao(valor, &opcoes->inicio) != 0) return -1;
+        }
+        else if (strcmp(opcao, "--origem") == 0) {
+            if (LerPosicao(valor, &opcoes->origem) != 0) return -1;
+        }
+        else if (strcmp(opcao, "--destino") == 0) {
+            if (LerPosicao(valor, &opcoes->destino) != 0) return -1;
+        }
+        else if (strcmp(opcao, "--pares") == 0) {
+            if (strlen(valor) % 2 != 0) return -1;
+            opcoes->pares = valor;
+        }
+        else if (strcmp(opcao, "--trace") == 0) opcoes->trace = valor;
+        else if (strcmp(opcao, "--mapa") == 0) opcoes->mapa = valor;
+        else return -1;
+    }
+    return 0;
+}
+#pragma endregion
+
+#pragma region Carregar
+/**
+ * Carrega o grafo, medindo  parte a leitura do ficheiro e a insero das antenas no grafo
+ * (onde ficam as ligaes: baldes de frequncia e ndice espacial).
+ * As anlises do programa trabalham sobre as listas do Grafo e no sobre a cpia compacta,
+ * por isso o grafo binrio  mapeado e depois reconstrudo antena a antena (ReconstruirGrafo):
+ * poupa-se a leitura da grelha, mas no a criao das antenas e das ligaes. S as funes
+ * ...CSR (usadas pelo benchmark) trabalham diretamente sobre o ficheiro mapeado.
+ *
+ * @param opcoes --> Opes do programa.
+ * @param grafo --> Grafo a preencher (vazio).
+ * @param tempos --> Onde guardar o custo da leitura e da insero.
+ * @param lote --> Antenas lidas da grelha, por ordem de linha e coluna.
+ * @param estatisticas --> Estatsticas da leitura, de onde vm a largura e a altura da grelha.
+ * @param binario --> Grafo binrio aberto.
+ * @param return --> 0 se o grafo foi carregado, valor negativo caso contrrio.
+ */
+static int Carregar(const OpcoesPrograma* opcoes, Grafo* grafo, TemposPrograma* tempos) {
+    Medicao inicio;
+    int resultado = 0;
+
+    if (opcoes->carregador == CARREGADOR_BINARIO) {
+        GrafoBinario binario;
+        IniciarMedicao(&inicio);
+        ABRIR_SPAN(spanLeitura, "leitura");
+        resultado = AbrirGrafoBinario(opcoes->entrada, &binario, true);
+        FECHAR_SPAN(spanLeitura);
+        TerminarMedicao(&inicio, &tempos->leitura);
+        if (resultado != 0) return resultado;
+
+        IniciarMedicao(&inicio);
+        ABRIR_SPAN(spanAdjacencias, "adjacencias");
+        resultado = ReconstruirGrafo(&binario.csr, grafo);
+        FECHAR_SPAN(spanAdjacencias);
+        TerminarMedicao(&inicio, &tempos->adjacencias);
+        FecharGrafoBinario(&binario);
+        return resultado;
+    }
+
+    LoteAntenas lote = { NULL, 0, 0 };
+    EstatisticasCarregamento estatisticas;
+    int numThreads = opcoes->carregador == CARREGADOR_MAPEADO ? 1 : opcoes->numThreads;
+    IniciarMedicao(&inicio);
+    ABRIR_SPAN(spanLeitura, "leitura");
+    resultado = LerGrelhaAntenas(opcoes->entrada, numThreads, &lote, &estatisticas);
+    FECHAR_SPAN(spanLeitura);
+    TerminarMedicao(&inicio, &tempos->leitura);
+    if (resultado == 0 || resultado == -4) {
+        grafo->largura = estatisticas.largura;
+        grafo->altura = estatisticas.altura;
+    }
+
+    //A insero no grafo  sequencial, pela ordem do ficheiro (como em CarregarAntenasParalelo)
+    IniciarMedicao(&inicio);
+    ABRIR_SPAN(spanAdjacencias, "adjacencias");
+    for (int i = 0; i < lote.total && resultado == 0; i++) {
+        if (AdicionarAntena(grafo, lote.registos[i].frequencia, lote.registos[i].coluna, lote.registos[i].linha) != 0) {
+            resultado = -4;
+        }
+    }
+    FECHAR_SPAN(spanAdjacencias);
+    TerminarMedicao(&inicio, &tempos->adjacencias);
+    LibertarLote(&lote);
+    return resultado;
+}
+#pragma endregion
+
+#pragma region Exportar
+/**
+ * Nome do ficheiro de uma anlise exportada: a sada sem a extenso, seguida de
+ * "_<analise>.<formato>". Com uma s anlise  usado o nome da sada.
+ */
+static void NomeExportacao(const OpcoesPrograma* opcoes, int analise, bool varias, char* nome, size_t tamanho) {
+    static const char* const extensoes[] = { "", "txt", "csv", "jsonl", "bin" };
+    if (!varias) {
+        snprintf(nome, tamanho, "%s", opcoes->saida);
+        return;
+    }
+    const char* ponto = strrchr(opcoes->saida, '.');
+    const char* barra = strpbrk(ponto ? ponto : "", "/\\");
+    int base = ponto && !barra ? (int)(ponto - opcoes->saida) : (int)strlen(opcoes->saida);
+    snprintf(nome, tamanho, "%.*s_%s.%s", base, opcoes->saida, NOMES_ANALISES[analise], extensoes[opcoes->formato]);
+}
+
+/**
+ * Exporta cada anlise escolhida para o seu ficheiro (ExportarResultados), medindo cada uma.
+ * As componentes s existem no relatrio de texto e so ignoradas, com um aviso.
+ *
+ * @param opcoes --> Opes do programa.
+ * @param grafo --> Grafo carregado.
+ * @param relatorio --> Antenas e pares resolvidos (como no relatrio de texto).
+ * @param tempos --> Onde guardar o custo de cada anlise.
+ * @param exportacao --> Opes de ExportarResultados, com uma s seco de cada vez.
+ * @param return --> 0, ou o primeiro erro de ExportarResultados (-11 se um ficheiro no puder ser aberto).
+ */
+static int Exportar(const OpcoesPrograma* opcoes, Grafo* grafo, const OpcoesRelatorio* relatorio, TemposPrograma* tempos) {
+    int totalAnalises = 0;
+    for (int a = 0; a < NUM_ANALISES; a++) {
+        if ((opcoes->analises & (1u << a)) && SECCOES_ANALISES[a] >= 0) totalAnalises++;
+    }
+    if (opcoes->analises & ANALISE_COMPONENTES) {
+        fprintf(stderr, "aviso: as componentes so existem no formato texto\n");
+    }
+
+    OpcoesExportacao exportacao;
+    memset(&exportacao, 0, sizeof(OpcoesExportacao));
+    exportacao.interferencias = relatorio->interferencias;
+    exportacao.inicio = relatorio->inicio;
+    exportacao.origem = relatorio->origem;
+    exportacao.destino = relatorio->destino;
+    exportacao.paresFrequencias = relatorio->paresFrequencias;
+    int resultado = 0;
+    for (int a = 0; a < NUM_ANALISES && resultado == 0; a++) {
+        if (!(opcoes->analises & (1u << a)) || SECCOES_ANALISES[a] < 0) continue;
+
+        char nome[1024];
+        NomeExportacao(opcoes, a, totalAnalises > 1, nome, sizeof(nome));
+        FILE* saida = fopen(nome, "wb");
+        if (!saida) return -11;
+
+        Medicao inicio;
+        IniciarMedicao(&inicio);
+        ABRIR_SPAN(span, NOMES_ANALISES[a]);
+        DestinoExportacao* destino = &exportacao.seccoes[SECCOES_ANALISES[a]];
+        destino->formato = opcoes->formato;
+        destino->saida = saida;
+        resultado = ExportarResultados(grafo, &exportacao);
+        destino->formato = EXPORTAR_NADA;
+        if (fclose(saida) != 0 && resultado == 0) resultado = -3;
+        FECHAR_SPAN(span);
+        TerminarMedicao(&inicio, &tempos->analises[a]);
+    }
+    return resultado;
+}
+#pragma endregion
+
+#pragma region EscreverMapa
+/**
+ * Calcula o mapa de interferncias (CalcularMapaInterferencias) e escreve-o no ficheiro pedido.
+ *
+ * @param opcoes --> Opes do programa.
+ * @param grafo --> Grafo carregado.
+ * @param tempos --> Onde guardar o custo do mapa.
+ * @param mapa --> Clulas afetadas.
+ * @param return --> 0, -11 se o ficheiro no puder ser aberto, ou o erro do clculo ou da escrita.
+ */
+static int EscreverMapa(const OpcoesPrograma* opcoes, Grafo* grafo, TemposPrograma* tempos) {
+    Medicao inicio;
+    IniciarMedicao(&inicio);
+    ABRIR_SPAN(span, "mapa");
+
+    OpcoesInterferencias interferencias = { opcoes->numThreads, true };
+    MapaInterferencias mapa;
+    long long celulas = CalcularMapaInterferencias(grafo, &interferencias, false, &mapa);
+    int resultado = celulas < 0 ? (int)celulas : 0;
+    if (resultado == 0) {
+        FILE* saida = fopen(opcoes->mapa, "wb");
+        if (!saida) resultado = -11;
+        else {
+            resultado = EscreverMapaInterferencias(&mapa, saida);
+            if (fclose(saida) != 0 && resultado == 0) resultado = -3;
+        }
+    }
+    LibertarMapaInterferencias(&mapa);
+
+    FECHAR_SPAN(span);
+    TerminarMedicao(&inicio, &tempos->mapa);
+    return resultado;
+}
+#pragma endregion
+
+#pragma region MostrarTempos
+static void MostrarFase(const char* nome, const Medicao* fase) {
+    fprintf(stderr, "%-16s %12.3f", nome, fase->segundos * 1e3);
+    if (fase->segundosCPU >= 0) fprintf(stderr, " %12.3f", fase->segundosCPU * 1e3);
+    else fprintf(stderr, " %12s", "-");
+    fprintf(stderr, " %12.1f\n", fase->picoMemoria / (1024.0 * 1024.0));
+}
+
+/**
+ * Mostra em stderr o custo de cada fase: tempo de relgio, tempo de CPU e pico de memria,
+ * seguido dos contadores da instrumentao se o programa tiver sido compilado com ela.
+ */
+static void MostrarTempos(const OpcoesPrograma* opcoes, const Grafo* grafo, const TemposPrograma* tempos) {
+    fprintf(stderr, "%d antenas, %d threads\n", grafo->totalAntenas,
+        opcoes->numThreads > 0 ? opcoes->numThreads : NumeroProcessadores());
+    fprintf(stderr, "%-16s %12s %12s %12s\n", "fase", "relogio (ms)", "cpu (ms)", "pico (MiB)");
+    MostrarFase("leitura", &tempos->leitura);
+    MostrarFase("adjacencias", &tempos->adjacencias);
+    for (int a = 0; a < NUM_ANALISES; a++) {
+        if (opcoes->analises & (1u << a)) MostrarFase(NOMES_ANALISES[a], &tempos->analises[a]);
+    }
+    if (opcoes->formato == EXPORTAR_TEXTO) MostrarFase("escrita", &tempos->escrita);
+    if (opcoes->mapa) MostrarFase("mapa", &tempos->mapa);
+    MostrarFase("total", &tempos->total);
+
+    long long contadores[NUM_CONTADORES];
+    if (LerContadores(contadores) != 0) return;
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        fprintf(stderr, "%-22s %lld\n", NomeContador((ContadorInstrumentacao)c), contadores[c]);
+    }
+}
+#pragma endregion
+
 /**
  * Funo main do programa.
+ * @param opcoes --> Opes lidas da linha de comandos.
  * @param grafo --> Grafo contendo as antenas carregadas do ficheiro.
- * @param totalAntenas --> Total de antenas carregadas.
+ * @param tempos --> Custo de cada fase.
+ * @param relatorio --> Anlises e parmetros do relatrio de texto.
+ * @param estatisticas --> Custo de cada seco do relatrio de texto.
  * @param Resultados --> Funo que gera os resultados das anlises e os escreve em um ficheiro.
  * @param LibertarGrafo --> Funo que liberta a memria alocada para o grafo.
+ * @param return --> 0 se correu bem, 1 se o grafo no foi carregado ou os resultados falharam,
+ *                   2 se as opes forem invlidas.
  */
 #pragma region Main
-int main() {
+int main(int argc, char** argv) {
+    OpcoesPrograma opcoes = { "antenas.txt", "resultado.txt", EXPORTAR_TEXTO, ANALISE_TODAS, 0, CARREGADOR_PARALELO, { false, 0, 0 }, { false, 0, 0 }, { false, 0, 0 }, NULL, false, NULL, NULL };
+    int lidas = LerOpcoes(argc, argv, &opcoes);
+    if (lidas != 0) {
+        MostrarUtilizacao(lidas > 0 ? stdout : stderr, argv[0]);
+        return lidas > 0 ? 0 : 2;
+    }
+
+    TemposPrograma tempos;
+    memset(&tempos, 0, sizeof(TemposPrograma));
+    Medicao inicio;
+    IniciarMedicao(&inicio);
+
     // Carregar a rede de antenas do ficheiro
-    Grafo grafo = CarregarAntenasDoFicheiro("antenas.txt");
+    Grafo grafo = { 0 };
+    int resultado = Carregar(&opcoes, &grafo, &tempos);
 
     // Verificar se o carregamento foi bem sucedido
-    if (grafo.totalAntenas == 0) {
+    if (resultado != 0 || grafo.totalAntenas == 0) {
+        fprintf(stderr, "Nao foi possivel carregar antenas de %s (%d)\n", opcoes.entrada, resultado);
+        LibertarGrafo(&grafo);
         return 1;
     }
 
+    // Antenas indicadas nas opes
+    OpcoesRelatorio relatorio;
+    memset(&relatorio, 0, sizeof(OpcoesRelatorio));
+    relatorio.analises = opcoes.analises;
+    relatorio.paresFrequencias = opcoes.pares;
+    relatorio.numThreads = opcoes.numThreads;
+    relatorio.interferencias.numThreads = opcoes.numThreads;
+    const PosicaoIndicada* posicoes[] = { &opcoes.inicio, &opcoes.origem, &opcoes.destino };
+    Antena** antenas[] = { &relatorio.inicio, &relatorio.origem, &relatorio.destino };
+    for (int i = 0; i < 3; i++) {
+        if (!posicoes[i]->indicada) continue;
+        *antenas[i] = procurarAntena(&grafo, posicoes[i]->coluna, posicoes[i]->linha);
+        if (!*antenas[i]) {
+            fprintf(stderr, "Nao ha nenhuma antena em (%d,%d)\n", posicoes[i]->coluna, posicoes[i]->linha);
+            LibertarGrafo(&grafo);
+            return 2;
+        }
+    }
+
     // Exportar os resultados das anlises
-    if (!Resultados(grafo, "resultado.txt")) {
-        LibertarGrafo(&grafo);
-        return 1;
+    if (opcoes.formato == EXPORTAR_TEXTO) {
+        EstatisticasRelatorio estatisticas;
+        resultado = ResultadosOpcoes(&grafo, opcoes.saida, &relatorio, &estatisticas);
+        if (resultado == 0) {
+            memcpy(tempos.analises, estatisticas.seccoes, sizeof(tempos.analises));
+            tempos.escrita = estatisticas.escrita;
+        }
+    }
+    else {
+        resultado = Exportar(&opcoes, &grafo, &relatorio, &tempos);
+    }
+    if (resultado != 0) {
+        fprintf(stderr, "Nao foi possivel escrever os resultados em %s (%d)\n", opcoes.saida, resultado);
+    }
+
+    // Mapa das clulas afetadas por interferncias
+    if (resultado == 0 && opcoes.mapa) {
+        resultado = EscreverMapa(&opcoes, &grafo, &tempos);
+        if (resultado != 0) fprintf(stderr, "Nao foi possivel escrever o mapa em %s (%d)\n", opcoes.mapa, resultado);
+    }
+    TerminarMedicao(&inicio, &tempos.total);
+
+    if (resultado == 0 && !opcoes.semTempos) {
+        MostrarTempos(&opcoes, &grafo, &tempos);
+    }
+
+    // Trace da instrumentao (fases e contadores)
+    if (opcoes.trace && !InstrumentacaoAtiva()) {
+        fprintf(stderr, "aviso: o programa foi compilado sem INSTRUMENTACAO, o trace nao foi criado\n");
+    }
+    else if (opcoes.trace && ExportarTrace(opcoes.trace) != 0) {
+        fprintf(stderr, "Nao foi possivel escrever o trace em %s\n", opcoes.trace);
     }
 
     // Libertar a memria alocada
     LibertarGrafo(&grafo);
-    return 0;
+    return resultado == 0 ? 0 : 1;
 }
-#pragma endregion
\ No newline at end of file
+#pragma endregion
@@ -0,0 +1,110 @@
+/*****************************************************************//**
+ * \file   medicao.c
+ * \brief  Medio do custo das fases do programa: tempo de relgio, tempo de CPU e pico de memria.
+ *
+ * O tempo de CPU  o do processo inteiro (todas as threads, utilizador e sistema) e o
+ * pico de memria  o maior conjunto residente que o processo j teve, por isso uma
+ * fase  medida pela diferena entre duas medies (o pico fica o do fim da fase).
+ * Usa GetProcessTimes/GetProcessMemoryInfo no Windows e getrusage nas restantes plataformas.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "antenas.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+#pragma region TempoCPU
+/**
+ * Funo para obter o tempo de CPU gasto pelo processo at agora (utilizador e sistema).
+ *
+ * @param criacao, fim --> Instantes de criao e de fim do processo (no so usados).
+ * @param sistema, utilizador --> Tempos do processo, em unidades de 100 ns.
+ * @param uso --> Recursos usados pelo processo.
+ * @return Segundos de CPU, somados em todas as threads.
+ */
+double TempoCPU(void) {
+#ifdef _WIN32
+    FILETIME criacao, fim, sistema, utilizador;
+    if (!GetProcessTimes(GetCurrentProcess(), &criacao, &fim, &sistema, &utilizador)) return 0.0;
+    ULARGE_INTEGER s, u;
+    s.LowPart = sistema.dwLowDateTime;
+    s.HighPart = sistema.dwHighDateTime;
+    u.LowPart = utilizador.dwLowDateTime;
+    u.HighPart = utilizador.dwHighDateTime;
+    return (double)(s.QuadPart + u.QuadPart) / 1e7;
+#else
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) return 0.0;
+    return (double)(uso.ru_utime.tv_sec + uso.ru_stime.tv_sec) + (uso.ru_utime.tv_usec + uso.ru_stime.tv_usec) / 1e6;
+#endif
+}
+#pragma endregion
+
+#pragma region PicoMemoria
+/**
+ * Funo para obter o maior conjunto residente (memria fsica) que o processo j usou.
+ *
+ * @param contadores --> Contadores de memria do processo (Windows).
+ * @param uso --> Recursos usados pelo processo (ru_maxrss em KiB no Linux, em bytes no macOS).
+ * @return Pico de memria em bytes, 0 se no for possvel obt-lo.
+ */
+size_t PicoMemoria(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS contadores;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &contadores, sizeof(contadores))) return 0;
+    return contadores.PeakWorkingSetSize;
+#else
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) return 0;
+#ifdef __APPLE__
+    return (size_t)uso.ru_maxrss;
+#else
+    return (size_t)uso.ru_maxrss * 1024;
+#endif
+#endif
+}
+#pragma endregion
+
+#pragma region Medir
+/**
+ * Funo para registar o estado atual (relgio, CPU e pico de memria), para medir uma fase
+ * que comea agora.
+ *
+ * @param medicao --> Onde guardar a medio.
+ * @param return --> 0, -1 se for nulo.
+ */
+int IniciarMedicao(Medicao* medicao) {
+    if (!medicao) return -1;
+    medicao->segundos = TempoAtual();
+    medicao->segundosCPU = TempoCPU();
+    medicao->picoMemoria = PicoMemoria();
+    return 0;
+}
+
+/**
+ * Funo para obter o custo da fase que comeou em inicio e acaba agora: tempo de relgio e
+ * de CPU decorridos e o pico de memria no fim da fase.
+ *
+ * @param inicio --> Medio feita com IniciarMedicao no incio da fase.
+ * @param fase --> Onde guardar o custo da fase.
+ * @param return --> 0, -1 se os argumentos forem nulos.
+ */
+int TerminarMedicao(const Medicao* inicio, Medicao* fase) {
+    if (!inicio || !fase) return -1;
+    double segundos = TempoAtual() - inicio->segundos;
+    double segundosCPU = TempoCPU() - inicio->segundosCPU;
+    fase->segundos = segundos;
+    fase->segundosCPU = segundosCPU;
+    fase->picoMemoria = PicoMemoria();
+    return 0;
+}
+#pragma endregion
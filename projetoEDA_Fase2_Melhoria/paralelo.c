@@ -0,0 +1,189 @@
+/*****************************************************************//**
+ * \file   paralelo.c
+ * \brief  Execuo de tarefas independentes em vrias threads.
+ *
+ * Cada thread vai buscar o prximo ndice de tarefa a um contador partilhado,
+ * protegido por um mutex, at no haver mais tarefas. Usa as threads do Windows
+ * ou pthreads, conforme a plataforma.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "antenas.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+typedef CRITICAL_SECTION Mutex;
+#define IniciarMutex(m) InitializeCriticalSection(m)
+#define BloquearMutex(m) EnterCriticalSection(m)
+#define DesbloquearMutex(m) LeaveCriticalSection(m)
+#define DestruirMutex(m) DeleteCriticalSection(m)
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_mutex_t Mutex;
+#define IniciarMutex(m) pthread_mutex_init(m, NULL)
+#define BloquearMutex(m) pthread_mutex_lock(m)
+#define DesbloquearMutex(m) pthread_mutex_unlock(m)
+#define DestruirMutex(m) pthread_mutex_destroy(m)
+#endif
+
+#define MAX_THREADS 256
+
+//Pilha de cada thread criada. As tarefas guardam na pilha um EscritorTexto (TAMANHO_ESCRITOR
+//bytes) e os visitantes das procuras, por isso o tamanho  dado aqui em vez de depender do
+//valor por omisso de cada plataforma (1 MiB no Windows)
+#define TAMANHO_PILHA_THREAD (4 * 1024 * 1024)
+
+/**
+ * Estado partilhado pelas threads de uma execuo.
+ * @param tarefa --> Funo a executar para cada ndice.
+ * @param contexto --> Dados passados  funo.
+ * @param totalTarefas --> Nmero de tarefas.
+ * @param proxima --> Prximo ndice por entregar.
+ * @param erroIndice --> Menor ndice cuja tarefa falhou (totalTarefas se nenhuma falhou).
+ * @param erro --> Cdigo devolvido por essa tarefa.
+ * @param mutex --> Protege proxima, erroIndice e erro.
+ */
+typedef struct ExecucaoParalela {
+    TarefaParalela tarefa;
+    void* contexto;
+    int totalTarefas;
+    int proxima;
+    int erroIndice;
+    int erro;
+    Mutex mutex;
+} ExecucaoParalela;
+
+#pragma region NumeroProcessadores
+/**
+ * Funo para obter o nmero de processadores lgicos disponveis.
+ *
+ * @return Nmero de processadores (pelo menos 1).
+ */
+int NumeroProcessadores(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long total = sysconf(_SC_NPROCESSORS_ONLN);
+    return total > 0 ? (int)total : 1;
+#endif
+}
+#pragma endregion
+
+#pragma region Trabalhador
+/**
+ * Ciclo de cada thread: pede um ndice, executa a tarefa e regista a falha de menor ndice.
+ */
+static void Trabalhar(ExecucaoParalela* execucao) {
+    for (;;) {
+        BloquearMutex(&execucao->mutex);
+        int indice = execucao->proxima++;
+        DesbloquearMutex(&execucao->mutex);
+        if (indice >= execucao->totalTarefas) return;
+
+        int resultado = execucao->tarefa(indice, execucao->contexto);
+        if (resultado != 0) {
+            BloquearMutex(&execucao->mutex);
+            if (indice < execucao->erroIndice) {
+                execucao->erroIndice = indice;
+                execucao->erro = resultado;
+            }
+            DesbloquearMutex(&execucao->mutex);
+        }
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI ThreadTrabalhador(LPVOID argumento) {
+    Trabalhar(argumento);
+    return 0;
+}
+#else
+static void* ThreadTrabalhador(void* argumento) {
+    Trabalhar(argumento);
+    return NULL;
+}
+#endif
+#pragma endregion
+
+#pragma region ExecutarEmParalelo
+/**
+ * Funo para executar tarefa(0..totalTarefas-1) repartindo os ndices por vrias threads.
+ * A thread que chama tambm trabalha. Com numThreads <= 1 (ou uma s tarefa) tudo corre
+ * na thread atual, pela ordem dos ndices. As tarefas no podem depender umas das outras.
+ *
+ * @param totalTarefas --> Nmero de tarefas a executar.
+ * @param numThreads --> Nmero de threads a usar (0 ou negativo para usar todos os processadores).
+ * @param tarefa --> Funo chamada para cada ndice; devolve 0 se correr bem.
+ * @param contexto --> Dados passados a cada chamada.
+ * @param threads --> Threads criadas alm da atual.
+ * @param return --> 0 se todas as tarefas correram bem, -1 se os argumentos forem invlidos,
+ *                   ou o cdigo da tarefa de menor ndice que falhou.
+ */
+int ExecutarEmParalelo(int totalTarefas, int numThreads, TarefaParalela tarefa, void* contexto) {
+    if (!tarefa || totalTarefas < 0) return -1;
+    if (numThreads <= 0) numThreads = NumeroProcessadores();
+    if (numThreads > totalTarefas) numThreads = totalTarefas;
+    if (numThreads > MAX_THREADS) numThreads = MAX_THREADS;
+
+    //Caso sequencial: sem threads nem mutex
+    if (numThreads <= 1) {
+        for (int i = 0; i < totalTarefas; i++) {
+            int resultado = tarefa(i, contexto);
+            if (resultado != 0) return resultado;
+        }
+        return 0;
+    }
+
+    ExecucaoParalela execucao;
+    execucao.tarefa = tarefa;
+    execucao.contexto = contexto;
+    execucao.totalTarefas = totalTarefas;
+    execucao.proxima = 0;
+    execucao.erroIndice = totalTarefas;
+    execucao.erro = 0;
+    IniciarMutex(&execucao.mutex);
+
+#ifdef _WIN32
+    HANDLE threads[MAX_THREADS];
+#else
+    pthread_t threads[MAX_THREADS];
+    pthread_attr_t atributos;
+    bool comAtributos = pthread_attr_init(&atributos) == 0;
+    if (comAtributos) pthread_attr_setstacksize(&atributos, TAMANHO_PILHA_THREAD);
+#endif
+    int criadas = 0;
+    for (int i = 1; i < numThreads; i++) {
+#ifdef _WIN32
+        threads[criadas] = CreateThread(NULL, TAMANHO_PILHA_THREAD, ThreadTrabalhador, &execucao,
+            STACK_SIZE_PARAM_IS_A_RESERVATION, NULL);
+        if (threads[criadas] == NULL) break;
+#else
+        if (pthread_create(&threads[criadas], comAtributos ? &atributos : NULL, ThreadTrabalhador, &execucao) != 0) break;
+#endif
+        criadas++;
+    }
+#ifndef _WIN32
+    if (comAtributos) pthread_attr_destroy(&atributos);
+#endif
+
+    //Se alguma thread no puder ser criada, as restantes (e a atual) fazem o trabalho
+    Trabalhar(&execucao);
+
+    for (int i = 0; i < criadas; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+    }
+    DestruirMutex(&execucao.mutex);
+    return execucao.erro;
+}
+#pragma endregion
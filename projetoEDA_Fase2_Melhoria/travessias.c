@@ -0,0 +1,557 @@
+/*****************************************************************//**
+ * \file   travessias.c
+ * \brief  Travessias em profundidade e em largura com marcas de visita externas.
+ *
+ * As marcas ficam numa estrutura Visitados do chamador, indexada pelo id das
+ * antenas, e o grafo s  lido. Por isso vrias travessias (por exemplo em
+ * threads diferentes) podem correr ao mesmo tempo sobre o mesmo grafo, desde
+ * que cada uma use o seu Visitados e ningum altere o grafo entretanto.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include <limits.h>
+#include "antenas.h"
+
+#pragma region CriarVisitados
+/**
+ * Funo para preparar um conjunto de marcas de visita vazio.
+ *
+ * @param visitados --> Apontador para a estrutura a inicializar.
+ * @param capacidade --> Nmero de ids previsto (o vetor cresce em NovaTravessia se for preciso).
+ * @param return --> 0 se foi inicializado, -1 se os argumentos forem invlidos, -2 se falhar a alocao.
+ */
+int CriarVisitados(Visitados* visitados, int capacidade) {
+    if (!visitados || capacidade < 0) return -1;
+
+    visitados->marcas = NULL;
+    visitados->epoca = 0;
+    visitados->capacidade = 0;
+    if (capacidade == 0) return 0;
+
+    visitados->marcas = calloc(capacidade, sizeof(unsigned int));
+    if (!visitados->marcas) return -2;
+    visitados->capacidade = capacidade;
+    return 0;
+}
+#pragma endregion
+
+#pragma region NovaTravessia
+/**
+ * Funo para comear uma travessia nova: todas as antenas passam a no visitadas.
+ * Normalmente s incrementa a poca; o vetor s  limpo quando a poca d a volta
+ * e s  realocado se o grafo tiver mais ids do que a capacidade.
+ *
+ * @param visitados --> Apontador para as marcas de visita.
+ * @param grafo --> Grafo que vai ser percorrido.
+ * @param novasMarcas --> Vetor realocado com a capacidade de todos os ids do grafo.
+ * @param return --> 0 se a travessia pode comear, -1 se os argumentos forem nulos, -2 se falhar a alocao.
+ */
+int NovaTravessia(Visitados* visitados, const Grafo* grafo) {
+    if (!visitados || !grafo) return -1;
+
+    if (grafo->totalIds > visitados->capacidade) {
+        unsigned int* novasMarcas = realloc(visitados->marcas, grafo->totalIds * sizeof(unsigned int));
+        if (!novasMarcas) return -2;
+        memset(novasMarcas + visitados->capacidade, 0, (grafo->totalIds - visitados->capacidade) * sizeof(unsigned int));
+        visitados->marcas = novasMarcas;
+        visitados->capacidade = grafo->totalIds;
+    }
+
+    //Se a poca der a volta, as marcas antigas podiam coincidir com a nova
+    if (visitados->epoca == UINT_MAX) {
+        memset(visitados->marcas, 0, visitados->capacidade * sizeof(unsigned int));
+        visitados->epoca = 0;
+    }
+    visitados->epoca++;
+    return 0;
+}
+#pragma endregion
+
+#pragma region MarcarVisitada
+/**
+ * Funo para marcar uma antena como visitada na travessia atual.
+ *
+ * @param visitados --> Apontador para as marcas de visita.
+ * @param antena --> Antena a marcar.
+ * @param return --> Verdadeiro se a antena ainda no estava visitada, falso caso contrrio.
+ */
+bool MarcarVisitada(Visitados* visitados, const Antena* antena) {
+    if (visitados->marcas[antena->id] == visitados->epoca) return false;
+    visitados->marcas[antena->id] = visitados->epoca;
+    CONTAR(CONTADOR_ANTENAS_VISITADAS, 1);
+    return true;
+}
+#pragma endregion
+
+#pragma region LibertarVisitados
+/**
+ * Funo para libertar as marcas de visita.
+ *
+ * @param visitados --> Apontador para as marcas de visita.
+ * @param return --> 0 se foram libertadas, -1 se o apontador for nulo.
+ */
+int LibertarVisitados(Visitados* visitados) {
+    if (!visitados) return -1;
+
+    free(visitados->marcas);
+    visitados->marcas = NULL;
+    visitados->epoca = 0;
+    visitados->capacidade = 0;
+    return 0;
+}
+#pragma endregion
+
+#pragma region ProximoPorVisitar
+/**
+ * Devolve o prximo vizinho ainda no visitado do iterador e marca-o, ou NULL.
+ * Todas as antenas de um balde percorrem o mesmo vetor e as marcas de uma travessia
+ * s so acrescentadas, por isso o que est antes da posio de qualquer iterador no
+ * balde j foi visitado. cursores[f] guarda o maior desses prefixos da frequncia f e
+ * os iteradores saltam diretamente para ele: a ordem  a mesma, mas um balde de k
+ * antenas custa O(k) na travessia inteira em vez de O(k^2).
+ */
+static Antena* ProximoPorVisitar(IteradorVizinhos* it, Visitados* visitados, int* cursores) {
+    int* cursor = &cursores[(unsigned char)it->origem->frequencia];
+    for (;;) {
+        if (!it->adj && it->indice < *cursor) it->indice = *cursor;
+        Antena* vizinho = ProximoVizinho(it);
+        if (it->indice > *cursor) *cursor = it->indice;
+        if (!vizinho || MarcarVisitada(visitados, vizinho)) return vizinho;
+    }
+}
+#pragma endregion
+
+#pragma region PercorrerEmProfundidade
+/**
+ * Pilha da travessia em profundidade: um iterador de vizinhos por antena do ramo atual.
+ * Cresce para o dobro quando fica cheia, por isso a profundidade no est limitada
+ * pela pilha de execuo.
+ */
+typedef struct PilhaVizinhos {
+    IteradorVizinhos* itens;
+    int total;
+    int capacidade;
+} PilhaVizinhos;
+
+static int EmpilharAntena(PilhaVizinhos* pilha, const Grafo* grafo, Antena* antena) {
+    if (pilha->total == pilha->capacidade) {
+        int novaCapacidade = pilha->capacidade ? pilha->capacidade * 2 : 64;
+        IteradorVizinhos* novos = realloc(pilha->itens, novaCapacidade * sizeof(IteradorVizinhos));
+        if (!novos) return -2;
+        pilha->itens = novos;
+        pilha->capacidade = novaCapacidade;
+    }
+    IniciarVizinhos(grafo, antena, &pilha->itens[pilha->total++]);
+    return 0;
+}
+
+/**
+ * Funo para percorrer em profundidade as antenas alcanveis a partir de inicio,
+ * chamando visitante para cada antena pela primeira vez que  encontrada.
+ * A ordem  a da antiga verso recursiva de TravessiaEmProfundidade (cada antena 
+ * visitada antes dos seus vizinhos, e estes pela ordem de IteradorVizinhos), mas com
+ * uma pilha explcita. Comea uma travessia nova em visitados.
+ *
+ * @param grafo --> Grafo a percorrer (s  lido).
+ * @param inicio --> Antena onde a travessia comea.
+ * @param visitados --> Marcas de visita do chamador.
+ * @param visitante --> Funo chamada para cada antena, com a profundidade no ramo (0 em inicio).
+ * @param contexto --> Dados passados ao visitante.
+ * @param pilha --> Iteradores das antenas do ramo atual, da origem at  mais funda.
+ * @param return --> 0 se a travessia foi feita (ou o visitante a parou), -3 se os argumentos
+ *                   forem nulos, -2 se falhar a alocao.
+ */
+int PercorrerEmProfundidadeVisitante(const Grafo* grafo, Antena* inicio, Visitados* visitados, VisitanteAntena visitante, void* contexto) {
+    if (!grafo || !inicio || !visitados || !visitante) return -3;
+    if (NovaTravessia(visitados, grafo) != 0) return -2;
+
+    PilhaVizinhos pilha = { NULL, 0, 0 };
+    int cursores[NUM_FREQUENCIAS] = { 0 };
+    int resultado = 0;
+
+    MarcarVisitada(visitados, inicio);
+    if (visitante(inicio, 0, contexto) != 0) return 0;
+    if (EmpilharAntena(&pilha, grafo, inicio) != 0) return -2;
+
+    while (pilha.total > 0) {
+        Antena* vizinho = ProximoPorVisitar(&pilha.itens[pilha.total - 1], visitados, cursores);
+        //Sem mais vizinhos por visitar: volta  antena anterior do ramo
+        if (!vizinho) {
+            pilha.total--;
+            continue;
+        }
+
+        if (visitante(vizinho, pilha.total, contexto) != 0) break;
+        if (EmpilharAntena(&pilha, grafo, vizinho) != 0) {
+            resultado = -2;
+            break;
+        }
+    }
+
+    free(pilha.itens);
+    return resultado;
+}
+
+/**
+ * Visitante das travessias que escreve "Antena f @ (x,y)" no EscritorTexto passado em contexto.
+ *
+ * @param antena --> Antena visitada.
+ * @param profundidade --> No  usada.
+ * @param contexto --> Apontador para o EscritorTexto.
+ * @param return --> 0, ou o erro do escritor (para parar a travessia se a escrita falhar).
+ */
+int EscreverAntenaVisitada(Antena* antena, int profundidade, void* contexto) {
+    (void)profundidade;
+    EscritorTexto* escritor = contexto;
+    EscreverBytes(escritor, "Antena ", 7);
+    EscreverCaracter(escritor, antena->frequencia);
+    EscreverBytes(escritor, " @ ", 3);
+    EscreverCoordenada(escritor, antena->coluna, antena->linha);
+    return EscreverCaracter(escritor, '\n');
+}
+
+/**
+ * Funo para percorrer em profundidade as antenas alcanveis a partir de inicio,
+ * pela mesma ordem de TravessiaEmProfundidade, escrevendo cada antena em saida.
+ *
+ * @param grafo --> Grafo a percorrer (s  lido).
+ * @param inicio --> Antena onde a travessia comea.
+ * @param visitados --> Marcas de visita do chamador.
+ * @param saida --> Ficheiro onde as antenas visitadas so escritas.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param return --> 0 se a travessia foi feita, -3 se os argumentos forem nulos ou a escrita falhar,
+ *                   -2 se falhar a alocao.
+ */
+int PercorrerEmProfundidade(const Grafo* grafo, Antena* inicio, Visitados* visitados, FILE* saida) {
+    if (!saida) return -3;
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    int resultado = PercorrerEmProfundidadeVisitante(grafo, inicio, visitados, EscreverAntenaVisitada, &escritor);
+    int escrita = DescarregarEscritor(&escritor);
+    return resultado != 0 ? resultado : escrita;
+}
+#pragma endregion
+
+#pragma region PercorrerEmLargura
+/**
+ * Funo para percorrer em largura as antenas alcanveis a partir de inicio,
+ * pela mesma ordem de TravessiaEmLargura, chamando visitante para cada antena
+ * (com o seu nvel na procura). Se o visitante devolver um valor diferente de 0
+ * a travessia para.
+ * A fila  um vetor de antenas com uma posio por id, porque cada antena entra
+ * na fila no mximo uma vez; no usa a arena do grafo.
+ *
+ * @param grafo --> Grafo a percorrer (s  lido).
+ * @param inicio --> Antena onde a travessia comea.
+ * @param visitados --> Marcas de visita do chamador.
+ * @param visitante --> Funo chamada para cada antena, pela ordem da travessia.
+ * @param contexto --> Dados do chamador, passados ao visitante.
+ * @param fila --> Antenas por visitar, entre frente e tras.
+ * @param niveis --> Nvel de cada antena da fila.
+ * @param return --> 0 se a travessia foi feita, -4 se os argumentos forem nulos, -5 se falhar a alocao.
+ */
+int PercorrerEmLarguraVisitante(const Grafo* grafo, Antena* inicio, Visitados* visitados, VisitanteAntena visitante, void* contexto) {
+    if (!grafo || !inicio || !visitados || !visitante) return -4;
+    if (NovaTravessia(visitados, grafo) != 0) return -5;
+
+    Antena** fila = malloc(grafo->totalIds * sizeof(Antena*));
+    int* niveis = malloc(grafo->totalIds * sizeof(int));
+    if (!fila || !niveis) {
+        free(fila);
+        free(niveis);
+        return -5;
+    }
+
+    int cursores[NUM_FREQUENCIAS] = { 0 };
+    int frente = 0, tras = 0;
+    MarcarVisitada(visitados, inicio);
+    niveis[tras] = 0;
+    fila[tras++] = inicio;
+
+    while (frente < tras) {
+        int nivel = niveis[frente];
+        Antena* atual = fila[frente++];
+        if (visitante(atual, nivel, contexto) != 0) break;
+
+        IteradorVizinhos it;
+        IniciarVizinhos(grafo, atual, &it);
+        for (Antena* vizinho = ProximoPorVisitar(&it, visitados, cursores); vizinho != NULL; vizinho = ProximoPorVisitar(&it, visitados, cursores)) {
+            niveis[tras] = nivel + 1;
+            fila[tras++] = vizinho;
+        }
+    }
+
+    free(fila);
+    free(niveis);
+    return 0;
+}
+
+/**
+ * Funo para percorrer em largura as antenas alcanveis a partir de inicio,
+ * pela mesma ordem de TravessiaEmLargura, escrevendo cada antena em saida.
+ *
+ * @param grafo --> Grafo a percorrer (s  lido).
+ * @param inicio --> Antena onde a travessia comea.
+ * @param visitados --> Marcas de visita do chamador.
+ * @param saida --> Ficheiro onde as antenas visitadas so escritas.
+ * @param escritor --> Escritor com buffer para saida.
+ * @param return --> 0 se a travessia foi feita, -4 se os argumentos forem nulos, -5 se falhar a alocao,
+ *                   -3 se a escrita falhar.
+ */
+int PercorrerEmLargura(const Grafo* grafo, Antena* inicio, Visitados* visitados, FILE* saida) {
+    if (!saida) return -4;
+
+    EscritorTexto escritor;
+    IniciarEscritor(&escritor, saida);
+    int resultado = PercorrerEmLarguraVisitante(grafo, inicio, visitados, EscreverAntenaVisitada, &escritor);
+    int escrita = DescarregarEscritor(&escritor);
+    return resultado != 0 ? resultado : escrita;
+}
+#pragma endregion
+
+#pragma region NiveisEmLargura
+//Heurstica de Beamer et al.: passa a ascendente quando as ligaes da fronteira passam
+//de 1/ALFA das ligaes por visitar e volta a descendente quando a fronteira tem menos
+//de 1/BETA das antenas
+#define ALFA_DIRECAO 14
+#define BETA_DIRECAO 24
+
+/**
+ * Estado de uma procura em largura por nveis.
+ * @param fila --> Antenas pela ordem em que foram encontradas; a fronteira atual 
+ *                 fila[inicioFronteira..fimFronteira-1] e as novas entram a partir de tras.
+ * @param baldeExpandido --> Frequncias cujo balde j foi todo encontrado.
+ * @param inicioEntradas --> Ligaes explcitas invertidas (s no modo com mudana de direo):
+ *                           as antenas com ligao para w esto em entradas[inicioEntradas[w]..inicioEntradas[w+1]-1].
+ * @param grauSaida --> Nmero de ligaes explcitas que saem de cada antena.
+ * @param porVisitar --> Antenas ainda sem nvel, percorridas nos passos ascendentes.
+ * @param arestasFronteira --> Ligaes explcitas que saem da fronteira atual.
+ * @param arestasPorVisitar --> Ligaes explcitas que chegam a antenas ainda sem nvel.
+ */
+typedef struct ProcuraNiveis {
+    const Grafo* grafo;
+    int* nivel;
+    int* pai;
+    int* fila;
+    int inicioFronteira;
+    int fimFronteira;
+    int tras;
+    bool baldeExpandido[NUM_FREQUENCIAS];
+    int* inicioEntradas;
+    int* entradas;
+    int* grauSaida;
+    int* porVisitar;
+    int totalPorVisitar;
+    long long arestasFronteira;
+    long long arestasPorVisitar;
+} ProcuraNiveis;
+
+static void Descobrir(ProcuraNiveis* p, int w, int v) {
+    p->nivel[w] = p->nivel[v] + 1;
+    p->pai[w] = v;
+    p->fila[p->tras++] = w;
+    if (p->grauSaida) {
+        p->arestasFronteira += p->grauSaida[w];
+        p->arestasPorVisitar -= p->inicioEntradas[w + 1] - p->inicioEntradas[w];
+    }
+}
+
+/**
+ * Encontra todas as antenas do balde da frequncia f ainda sem nvel, com pai v.
+ * Todas as antenas da frequncia so vizinhas das do balde, por isso o balde s
+ * precisa de ser percorrido uma vez, seja qual for a direo do passo.
+ */
+static void ExpandirBalde(ProcuraNiveis* p, int f, int v) {
+    if (!p->grafo->baldes || p->baldeExpandido[f]) return;
+    p->baldeExpandido[f] = true;
+    BaldeFrequencia* balde = &p->grafo->baldes[f];
+    for (int i = 0; i < balde->total; i++) {
+        int w = balde->antenas[i]->id;
+        if (p->nivel[w] == -1) Descobrir(p, w, v);
+    }
+}
+
+/**
+ * Passo descendente: cada antena da fronteira percorre as suas ligaes.
+ */
+static void PassoDescendente(ProcuraNiveis* p) {
+    for (int i = p->inicioFronteira; i < p->fimFronteira; i++) {
+        int v = p->fila[i];
+        Antena* antena = p->grafo->porId[v];
+        for (Adjacencia* adj = antena->ligacoes; adj != NULL; adj = adj->proxima) {
+            int w = adj->destino->id;
+            if (p->nivel[w] == -1) Descobrir(p, w, v);
+        }
+        ExpandirBalde(p, (unsigned char)antena->frequencia, v);
+    }
+}
+
+/**
+ * Passo ascendente: cada antena ainda sem nvel procura nas ligaes que chegam a ela
+ * uma antena da fronteira e pra na primeira. As antenas encontradas saem de porVisitar.
+ */
+static void PassoAscendente(ProcuraNiveis* p) {
+    int primeiraNaFronteira[NUM_FREQUENCIAS];
+    memset(primeiraNaFronteira, -1, sizeof(primeiraNaFronteira));
+    for (int i = p->inicioFronteira; i < p->fimFronteira; i++) {
+        int f = (unsigned char)p->grafo->porId[p->fila[i]]->frequencia;
+        if (primeiraNaFronteira[f] == -1) primeiraNaFronteira[f] = p->fila[i];
+    }
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) {
+        if (primeiraNaFronteira[f] != -1) ExpandirBalde(p, f, primeiraNaFronteira[f]);
+    }
+
+    int nivelFronteira = p->nivel[p->fila[p->inicioFronteira]];
+    int restantes = 0;
+    for (int i = 0; i < p->totalPorVisitar; i++) {
+        int v = p->porVisitar[i];
+        if (p->nivel[v] != -1) continue;
+        for (int k = p->inicioEntradas[v]; k < p->inicioEntradas[v + 1]; k++) {
+            int u = p->entradas[k];
+            if (p->nivel[u] == nivelFronteira) {
+                Descobrir(p, v, u);
+                break;
+            }
+        }
+        if (p->nivel[v] == -1) p->porVisitar[restantes++] = v;
+    }
+    p->totalPorVisitar = restantes;
+}
+
+/**
+ * Prepara o modo com mudana de direo: inverte as ligaes explcitas e conta os graus.
+ * Devolve 1 se no houver ligaes explcitas (os dois passos seriam iguais), 0 se
+ * preparou, -2 se falhar a alocao.
+ */
+static int PrepararAscendente(ProcuraNiveis* p) {
+    const Grafo* grafo = p->grafo;
+    int n = grafo->totalIds;
+    int totalEntradas = 0;
+    for (int v = 0; v < n; v++) {
+        if (!grafo->porId[v]) continue;
+        for (Adjacencia* adj = grafo->porId[v]->ligacoes; adj != NULL; adj = adj->proxima) totalEntradas++;
+    }
+    if (totalEntradas == 0) return 1;
+
+    p->inicioEntradas = calloc(n + 1, sizeof(int));
+    p->entradas = malloc(totalEntradas * sizeof(int));
+    p->grauSaida = calloc(n, sizeof(int));
+    p->porVisitar = malloc(n * sizeof(int));
+    if (!p->inicioEntradas || !p->entradas || !p->grauSaida || !p->porVisitar) return -2;
+
+    for (int v = 0; v < n; v++) {
+        if (!grafo->porId[v]) continue;
+        for (Adjacencia* adj = grafo->porId[v]->ligacoes; adj != NULL; adj = adj->proxima) {
+            p->inicioEntradas[adj->destino->id + 1]++;
+            p->grauSaida[v]++;
+        }
+        if (p->nivel[v] == -1) p->porVisitar[p->totalPorVisitar++] = v;
+    }
+    for (int v = 0; v < n; v++) p->inicioEntradas[v + 1] += p->inicioEntradas[v];
+
+    //Preenche as entradas avanando uma cpia dos incios (pai ainda no est em uso)
+    int* posicao = p->pai;
+    memcpy(posicao, p->inicioEntradas, n * sizeof(int));
+    for (int v = 0; v < n; v++) {
+        if (!grafo->porId[v]) continue;
+        for (Adjacencia* adj = grafo->porId[v]->ligacoes; adj != NULL; adj = adj->proxima) {
+            p->entradas[posicao[adj->destino->id]++] = v;
+        }
+    }
+    p->arestasPorVisitar = totalEntradas;
+    return 0;
+}
+
+/**
+ * Funo para calcular, numa procura em largura a partir de inicio, o nvel (nmero
+ * mnimo de ligaes desde inicio) e o pai de cada antena alcanvel.
+ * No modo LARGURA_DIRECAO_OTIMIZADA cada nvel  feito de cima para baixo (a fronteira
+ * percorre as suas ligaes) ou de baixo para cima (as antenas por visitar procuram um
+ * pai na fronteira), conforme o que for mais barato. Os baldes de frequncia so sempre
+ * percorridos uma s vez, por isso as ligaes entre antenas da mesma frequncia custam
+ * O(antenas) em qualquer dos modos; a mudana de direo poupa trabalho nas ligaes
+ * explcitas. Os nveis so os mesmos nos dois modos; os pais podem ser diferentes.
+ * S l o grafo, por isso pode correr em vrias threads ao mesmo tempo.
+ *
+ * @param grafo --> Grafo a percorrer.
+ * @param inicio --> Antena onde a procura comea.
+ * @param modo --> LARGURA_DESCENDENTE ou LARGURA_DIRECAO_OTIMIZADA.
+ * @param nivel --> Vetor com grafo->totalIds posies, indexado pelo id; fica -1 nas antenas no alcanadas.
+ * @param pai --> Vetor com grafo->totalIds posies; fica com o id do pai de cada antena (-1 em inicio e nas no alcanadas).
+ * @param resultado --> Nmero de antenas e de nveis alcanados e de passos em cada direo (pode ser NULL).
+ * @param return --> 0 se a procura foi feita, -4 se os argumentos forem invlidos, -5 se falhar a alocao.
+ */
+int NiveisEmLargura(const Grafo* grafo, Antena* inicio, ModoLargura modo, int* nivel, int* pai, ResultadoLargura* resultado) {
+    if (!grafo || !inicio || !nivel || !pai) return -4;
+    if (inicio->id < 0 || inicio->id >= grafo->totalIds || grafo->porId[inicio->id] != inicio) return -4;
+
+    int n = grafo->totalIds;
+    ProcuraNiveis p;
+    memset(&p, 0, sizeof(ProcuraNiveis));
+    p.grafo = grafo;
+    p.nivel = nivel;
+    p.pai = pai;
+    p.fila = malloc(n * sizeof(int));
+    if (!p.fila) return -5;
+
+    for (int v = 0; v < n; v++) nivel[v] = -1;
+    nivel[inicio->id] = 0;
+
+    int estado = 0;
+    bool comDirecao = false;
+    if (modo == LARGURA_DIRECAO_OTIMIZADA) {
+        estado = PrepararAscendente(&p);
+        comDirecao = estado == 0;
+        if (estado == 1) estado = 0;
+    }
+    if (estado == 0) {
+        for (int v = 0; v < n; v++) pai[v] = -1;
+        p.fila[p.tras++] = inicio->id;
+        if (comDirecao) {
+            p.arestasFronteira = p.grauSaida[inicio->id];
+            p.arestasPorVisitar -= p.inicioEntradas[inicio->id + 1] - p.inicioEntradas[inicio->id];
+        }
+
+        int totalNiveis = 0;
+        bool ascendente = false;
+        ResultadoLargura contagem = { 0, 0, 0, 0 };
+        while (p.fimFronteira < p.tras) {
+            p.inicioFronteira = p.fimFronteira;
+            p.fimFronteira = p.tras;
+            totalNiveis++;
+
+            if (comDirecao) {
+                int tamanhoFronteira = p.fimFronteira - p.inicioFronteira;
+                if (!ascendente && p.arestasFronteira > p.arestasPorVisitar / ALFA_DIRECAO) ascendente = true;
+                else if (ascendente && tamanhoFronteira < n / BETA_DIRECAO) ascendente = false;
+            }
+            p.arestasFronteira = 0;
+            if (ascendente) {
+                PassoAscendente(&p);
+                contagem.passosAscendentes++;
+            }
+            else {
+                PassoDescendente(&p);
+                contagem.passosDescendentes++;
+            }
+        }
+
+        contagem.alcancadas = p.tras;
+        contagem.totalNiveis = totalNiveis;
+        if (resultado) *resultado = contagem;
+    }
+    else {
+        estado = -5;
+    }
+
+    free(p.fila);
+    free(p.inicioEntradas);
+    free(p.entradas);
+    free(p.grauSaida);
+    free(p.porVisitar);
+    return estado;
+}
+#pragma endregion
@@ -0,0 +1,211 @@
+/*****************************************************************//**
+ * \file   vetoresantenas.c
+ * \brief  Antenas guardadas por campos (frequncias, colunas, linhas) e testes de alinhamento em blocos.
+ *
+ * Os ciclos que comparam uma antena com todas as da mesma frequncia s precisam das
+ * coordenadas; com um vetor de colunas e outro de linhas, cada comparao l 2 * sizeof(Coordenada)
+ * bytes em vez de um n inteiro da lista. AntenasAlinhadas compara uma antena com um bloco de
+ * antenas de cada vez usando instrues vetoriais: AVX2 se o compilador as tiver ativas
+ * (-mavx2, ou /arch:AVX2 no Visual Studio), SSE2 em qualquer x86-64 e, nas restantes
+ * plataformas, o mesmo teste escalar. O resultado  sempre o mesmo, pela mesma ordem.
+ *
+ * As diferenas de coordenadas so calculadas na largura de Coordenada; com coordenadas em
+ * 0..MAX_COORDENADA, dx e dy cabem nessa largura e dx + dy s d 0 (mdulo 2^bits) quando 
+ * mesmo 0, por isso |dx| == |dy|  testado como dx == dy || dx + dy == 0, sem valor absoluto.
+ *
+ * \author Vitor Moreira 31553
+ * \date   June 2025
+ *********************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "antenas.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define INSTRUCOES "avx2"
+#define BYTES_VETOR 32
+typedef __m256i Vetor;
+#define Carregar(p) _mm256_loadu_si256((const __m256i*)(p))
+#define Ou(a, b) _mm256_or_si256((a), (b))
+#define Mascara(v) (unsigned int)_mm256_movemask_epi8(v)
+#define Zero() _mm256_setzero_si256()
+#ifdef COORDENADAS_16_BITS
+#define Replicar(v) _mm256_set1_epi16(v)
+#define Subtrair(a, b) _mm256_sub_epi16((a), (b))
+#define Somar(a, b) _mm256_add_epi16((a), (b))
+#define Iguais(a, b) _mm256_cmpeq_epi16((a), (b))
+#else
+#define Replicar(v) _mm256_set1_epi32(v)
+#define Subtrair(a, b) _mm256_sub_epi32((a), (b))
+#define Somar(a, b) _mm256_add_epi32((a), (b))
+#define Iguais(a, b) _mm256_cmpeq_epi32((a), (b))
+#endif
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INSTRUCOES "sse2"
+#define BYTES_VETOR 16
+typedef __m128i Vetor;
+#define Carregar(p) _mm_loadu_si128((const __m128i*)(p))
+#define Ou(a, b) _mm_or_si128((a), (b))
+#define Mascara(v) (unsigned int)_mm_movemask_epi8(v)
+#define Zero() _mm_setzero_si128()
+#ifdef COORDENADAS_16_BITS
+#define Replicar(v) _mm_set1_epi16(v)
+#define Subtrair(a, b) _mm_sub_epi16((a), (b))
+#define Somar(a, b) _mm_add_epi16((a), (b))
+#define Iguais(a, b) _mm_cmpeq_epi16((a), (b))
+#else
+#define Replicar(v) _mm_set1_epi32(v)
+#define Subtrair(a, b) _mm_sub_epi32((a), (b))
+#define Somar(a, b) _mm_add_epi32((a), (b))
+#define Iguais(a, b) _mm_cmpeq_epi32((a), (b))
+#endif
+#else
+#define INSTRUCOES "escalar"
+#endif
+
+#ifdef BYTES_VETOR
+#ifdef _MSC_VER
+#include <intrin.h>
+static int PrimeiroBit(unsigned int mascara) {
+    unsigned long bit;
+    _BitScanForward(&bit, mascara);
+    return (int)bit;
+}
+#else
+#define PrimeiroBit(mascara) __builtin_ctz(mascara)
+#endif
+#endif
+
+#pragma region InstrucoesVetoriais
+/**
+ * Funo para saber que instrues AntenasAlinhadas usa nesta compilao.
+ *
+ * @param return --> "avx2", "sse2" ou "escalar".
+ */
+const char* InstrucoesVetoriais(void) {
+    return INSTRUCOES;
+}
+#pragma endregion
+
+#pragma region ConstruirVetoresAntenas
+/**
+ * Funo para copiar as antenas do grafo para vetores por campo, agrupadas por frequncia
+ * e, dentro de cada frequncia, pela ordem da lista.
+ *
+ * @param grafo --> Grafo a copiar (s  lido).
+ * @param vetores --> Estrutura a preencher (libertada com LibertarVetoresAntenas).
+ * @param contagem --> Nmero de antenas de cada frequncia, depois a prxima posio livre de cada uma.
+ * @param posicao --> Posio da antena atual na lista.
+ * @param return --> 0 se os vetores foram construdos, -1 se os argumentos forem nulos,
+ *                   -2 se falhar a alocao, -4 se uma coordenada no couber em Coordenada.
+ */
+int ConstruirVetoresAntenas(const Grafo* grafo, VetoresAntenas* vetores) {
+    if (!grafo || !vetores) return -1;
+    memset(vetores, 0, sizeof(VetoresAntenas));
+
+    int contagem[NUM_FREQUENCIAS + 1] = { 0 };
+    int n = 0;
+    for (const Antena* a = grafo->antenas; a != NULL; a = a->proxima, n++) {
+#ifdef COORDENADAS_16_BITS
+        if (a->coluna < 0 || a->coluna > MAX_COORDENADA || a->linha < 0 || a->linha > MAX_COORDENADA) return -4;
+#endif
+        contagem[(unsigned char)a->frequencia + 1]++;
+    }
+    for (int f = 0; f < NUM_FREQUENCIAS; f++) contagem[f + 1] += contagem[f];
+    memcpy(vetores->inicioFrequencia, contagem, sizeof(contagem));
+    if (n == 0) return 0;
+
+    vetores->frequencias = malloc(n);
+    vetores->colunas = malloc(n * sizeof(Coordenada));
+    vetores->linhas = malloc(n * sizeof(Coordenada));
+    vetores->posicoes = malloc(n * sizeof(int));
+    if (!vetores->frequencias || !vetores->colunas || !vetores->linhas || !vetores->posicoes) {
+        LibertarVetoresAntenas(vetores);
+        return -2;
+    }
+
+    int posicao = 0;
+    for (const Antena* a = grafo->antenas; a != NULL; a = a->proxima, posicao++) {
+        int i = contagem[(unsigned char)a->frequencia]++;
+        vetores->frequencias[i] = a->frequencia;
+        vetores->colunas[i] = (Coordenada)a->coluna;
+        vetores->linhas[i] = (Coordenada)a->linha;
+        vetores->posicoes[i] = posicao;
+    }
+    vetores->total = n;
+    return 0;
+}
+#pragma endregion
+
+#pragma region LibertarVetoresAntenas
+/**
+ * Funo para libertar os vetores construdos por ConstruirVetoresAntenas.
+ *
+ * @param vetores --> Vetores a libertar (ficam vazios).
+ * @param return --> 0, ou -1 se o apontador for nulo.
+ */
+int LibertarVetoresAntenas(VetoresAntenas* vetores) {
+    if (!vetores) return -1;
+    free(vetores->frequencias);
+    free(vetores->colunas);
+    free(vetores->linhas);
+    free(vetores->posicoes);
+    memset(vetores, 0, sizeof(VetoresAntenas));
+    return 0;
+}
+#pragma endregion
+
+#pragma region AntenasAlinhadas
+/**
+ * Funo para encontrar, num bloco de antenas, as que esto alinhadas com (coluna, linha).
+ * Compara BYTES_VETOR / sizeof(Coordenada) antenas de cada vez; cada antena alinhada acende
+ * sizeof(Coordenada) bits seguidos na mscara, que so percorridos por ordem. As antenas
+ * que sobram no fim do bloco (e todas, sem instrues vetoriais) so testadas uma a uma.
+ *
+ * @param coluna, linha --> Coordenadas da antena de referncia.
+ * @param colunas, linhas --> Coordenadas das antenas do bloco.
+ * @param total --> Nmero de antenas do bloco.
+ * @param alinhamento --> Linha ou coluna, ou tambm diagonal.
+ * @param indices --> Onde escrever as posies (no bloco) das antenas alinhadas, por ordem crescente;
+ *                    tem de ter espao para total posies.
+ * @param porVetor --> Antenas comparadas em cada instruo.
+ * @param mascara --> Bytes das antenas alinhadas no bloco atual.
+ * @param return --> Nmero de antenas alinhadas, -1 se os argumentos forem invlidos.
+ */
+int AntenasAlinhadas(Coordenada coluna, Coordenada linha, const Coordenada* colunas, const Coordenada* linhas,
+    int total, Alinhamento alinhamento, int* indices) {
+    if (total < 0 || (total > 0 && (!colunas || !linhas || !indices))) return -1;
+
+    int encontradas = 0;
+    int i = 0;
+#ifdef BYTES_VETOR
+    const int porVetor = BYTES_VETOR / (int)sizeof(Coordenada);
+    const unsigned int bitsAntena = (1u << sizeof(Coordenada)) - 1;
+    const Vetor x = Replicar(coluna), y = Replicar(linha), zero = Zero();
+    for (; i + porVetor <= total; i += porVetor) {
+        Vetor dx = Subtrair(Carregar(colunas + i), x);
+        Vetor dy = Subtrair(Carregar(linhas + i), y);
+        Vetor alinhadas = Ou(Iguais(dx, zero), Iguais(dy, zero));
+        if (alinhamento == ALINHAMENTO_DIAGONAL) {
+            alinhadas = Ou(alinhadas, Ou(Iguais(dx, dy), Iguais(Somar(dx, dy), zero)));
+        }
+
+        unsigned int mascara = Mascara(alinhadas);
+        while (mascara) {
+            int bit = PrimeiroBit(mascara);
+            indices[encontradas++] = i + bit / (int)sizeof(Coordenada);
+            mascara &= ~(bitsAntena << bit);
+        }
+    }
+#endif
+
+    for (; i < total; i++) {
+        int dx = colunas[i] - coluna;
+        int dy = linhas[i] - linha;
+        if (dx == 0 || dy == 0 || (alinhamento == ALINHAMENTO_DIAGONAL && abs(dx) == abs(dy))) {
+            indices[encontradas++] = i;
+        }
+    }
+    return encontradas;
+}
+#pragma endregion